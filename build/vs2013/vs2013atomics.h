@@ -38,6 +38,7 @@ int __mg_atomic_cas_release_ptrdiff_helper(volatile ptrdiff_t *ppdDestination, p
 	return pdOldValue == *ppdComparansAndUpdate || (*ppdComparansAndUpdate = pdOldValue, 0);
 }
 #define __MUTEGEAR_ATOMIC_CAS_RELEASE_PTRDIFF(destination, comparand_and_update, value) __mg_atomic_cas_release_ptrdiff_helper(destination, comparand_and_update, (ptrdiff_t)(value))
+#define __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF(destination, comparand_and_update, value) __mg_atomic_cas_relaxed_ptrdiff_helper(destination, comparand_and_update, (ptrdiff_t)(value)) // The interlocked operations are full barriers on x86/x64
 #define __MUTEGEAR_ATOMIC_SWAP_RELEASE_PTRDIFF(destination, value) _InterlockedExchange64_HLERelease(destination, (ptrdiff_t)(value))
 #define __MUTEGEAR_ATOMIC_FETCH_ADD_RELAXED_PTRDIFF(destination, value) _InterlockedExchangeAdd64_HLEAcquire(destination, (ptrdiff_t)(value))
 #define __MUTEGEAR_ATOMIC_FETCH_SUB_RELAXED_PTRDIFF(destination, value) _InterlockedExchangeAdd64_HLEAcquire(destination, -(ptrdiff_t)(value))
@@ -68,6 +69,7 @@ int __mg_atomic_cas_release_ptrdiff_helper(volatile ptrdiff_t *ppdDestination, p
 	return pdOldValue == *ppdComparansAndUpdate || (*ppdComparansAndUpdate = pdOldValue, 0);
 }
 #define __MUTEGEAR_ATOMIC_CAS_RELEASE_PTRDIFF(destination, comparand_and_update, value) __mg_atomic_cas_release_ptrdiff_helper(destination, comparand_and_update, (ptrdiff_t)(value))
+#define __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF(destination, comparand_and_update, value) __mg_atomic_cas_relaxed_ptrdiff_helper(destination, comparand_and_update, (ptrdiff_t)(value)) // The interlocked operations are full barriers on x86/x64
 #define __MUTEGEAR_ATOMIC_SWAP_RELEASE_PTRDIFF(destination, value) _InterlockedExchange_HLERelease(destination, (ptrdiff_t)(value))
 #define __MUTEGEAR_ATOMIC_FETCH_ADD_RELAXED_PTRDIFF(destination, value) _InterlockedExchangeAdd_HLEAcquire(destination, (ptrdiff_t)(value))
 #define __MUTEGEAR_ATOMIC_FETCH_SUB_RELAXED_PTRDIFF(destination, value) _InterlockedExchangeAdd_HLEAcquire(destination, -(ptrdiff_t)(value))
@@ -29,6 +29,9 @@
 
 
 #include <mutexgear/completion.hpp>
+#include <cstddef>
+#include <system_error>
+#include <errno.h>
 
 
 _MUTEXGEAR_BEGIN_NAMESPACE()
@@ -72,9 +75,119 @@ private:
 };
 
 
+/**
+*	\class multi_bourgeois<std::size_t tsiItemCount>
+*	\brief A \c bourgeois variant with several items over a single worker.
+*
+*	The helper allows a thread to hold up to \c tsiItemCount enclosed read locks of different objects 
+*	at a time with a single worker, by passing a distinct item for each of the locks along with the worker 
+*	(e.g. to the \c lock_shared(worker, waiter, item) overloads). An item must not be reused 
+*	until the lock it was passed for is released.
+*/
+template<std::size_t tsiItemCount>
+class multi_bourgeois
+{
+public:
+	static_assert(tsiItemCount != 0, "At least one item is required");
+
+	multi_bourgeois() = default;
+
+	multi_bourgeois(const multi_bourgeois &mbAnotherBourgeois) = delete;
+
+	~multi_bourgeois() noexcept = default;
+
+	multi_bourgeois &operator =(const multi_bourgeois &mbAnotherBourgeois) = delete;
+
+public:
+	void lock()
+	{
+		m_wWorkerInstance.lock();
+	}
+
+	void unlock() noexcept
+	{
+		m_wWorkerInstance.unlock();
+	}
+
+public:
+	static constexpr std::size_t item_count() noexcept { return tsiItemCount; }
+
+	worker &get_worker() noexcept { return m_wWorkerInstance; }
+	item &get_item(std::size_t siItemIndex) noexcept { MG_ASSERT(siItemIndex < tsiItemCount); return m_aiItemInstances[siItemIndex]; }
+
+	operator worker::pointer() noexcept { return static_cast<worker::pointer>(m_wWorkerInstance); }
+
+private:
+	worker			m_wWorkerInstance;
+	item			m_aiItemInstances[tsiItemCount];
+};
+
+
+/**
+*	\class thread_context
+*	\brief A wrapper for the calling thread's \c mutexgear_completion_threadcontext_t.
+*
+*	The context is created with its worker locked on the first \c current() call in a thread and is destroyed at the thread exit.
+*	It can be passed to the mutex overloads accepting it and converts to the \c worker and \c waiter references 
+*	to be used with the completion queues. The items are selected by index and an item must not be reused 
+*	until the lock it was passed for is released.
+*
+*	\see mutexgear_completion_threadcontext_get
+*/
+class thread_context:
+	private mutexgear_completion_threadcontext_t
+{
+public:
+	typedef mutexgear_completion_threadcontext_t *pointer;
+
+	static thread_context &instance_from_pointer(pointer pPointerValue) noexcept { return *static_cast<thread_context *>(pPointerValue); }
+
+	static thread_context &current()
+	{
+		// The context does not change until the thread exits and can be cached
+		thread_local pointer ptcCachedContext = nullptr;
+
+		pointer ptcContextPointer = ptcCachedContext;
+
+		if (ptcContextPointer == nullptr)
+		{
+			int iGetResult = mutexgear_completion_threadcontext_get(&ptcContextPointer);
+
+			if (iGetResult != EOK)
+			{
+				throw std::system_error(std::error_code(iGetResult, std::system_category()));
+			}
+
+			ptcCachedContext = ptcContextPointer;
+		}
+
+		return instance_from_pointer(ptcContextPointer);
+	}
+
+	thread_context() = delete;
+	thread_context(const thread_context &tcAnotherContext) = delete;
+
+	thread_context &operator =(const thread_context &tcAnotherContext) = delete;
+
+public:
+	static constexpr std::size_t item_count() noexcept { return MUTEXGEAR_COMPLETION_THREADCONTEXT_ITEM_COUNT; }
+
+	worker &get_worker() noexcept { return worker::instance_from_pointer(&thread_worker); }
+	waiter &get_waiter() noexcept { return waiter::instance_from_pointer(&thread_waiter); }
+	item &get_item(std::size_t siItemIndex) noexcept { MG_ASSERT(siItemIndex < item_count()); return item::instance_from_pointer(&thread_items[siItemIndex]); }
+
+	operator worker &() noexcept { return get_worker(); }
+	operator waiter &() noexcept { return get_waiter(); }
+	operator pointer() noexcept { return static_cast<pointer>(this); }
+};
+
+
 _MUTEXGEAR_END_MTX_HELPERS_NAMESPACE();
 
 
+using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::thread_context;
+
+
 _MUTEXGEAR_END_NAMESPACE();
 
 
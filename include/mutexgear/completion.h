@@ -50,6 +50,7 @@
 #include <mutexgear/wheel.h>
 #include <mutexgear/dlralist.h>
 #include <mutexgear/utility.h>
+#include <time.h>
 
 
 _MUTEXGEAR_BEGIN_EXTERN_C();
@@ -144,13 +145,33 @@ _MUTEXGEAR_API int mutexgear_completion_genattr_getprioceiling(const mutexgear_c
  *	\return EOK on success or a system error code on failure.
  */
 _MUTEXGEAR_API int mutexgear_completion_genattr_getprotocol(const mutexgear_completion_genattr_t *__attr_instance, int *__out_protocol_value);
+/**
+ *	\fn int mutexgear_completion_genattr_setadaptivespin(mutexgear_completion_genattr_t *__attr_instance, int __spin_enabled)
+ *	\brief A function to enable or disable a bounded adaptive spin phase before blocking for the queue access and waiter detach locks.
+ *
+ *	With the adaptive spin enabled, a contended acquisition of the lock spins for a bounded and adaptively tuned duration
+ *	before blocking in the kernel (an adaptive mutex type with pthreads or a critical section spin count on Windows).
+ *	The wheels of workers and waiters are not affected as they are held for long durations. The setting is disabled by default.
+ *	\param __spin_enabled a non-zero value to enable the adaptive spin or zero to disable it
+ *	\return EOK on success or a system error code on failure (ENOSYS if the target does not support the feature and a non-zero value was passed).
+ */
+_MUTEXGEAR_API int mutexgear_completion_genattr_setadaptivespin(mutexgear_completion_genattr_t *__attr_instance, int __spin_enabled);
+
+/**
+ *	\fn int mutexgear_completion_genattr_getadaptivespin(const mutexgear_completion_genattr_t *__attr_instance, int *__out_spin_enabled)
+ *	\brief A function to retrieve whether the adaptive spin phase is enabled for the queue access and waiter detach locks.
+ *	\param __out_spin_enabled pointer to a variable to receive 1 if the adaptive spin is enabled or 0 otherwise
+ *	\return EOK on success or a system error code on failure.
+ */
+_MUTEXGEAR_API int mutexgear_completion_genattr_getadaptivespin(const mutexgear_completion_genattr_t *__attr_instance, int *__out_spin_enabled);
+
 
 /**
  *	\fn int mutexgear_completion_genattr_setmutexattr(mutexgear_completion_genattr_t *__attr_instance, const _MUTEXGEAR_LOCKATTR_T *__mutexattr)
  *	\brief A function to copy attributes from a mutex attributes structure to
  *	a \c mutexgear_completion_genattr_t structure.
  *
- *	Values of "pshared", "protocol" and "prioceiling" are copied.
+ *	Values of "pshared", "protocol", "prioceiling" and the adaptive spin setting are copied.
  *
  *	Due to inability to clear previously assigned priority ceiling setting from attributes on some targets
  *	it's recommended to call this function with freshly initialized \a __attr_instance only.
@@ -337,6 +358,25 @@ _MUTEXGEAR_PURE_INLINE bool mutexgear_completion_item_getanytags(const mutexgear
 
 
 
+#if defined(_MUTEXGEAR_WITH_STATS)
+
+// The contention statistics counters of a completion queue (see mutexgear_completion_queue_getstats())
+typedef struct _mutexgear_completion_queue_statsdata
+{
+	ptrdiff_t			locks;
+	ptrdiff_t			contended_locks;
+	ptrdiff_t			unlockandwaits;
+	ptrdiff_t			total_wait_ns;
+	ptrdiff_t			max_wait_ns;
+	ptrdiff_t			total_hold_ns;
+	ptrdiff_t			max_hold_ns;
+	uint64_t			hold_start; // The access lock acquisition time (accessed by the lock owner only)
+
+} _mutexgear_completion_queue_statsdata_t;
+
+#endif // #if defined(_MUTEXGEAR_WITH_STATS)
+
+
 /**
  *	\struct mutexgear_completion_queue_t
  *	\brief A basic Completion Queue that supports waiting on its items.
@@ -351,6 +391,9 @@ typedef struct _mutexgear_completion_queue
 	_MUTEXGEAR_LOCK_T	access_lock;
 	mutexgear_dlralist_t work_list;
 	_MUTEXGEAR_LOCK_T	worker_detach_lock;
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_completion_queue_statsdata_t stats;
+#endif
 
 } mutexgear_completion_queue_t;
 
@@ -450,6 +493,31 @@ typedef enum _mutexgear_completion_ownership
  */
 typedef void (*mutexgear_completion_cancel_fn_t)(void *__cancel_context, mutexgear_completion_cancelablequeue_t *__queue, mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item);
 
+
+/**
+ *	\def MUTEXGEAR_COMPLETION_THREADCONTEXT_ITEM_COUNT
+ *	\brief The number of items available in a \c mutexgear_completion_threadcontext_t.
+ */
+#define MUTEXGEAR_COMPLETION_THREADCONTEXT_ITEM_COUNT	4U
+
+/**
+ *	\struct mutexgear_completion_threadcontext_t
+ *	\brief A per-thread set of completion helper objects maintained by the library.
+ *
+ *	The structure contains a worker locked by the owner thread, a waiter and several items 
+ *	to be used with the calls that need them (like the rwlock or the maintlock ones). The items allow holding 
+ *	several locks of different objects simultaneously. An item must not be reused until the lock it was used for is released.
+ *
+ *	\see mutexgear_completion_threadcontext_get
+ */
+typedef struct _mutexgear_completion_threadcontext
+{
+	mutexgear_completion_worker_t		thread_worker;
+	mutexgear_completion_waiter_t		thread_waiter;
+	mutexgear_completion_item_t			thread_items[MUTEXGEAR_COMPLETION_THREADCONTEXT_ITEM_COUNT];
+
+} mutexgear_completion_threadcontext_t;
+
 //////////////////////////////////////////////////////////////////////////
 // Completion Object APIs
 
@@ -519,6 +587,24 @@ _MUTEXGEAR_API int mutexgear_completion_waiter_init(mutexgear_completion_waiter_
 _MUTEXGEAR_API int mutexgear_completion_waiter_destroy(mutexgear_completion_waiter_t *__waiter_instance);
 
 
+/**
+ *	\fn int mutexgear_completion_threadcontext_get(mutexgear_completion_threadcontext_t **__out_context)
+ *	\brief Retrieves the calling thread's context, creating it on the first call
+ *
+ *	The context is allocated and initialized with the worker locked on the first call in a thread and the subsequent calls 
+ *	return the same instance. The context is destroyed by the library when the thread exits. The context objects 
+ *	must not be used with other threads or from thread specific storage destructors.
+ *
+ *	The function saves the cost of initializing and locking the helper objects in short-lived tasks
+ *	that are executed in the same threads repeatedly.
+ *
+ *	\param __out_context pointer to a variable to receive the context pointer
+ *	\return EOK on success or a system error code on failure.
+ *	\see mutexgear_completion_threadcontext_t
+ */
+_MUTEXGEAR_API int mutexgear_completion_threadcontext_get(mutexgear_completion_threadcontext_t **__out_context);
+
+
 //////////////////////////////////////////////////////////////////////////
 // Completion Queue APIs
 
@@ -663,6 +749,63 @@ _MUTEXGEAR_API int mutexgear_completion_queue_plainunlock(mutexgear_completion_q
 _MUTEXGEAR_API int mutexgear_completion_queue_unlockandwait(mutexgear_completion_queue_t *__queue_instance,
 	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance);
 
+/**
+ *	\fn int mutexgear_completion_queue_unlockandtimedwait(mutexgear_completion_queue_t *__queue_instance, mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout)
+ *	\brief Unlocks a previously locked Completion Queue and atomically waits for an Item to be finished being handled by a Worker until a deadline
+ *
+ *	The function behaves identically to \c mutexgear_completion_queue_unlockandwait with the exception that
+ *	the waiting is abandoned if the item has not been finished until the \p __abs_timeout deadline. The deadline is an 
+ *	absolute time of the \c CLOCK_MONOTONIC clock (of the clock \c std::chrono::steady_clock uses on Windows).
+ *
+ *	On expiration, the wait is withdrawn and the Worker is not going to access the \p __waiter_instance for the item.
+ *	If the Worker has already been finishing the item at the moment of expiration the function waits the completion 
+ *	through and returns success. The queue is unlocked on return in either case.
+ *
+ *	\param __item_to_be_waited Item to be waited for completion of
+ *	\param __waiter_instance An initialized instance of Completion Waiter to be used for the operation
+ *	\param __abs_timeout The deadline to wait until
+ *	\return EOK on success, ETIMEDOUT if the deadline has expired, or a system error code on failure.
+ *	\see mutexgear_completion_queue_unlockandwait
+ */
+_MUTEXGEAR_API int mutexgear_completion_queue_unlockandtimedwait(mutexgear_completion_queue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout);
+
+
+/**
+ *	\struct mutexgear_completion_queue_stats_t
+ *	\brief Contention statistics of a Completion Queue retrieved with \c mutexgear_completion_queue_getstats
+ *
+ *	The time values are in nanoseconds.
+ *
+ *	\see mutexgear_completion_queue_getstats
+ */
+typedef struct _mutexgear_completion_queue_stats
+{
+	uint64_t	locks; // Queue locks acquired
+	uint64_t	contended_locks; // Queue locks that found the access mutex owned and had to block
+	uint64_t	unlockandwaits; // Unlock-and-wait operations performed
+	uint64_t	total_wait_ns; // The total time spent blocking on the access mutex
+	uint64_t	max_wait_ns; // The longest single block on the access mutex
+	uint64_t	total_hold_ns; // The total time the queue was kept locked
+	uint64_t	max_hold_ns; // The longest single queue lock hold
+
+} mutexgear_completion_queue_stats_t;
+
+/**
+ *	\fn int mutexgear_completion_queue_getstats(mutexgear_completion_queue_t *__queue_instance, mutexgear_completion_queue_stats_t *__out_stats)
+ *	\brief Retrieves the contention statistics collected for a Completion Queue since its initialization
+ *
+ *	The statistics are only collected if the library and its clients are built with \c _MUTEXGEAR_WITH_STATS defined
+ *	(\c --enable-stats configure option). Only the explicit lock, unlock, and unlock-and-wait calls of the Basic Queue API 
+ *	are accounted; the operations locking the queue internally, the Drainable and Cancelable Queue calls, and the queues 
+ *	embedded into the other library objects are not instrumented. The counters are updated with relaxed non-interlocked memory accesses 
+ *	and the values are only approximate.
+ *
+ *	\return EOK on success or ENOSYS if the statistics collection is not enabled in the build.
+ *	\see mutexgear_completion_queue_stats_t
+ */
+_MUTEXGEAR_API int mutexgear_completion_queue_getstats(mutexgear_completion_queue_t *__queue_instance, mutexgear_completion_queue_stats_t *__out_stats);
+
 /**
  *	\fn bool mutexgear_completion_queue_lodisempty(const mutexgear_completion_queue_t *__queue_instance)
  *	\brief Checks whether a Completion Queue is empty
@@ -1092,6 +1235,16 @@ _MUTEXGEAR_API int mutexgear_completion_drainablequeue_plainunlock(mutexgear_com
 _MUTEXGEAR_API int mutexgear_completion_drainablequeue_unlockandwait(mutexgear_completion_drainablequeue_t *__queue_instance,
 	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance);
 
+/**
+ *	\fn int mutexgear_completion_drainablequeue_unlockandtimedwait(mutexgear_completion_drainablequeue_t *__queue_instance, mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout)
+ *	\brief An inherited method for \c mutexgear_completion_queue_unlockandtimedwait
+ *
+ *	\return EOK on success, ETIMEDOUT if the deadline has expired, or a system error code on failure.
+ *	\see mutexgear_completion_queue_unlockandtimedwait
+ */
+_MUTEXGEAR_API int mutexgear_completion_drainablequeue_unlockandtimedwait(mutexgear_completion_drainablequeue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout);
+
 
 /**
  *	\fn bool mutexgear_completion_drainablequeue_lodisempty(const mutexgear_completion_drainablequeue_t *__queue_instance)
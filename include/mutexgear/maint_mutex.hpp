@@ -49,6 +49,8 @@ using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::worker;
 using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::waiter;
 using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::item;
 using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::bourgeois;
+using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::multi_bourgeois;
+using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::thread_context;
 
 
 class shared_lock_token
@@ -86,6 +88,9 @@ public:
 	typedef _MUTEXGEAR_MNTMTX_HELPERS_NAMESPACE::worker helper_worker_type;
 	typedef _MUTEXGEAR_MNTMTX_HELPERS_NAMESPACE::waiter helper_waiter_type;
 	typedef _MUTEXGEAR_MNTMTX_HELPERS_NAMESPACE::item helper_item_type;
+	template<std::size_t tsiItemCount>
+	using helper_multi_bourgeois_type = _MUTEXGEAR_MNTMTX_HELPERS_NAMESPACE::multi_bourgeois<tsiItemCount>;
+	typedef _MUTEXGEAR_MNTMTX_HELPERS_NAMESPACE::thread_context helper_thread_context_type;
 	typedef _MUTEXGEAR_MNTMTX_HELPERS_NAMESPACE::shared_lock_token lock_token_type;
 
 	maint_mutex()
@@ -170,6 +175,22 @@ public: // Less convenient overloads
 		MG_CHECK(iMaintLockRdUnlockResult, (iMaintLockRdUnlockResult = mutexgear_maintlock_rdunlock(&m_mlMaintLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance), static_cast<lock_token_type::const_pointer>(ltLockToken))) == EOK);
 	}
 
+public: // Thread context overloads (see thread_context::current()). The item index selects the context item to hold a shared lock with.
+	bool try_lock_shared(helper_thread_context_type &tcRefThreadContext, lock_token_type &ltOutLockToken, std::size_t siItemIndex=0)
+	{
+		return try_lock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_item(siItemIndex), ltOutLockToken);
+	}
+
+	void unlock_shared(helper_thread_context_type &tcRefThreadContext, const lock_token_type &ltLockToken, std::size_t siItemIndex=0) noexcept
+	{
+		unlock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_item(siItemIndex), ltLockToken);
+	}
+
+	void wait_shared_unlock(helper_thread_context_type &tcRefThreadContext)
+	{
+		wait_shared_unlock(tcRefThreadContext.get_waiter());
+	}
+
 public:
 	native_handle_type native_handle() const noexcept { return static_cast<native_handle_type>(const_cast<mutexgear_maintlock_t *>(&m_mlMaintLockInstance)); }
 
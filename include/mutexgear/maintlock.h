@@ -156,12 +156,35 @@ _MUTEXGEAR_API int mutexgear_maintlockattr_getprioceiling(const mutexgear_maintl
 _MUTEXGEAR_API int mutexgear_maintlockattr_getprotocol(const mutexgear_maintlockattr_t *__attr_instance, int *__out_protocol_value);
 
 
+/**
+*	\fn int mutexgear_maintlockattr_setadaptivespin(mutexgear_maintlockattr_t *__attr_instance, int __spin_enabled)
+*	\brief A function to enable or disable a bounded adaptive spin phase before blocking for the internal queue access locks.
+*
+*	With the adaptive spin enabled, a contended acquisition of a short held internal lock spins for a bounded 
+*	and adaptively tuned duration before blocking in the kernel (see \c mutexgear_rwlockattr_setadaptivespin for details).
+*	The setting is disabled by default.
+*	\param __spin_enabled a non-zero value to enable the adaptive spin or zero to disable it
+*	\return EOK on success or a system error code on failure (ENOSYS if the target does not support the feature and a non-zero value was passed).
+*	\see mutexgear_maintlockattr_getadaptivespin
+*/
+_MUTEXGEAR_API int mutexgear_maintlockattr_setadaptivespin(mutexgear_maintlockattr_t *__attr_instance, int __spin_enabled);
+
+/**
+*	\fn int mutexgear_maintlockattr_getadaptivespin(const mutexgear_maintlockattr_t *__attr_instance, int *__out_spin_enabled)
+*	\brief A function to retrieve whether the adaptive spin phase is enabled for the internal queue access locks.
+*	\param __out_spin_enabled pointer to a variable to receive 1 if the adaptive spin is enabled or 0 otherwise
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_maintlockattr_setadaptivespin
+*/
+_MUTEXGEAR_API int mutexgear_maintlockattr_getadaptivespin(const mutexgear_maintlockattr_t *__attr_instance, int *__out_spin_enabled);
+
+
 /**
 *	\fn int mutexgear_maintlockattr_setmutexattr(mutexgear_maintlockattr_t *__attr_instance, const _MUTEXGEAR_LOCKATTR_T *__mutexattr_instance)
 *	\brief A function to copy attributes from a mutex attributes structure to
 *	the \c mutexgear_maintlockattr_t  structure.
 *
-*	Values of "pshared", "protocol" and "prioceiling" are copied.
+*	Values of "pshared", "protocol", "prioceiling" and the adaptive spin setting are copied.
 *
 *	Due to inability to clear previously assigned priority ceiling setting from attributes on some targets
 *	it's recommended to call this function with freshly initialized \a __attr_instance only.
@@ -172,6 +195,26 @@ _MUTEXGEAR_API int mutexgear_maintlockattr_setmutexattr(mutexgear_maintlockattr_
 
 //////////////////////////////////////////////////////////////////////////
 
+#if defined(_MUTEXGEAR_WITH_STATS)
+
+// The contention statistics counters of a maintlock object (see mutexgear_maintlock_getstats())
+typedef struct _mutexgear_maintlock_statsdata
+{
+	ptrdiff_t                   reads;
+	ptrdiff_t                   busy_reads;
+	ptrdiff_t                   maintenances;
+	ptrdiff_t                   waits;
+	ptrdiff_t                   unlockandwaits;
+	ptrdiff_t                   total_wait_ns;
+	ptrdiff_t                   max_wait_ns;
+	ptrdiff_t                   total_hold_ns;
+	ptrdiff_t                   max_hold_ns;
+	uint64_t                    hold_start; // The maintenance mode set time (accessed by the maintenance owner only)
+
+} _mutexgear_maintlock_statsdata_t;
+
+#endif // #if defined(_MUTEXGEAR_WITH_STATS)
+
 /**
 *	\struct mutexgear_maintlock_t
 *	\brief An opaque structure to represent a maintenance lock (\c maintlock) object
@@ -188,6 +231,9 @@ typedef struct _mutexgear_maintlock
 
 	mutexgear_completion_drainablequeue_t acquired_reads;
 	mutexgear_completion_queue_t awaited_reads;
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_maintlock_statsdata_t stats;
+#endif
 
 } mutexgear_maintlock_t;
 
@@ -271,7 +317,9 @@ _MUTEXGEAR_API int mutexgear_maintlock_test_maintenance(const mutexgear_maintloc
 *	The function requires initialized \p __worker_instance and \p __item_instance objects that must be allocated 
 *	per calling thread (e.g. on stack). The \p __worker_instance and \p __item_instance must remain valid and 
 *	not reused for other purposes until the read lock is released with a call to \c mutexgear_maintlock_rdunlock 
-*	(in particular, the same parameters must not be used for enclosed read locks of other objects).
+*	(in particular, the same \p __item_instance must not be used for enclosed read locks of other objects).
+*	The \p __worker_instance may be shared by enclosed read locks of other objects provided that each of them 
+*	is given a distinct item (e.g. with \c mg::mtx_helpers::multi_bourgeois in C++).
 *	The \p __worker_instance must be locked with a \c mutexgear_completion_worker_lock call after initialization.
 *	It is recommended that the objects are allocated with calling thread for its lifetime.
 * 
@@ -334,6 +382,59 @@ _MUTEXGEAR_API int mutexgear_maintlock_rdunlock(mutexgear_maintlock_t *__maintlo
 _MUTEXGEAR_API int mutexgear_maintlock_wait_rdunlock(mutexgear_maintlock_t *__maintlock_instance,
 	mutexgear_completion_waiter_t *__waiter_instance);
 
+/**
+*	\fn int mutexgear_maintlock_timedwait_rdunlock(mutexgear_maintlock_t *__maintlock_instance, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout)
+*	\brief Waits until all read locks acquired before this call are released or until a deadline.
+* 
+*	The function behaves identically to \c mutexgear_maintlock_wait_rdunlock with the exception that it gives up 
+*	if the read locks have not been released until the \p __abs_timeout deadline. The deadline is an absolute time 
+*	of the \c CLOCK_MONOTONIC clock (of the clock \c std::chrono::steady_clock uses on Windows).
+*
+*	On expiration, the read locks that have not been released yet remain registered as awaited 
+*	and they are going to be waited together with the newer ones by the next wait call.
+*
+*	\return EOK on success, ETIMEDOUT if the deadline has expired, or a system error code on failure.
+*	\see mutexgear_maintlock_wait_rdunlock
+*/
+_MUTEXGEAR_API int mutexgear_maintlock_timedwait_rdunlock(mutexgear_maintlock_t *__maintlock_instance,
+	mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout);
+
+
+/**
+*	\struct mutexgear_maintlock_stats_t
+*	\brief Contention statistics of a \c maintlock object retrieved with \c mutexgear_maintlock_getstats
+*
+*	The time values are in nanoseconds.
+*
+*	\see mutexgear_maintlock_getstats
+*/
+typedef struct _mutexgear_maintlock_stats
+{
+	uint64_t    reads; // Read locks acquired
+	uint64_t    busy_reads; // Read lock attempts rejected because of the maintenance mode
+	uint64_t    maintenances; // Successful switches into the maintenance mode
+	uint64_t    waits; // Read unlock waits that found read locks to be waited for
+	uint64_t    unlockandwaits; // Unlock-and-wait operations performed on the awaited reads queue
+	uint64_t    total_wait_ns; // The total time spent waiting for the read unlocks
+	uint64_t    max_wait_ns; // The longest single wait for the read unlocks
+	uint64_t    total_hold_ns; // The total time the object stayed in the maintenance mode
+	uint64_t    max_hold_ns; // The longest single maintenance mode period
+
+} mutexgear_maintlock_stats_t;
+
+/**
+*	\fn int mutexgear_maintlock_getstats(mutexgear_maintlock_t *__maintlock_instance, mutexgear_maintlock_stats_t *__out_stats)
+*	\brief Retrieves the contention statistics collected for the object since its initialization
+*
+*	The statistics are only collected if the library and its clients are built with \c _MUTEXGEAR_WITH_STATS defined
+*	(\c --enable-stats configure option). The counters are updated with relaxed non-interlocked memory accesses 
+*	and the values are only approximate (see \c mutexgear_rwlock_getstats for details).
+*
+*	\return EOK on success or ENOSYS if the statistics collection is not enabled in the build.
+*	\see mutexgear_maintlock_stats_t
+*/
+_MUTEXGEAR_API int mutexgear_maintlock_getstats(mutexgear_maintlock_t *__maintlock_instance, mutexgear_maintlock_stats_t *__out_stats);
+
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -103,7 +103,7 @@ typedef struct _mutexgear_rwlockattr
 *	system structure defaults. Typically these are:
 *	\li MUTEXGEAR_PROCESS_PRIVATE for "pshared";
 *	\li MUTEXGEAR_PRIO_INHERIT for "protocol".
-*	Also, 0 is used for "writechannels".
+*	Also, 0 is used for "writechannels", the "fastpath" is enabled and the "upgradable" mode is disabled.
 *	\return EOK on success or a system error code on failure.
 */
 _MUTEXGEAR_API int mutexgear_rwlockattr_init(mutexgear_rwlockattr_t *__attr_instance);
@@ -173,12 +173,46 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getprioceiling(const mutexgear_rwlockatt
 _MUTEXGEAR_API int mutexgear_rwlockattr_getprotocol(const mutexgear_rwlockattr_t *__attr_instance, int *__out_protocol_value);
 
 
+/**
+*	\fn int mutexgear_rwlockattr_setadaptivespin(mutexgear_rwlockattr_t *__attr_instance, int __spin_enabled)
+*	\brief A function to enable or disable a bounded adaptive spin phase before blocking for the internal locks.
+*
+*	The internal locks of the object (\c acquired_reads and the other queue access locks, the write channel locks) 
+*	are typically held for very short durations only. With the adaptive spin enabled, a contended acquisition of such a lock spins 
+*	for a while waiting for the lock to be released before falling back to blocking in the kernel. The spin is bounded and 
+*	the bound adapts to the durations the recent acquisitions needed (or the spinning is cut short if the lock owner is not running) 
+*	as implemented by the target: an adaptive mutex type (\c PTHREAD_MUTEX_ADAPTIVE_NP) is used with pthreads 
+*	and a critical section spin count is assigned on Windows.
+*
+*	The spin can reduce the number of system calls and context switches with many threads accessing the object concurrently
+*	on multiple execution cores. It is of no use on a single core system and can be harmful on oversubscribed systems.
+*	The setting is disabled by default.
+*
+*	The setting is not copied into the locks used for actual lock waits as those are expected to be held for long durations.
+*	\param __spin_enabled a non-zero value to enable the adaptive spin or zero to disable it
+*	\return EOK on success or a system error code on failure (ENOSYS if the target does not support the feature and a non-zero value was passed).
+*	\see mutexgear_rwlockattr_getadaptivespin
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_setadaptivespin(mutexgear_rwlockattr_t *__attr_instance, int __spin_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_getadaptivespin(const mutexgear_rwlockattr_t *__attr_instance, int *__out_spin_enabled)
+*	\brief A function to retrieve whether the adaptive spin phase is enabled for the internal locks.
+*
+*	See \c mutexgear_rwlockattr_setadaptivespin for details.
+*	\param __out_spin_enabled pointer to a variable to receive 1 if the adaptive spin is enabled or 0 otherwise
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_setadaptivespin
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_getadaptivespin(const mutexgear_rwlockattr_t *__attr_instance, int *__out_spin_enabled);
+
+
 /**
 *	\fn int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__attr_instance, const _MUTEXGEAR_LOCKATTR_T *__mutexattr_instance)
 *	\brief A function to copy attributes from a mutex attributes structure to
 *	the \c mutexgear_rwlockattr_t  structure.
 *
-*	Values of "pshared", "protocol" and "prioceiling" are copied.
+*	Values of "pshared", "protocol", "prioceiling" and the adaptive spin setting are copied.
 *
 *	Due to inability to clear previously assigned priority ceiling setting from attributes on some targets
 *	it's recommended to call this function with freshly initialized \a __attr_instance only.
@@ -198,9 +232,15 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__a
 *	It is possible to control write wait thread's lock channel selection by allocating the related \c mutexgear_completion_waiter_t
 *	instance with a proper alignment (see _MUTEXGEAR_RWLOCK_READERPUSHSELECTOR_FACTOR use).
 *
-*	The parameter is automatically adjusted to the nearest acceptable value. Pass 0 for the system default (currently, a single channel).
+*	The parameter is automatically adjusted to the nearest acceptable value, that is, rounded up to a power of two 
+*	not exceeding \c _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT. Pass 0 for the system default (currently, a single channel).
 *	To determine the default value at runtime assign 0 and read the value back with \c mutexgear_rwlockattr_getwritechannels.
 *
+*	Up to \c _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT channel locks are stored within the \c rwlock object itself. 
+*	For bigger channel counts the lock storage is allocated from the heap with \c mutexgear_rwlock_init and freed with \c mutexgear_rwlock_destroy.
+*	Since the heap memory is not accessible from other processes, such channel counts are not allowed for process shared objects
+*	(\c mutexgear_rwlock_init fails with \c EINVAL).
+*
 *	Multiple channels can have positive effect when there are frequent cases of a few competing write lock requests at a time 
 *	and at the same time there is even bigger number of read requests having the object acquired shared.
 *	
@@ -219,11 +259,186 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_setwritechannels(mutexgear_rwlockattr_t
 */
 _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t *__attr_instance, unsigned int *__out_channel_count);
 
+/**
+*	\fn int mutexgear_rwlockattr_setfastpath(mutexgear_rwlockattr_t *__attr_instance, int __fastpath_enabled)
+*	\brief A function to enable or disable the single atomic operation fast path for uncontended locks.
+*
+*	With the fast path enabled (the default), an uncontended write lock or a single uncontended read lock is acquired 
+*	and released with a single atomic compare-and-swap on an internal state word and without any mutex operations.
+*	The queue based implementation is only entered when another thread arrives while the object is acquired
+*	(or while other threads are already within the queue based implementation). A read lock acquired with the fast path 
+*	is transferred into \c acquired_reads by the contending thread; a contender for a write lock acquired with 
+*	the fast path waits for its release on the owner's \c mutexgear_completion_worker_t the same way as for items in queues.
+*
+*	Disabling the fast path removes the extra atomic operations executed by the contended locks and makes
+*	all the operations to be performed with the queues only.
+*
+*	The fast path requires that the \c __item_instance parameter of \c mutexgear_rwlock_wrlock and \c mutexgear_rwlock_wrlock_cwp 
+*	is not NULL for process shared objects.
+*
+*	The setting only affects \c mutexgear_rwlock_t objects. The \c mutexgear_trdl_rwlock_t objects ignore it.
+*	\param __fastpath_enabled a non-zero value to enable the fast path or zero to disable it
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_getfastpath
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_setfastpath(mutexgear_rwlockattr_t *__attr_instance, int __fastpath_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_getfastpath(const mutexgear_rwlockattr_t *__attr_instance, int *__out_fastpath_enabled)
+*	\brief A function to retrieve whether the single atomic operation fast path is enabled for uncontended locks.
+*
+*	See \c mutexgear_rwlockattr_setfastpath for details.
+*	\param __out_fastpath_enabled pointer to a variable to receive 1 if the fast path is enabled or 0 otherwise
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_setfastpath
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_getfastpath(const mutexgear_rwlockattr_t *__attr_instance, int *__out_fastpath_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_setupgradable(mutexgear_rwlockattr_t *__attr_instance, int __upgradable_enabled)
+*	\brief A function to enable or disable the upgradable read lock mode.
+*
+*	With the mode enabled, the object supports an upgradable read lock (\c mutexgear_rwlock_uprdlock) that coexists with 
+*	plain read locks but excludes other upgradable read locks and write locks, and that can later be promoted into a write lock 
+*	with \c mutexgear_rwlock_rdupgrade without letting any other writer ahead.
+*
+*	The mode is disabled by default as it requires the write lock attempts that are not satisfied immediately to be serialized 
+*	on an extra internal mutex (\c upgrade_lock) before they start waiting for readers. That makes the multiple write channel 
+*	waiting set with \c mutexgear_rwlockattr_setwritechannels to be of no effect. Uncontended write locks acquired with the fast path 
+*	are not affected.
+*
+*	\param __upgradable_enabled a non-zero value to enable the mode or zero to disable it
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_getupgradable
+*	\see mutexgear_rwlock_uprdlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_setupgradable(mutexgear_rwlockattr_t *__attr_instance, int __upgradable_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_getupgradable(const mutexgear_rwlockattr_t *__attr_instance, int *__out_upgradable_enabled)
+*	\brief A function to retrieve whether the upgradable read lock mode is enabled.
+*
+*	See \c mutexgear_rwlockattr_setupgradable for details.
+*	\param __out_upgradable_enabled pointer to a variable to receive 1 if the mode is enabled or 0 otherwise
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_setupgradable
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_getupgradable(const mutexgear_rwlockattr_t *__attr_instance, int *__out_upgradable_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_sethandoff(mutexgear_rwlockattr_t *__attr_instance, int __handoff_enabled)
+*	\brief A function to enable or disable the write lock handoff mode.
+*
+*	By default, a writer removes its item from \c waiting_writes as soon as it acquires the object. When the object 
+*	is released, the readers and writers blocked on the mutex of \c acquired_reads, as well as the newly arriving threads, 
+*	all compete for the access. Under a bursty write load this results in convoys with threads repeatedly awakening and blocking again.
+*
+*	With the mode enabled, the writers are served in phases. A writer keeps its item in \c waiting_writes until \c mutexgear_rwlock_wrunlock
+*	(or \c mutexgear_rwlock_wrdowngrade), and a writer that finds the object owned by another writer queues itself into \c waiting_writes
+*	rather than blocking on the mutex of \c acquired_reads. This way, the readers stay queued in \c waiting_reads while there are writers 
+*	queued, and the object passes from a writer to the next queued writer without readers intervening. When the last queued writer 
+*	releases the object, the readers queued in the meantime are admitted together as a batch.
+*
+*	The mode only applies to write lock requests that pass a non-NULL \c __item_instance and have not disabled the writer priority 
+*	(see \c mutexgear_rwlock_wrlock_cwp). The \c __worker_instance and \c __item_instance of such requests remain engaged 
+*	until the write lock is released and must not be used for other operations in the meantime. The mode favors writers 
+*	and may delay readers substantially with a continuous write load. The mode is disabled by default.
+*
+*	\param __handoff_enabled a non-zero value to enable the mode or zero to disable it
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_gethandoff
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_sethandoff(mutexgear_rwlockattr_t *__attr_instance, int __handoff_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_gethandoff(const mutexgear_rwlockattr_t *__attr_instance, int *__out_handoff_enabled)
+*	\brief A function to retrieve whether the write lock handoff mode is enabled.
+*
+*	See \c mutexgear_rwlockattr_sethandoff for details.
+*	\param __out_handoff_enabled pointer to a variable to receive 1 if the mode is enabled or 0 otherwise
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_sethandoff
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_gethandoff(const mutexgear_rwlockattr_t *__attr_instance, int *__out_handoff_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_setreaderbias(mutexgear_rwlockattr_t *__attr_instance, int __readerbias_enabled)
+*	\brief A function to enable or disable the reader bias mode.
+*
+*	With the mode enabled, while the object is "biased", \c mutexgear_rwlock_rdlock and \c mutexgear_rwlock_timedrdlock
+*	publish the reader in a slot of a global table selected by hashing the object and the item addresses, and return
+*	at once without accessing the object's shared state. \c mutexgear_rwlock_rdunlock then just clears the slot.
+*	This way, the readers of a read-dominated object do not write into common cache lines and scale with the processor count.
+*
+*	A writer revokes the bias after it acquires the object and then waits (with yields) until all the readers published
+*	in the table for the object leave. The time spent in the revocation, multiplied by a constant, is used to inhibit the bias,
+*	after which the first reader acquiring the object in the regular way re-enables it. Readers that find the bias revoked
+*	or their slot occupied by a hash collision proceed in the regular way.
+*
+*	Since a writer has to wait for the published readers with busy-waiting, the mode is only suitable for objects with short read
+*	sections and rare writes. The readers locked with \c mutexgear_rwlock_uprdlock are never published. The mode cannot be combined
+*	with the process shared mode (\c mutexgear_rwlock_init fails with \c EINVAL) and has no effect for \c mutexgear_trdl_rwlock_t.
+*	The mode is disabled by default.
+*
+*	\param __readerbias_enabled a non-zero value to enable the mode or zero to disable it
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_getreaderbias
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_setreaderbias(mutexgear_rwlockattr_t *__attr_instance, int __readerbias_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_getreaderbias(const mutexgear_rwlockattr_t *__attr_instance, int *__out_readerbias_enabled)
+*	\brief A function to retrieve whether the reader bias mode is enabled.
+*
+*	See \c mutexgear_rwlockattr_setreaderbias for details.
+*	\param __out_readerbias_enabled pointer to a variable to receive 1 if the mode is enabled or 0 otherwise
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_setreaderbias
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_getreaderbias(const mutexgear_rwlockattr_t *__attr_instance, int *__out_readerbias_enabled);
+
+/**
+*	\fn int mutexgear_rwlockattr_setreadstripes(mutexgear_rwlockattr_t *__attr_instance, unsigned int __stripe_count)
+*	\brief A function to assign number of stripes the lock-free read acquisition queue (\c express_reads) is to be split into.
+*
+*	By default, all the readers arriving while the object is acquired for reading link themselves into a single list head 
+*	with an atomic compare-and-swap. With many reader threads running on different execution cores, the cache line of the head 
+*	keeps bouncing among the cores. The function allows splitting the list into several heads, each kept in a separate cache line, 
+*	so that a reader selects the head by the execution core it runs on (by the \c __worker_instance address, if the core number 
+*	cannot be queried on the target). The threads that move the queued readers into \c acquired_reads collect all the stripes at once.
+*
+*	The parameter is automatically adjusted to the nearest acceptable value, that is, rounded up to a power of two 
+*	not exceeding \c _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT. Pass 0 for the system default (currently, a single stripe).
+*
+*	A single stripe is stored within the \c rwlock object itself. For bigger stripe counts the stripe storage 
+*	(\c _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_SIZE bytes per stripe) is allocated from the heap with \c mutexgear_rwlock_init 
+*	and freed with \c mutexgear_rwlock_destroy. Since the heap memory is not accessible from other processes, 
+*	such stripe counts are not allowed for process shared objects (\c mutexgear_rwlock_init fails with \c EINVAL).
+*
+*	Multiple stripes can have positive effect when there are a lot of concurrent read lock requests 
+*	executed on different execution cores, especially on multi-socket systems.
+*
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_getreadstripes
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_setreadstripes(mutexgear_rwlockattr_t *__attr_instance, unsigned int __stripe_count);
+
+/**
+*	\fn int mutexgear_rwlockattr_getreadstripes(const mutexgear_rwlockattr_t *__attr_instance, unsigned int *__out_stripe_count)
+*	\brief A function to retrieve number of stripes the lock-free read acquisition queue is to be split into.
+*
+*	See \c mutexgear_rwlockattr_setreadstripes for details.
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlockattr_setreadstripes
+*/
+_MUTEXGEAR_API int mutexgear_rwlockattr_getreadstripes(const mutexgear_rwlockattr_t *__attr_instance, unsigned int *__out_stripe_count);
+
 
 
 //////////////////////////////////////////////////////////////////////////
 
-#define _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT		4U
+#define _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT	4U
+#define _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT		64U
 
 #ifndef _MUTEXGEAR_RWLOCK_READERPUSHSELECTOR_FACTOR
 #ifdef MEMORY_ALLOCATION_ALIGNMENT
@@ -233,15 +448,52 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t
 #endif
 #endif // #ifndef _MUTEXGEAR_RWLOCK_READERPUSHSELECTOR_FACTOR
 
+#define _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT	64U
+
+#ifndef _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_SIZE
+#define _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_SIZE		64U // The cache line size
+#endif // #ifndef _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_SIZE
+
+typedef union _mutexgear_rwlock_expressreadstripe
+{
+	mutexgear_dlraitem_prev_t    express_reads;
+	char                         _padding[_MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_SIZE]; // To have every stripe in its own cache line
+
+} _mutexgear_rwlock_expressreadstripe_t;
+
+
+#if defined(_MUTEXGEAR_WITH_STATS)
+
+// The contention statistics counters of a rwlock object (see mutexgear_rwlock_getstats())
+typedef struct _mutexgear_rwlock_statsdata
+{
+	ptrdiff_t                    fastpath_reads;
+	ptrdiff_t                    express_reads;
+	ptrdiff_t                    slow_reads;
+	ptrdiff_t                    writes;
+	ptrdiff_t                    writer_priority_claims;
+	ptrdiff_t                    reader_push_lock_waits;
+	ptrdiff_t                    unlockandwaits;
+	ptrdiff_t                    total_wait_ns;
+	ptrdiff_t                    max_wait_ns;
+	ptrdiff_t                    total_hold_ns;
+	ptrdiff_t                    max_hold_ns;
+	uint64_t                     hold_start; // The write lock acquisition time (accessed by the write lock owner only)
+
+} _mutexgear_rwlock_statsdata_t;
+
+#endif // #if defined(_MUTEXGEAR_WITH_STATS)
+
 /**
 *	\struct mutexgear_rwlock_t
-*	\brief An opaque structure to represent a read-write lock (\c rwlock) object without tryrdlock operation support
+*	\brief An opaque structure to represent a read-write lock (\c rwlock) object with a lightweight tryrdlock operation
 *
-*	This is a basic \c rwlock class with wrlock, wrunlock, rdlock, rdunlock, and with trywrlock 
-*	but without tryrdlock operation support. For additional tryrdlock, use 
-*	\c mutexgear_trdl_rwlock_t object instead.
+*	This is a basic \c rwlock class with wrlock, wrunlock, rdlock, rdunlock, trywrlock, and with a lightweight
+*	tryrdlock that does not use the express path and may fail speculatively. For a tryrdlock that joins the express path
+*	readers, use \c mutexgear_trdl_rwlock_t object instead.
 *
-*	The operation pseudo-codes are provided below.
+*	The operation pseudo-codes are provided below. Unless the fast path is disabled with \c mutexgear_rwlockattr_setfastpath, 
+*	each operation is bracketed with the fast path steps listed at the end. 
 *
 *	wrlock(__worker_instance, __waiter_instance, __item_instance)
 *
@@ -259,6 +511,12 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t
 *
 *	(exiting having the mutex of \c acquired_reads acquired)
 *
+*	(in the handoff mode, step 1 try-acquires the mutex and goes to step 4 if it is busy; step 9 is deferred till wrunlock or wrdowngrade)
+*
+*	(with a raised writer class, step 1 try-acquires the mutex and goes to step 4 if it is busy; step 4 inserts the item before the first item of a lower class
+*	and increments \c prioritywp_writers; after step 9, if \c prioritywp_writers is not zero and the head of \c waiting_writes has a higher class 
+*	than the writer's own one, the writer releases the mutex of \c acquired_reads, yields the processor and starts over from step 1)
+*
 *
 *	trywrlock()
 *
@@ -277,7 +535,8 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t
 *
 *	----------
 *
-*	\li 1. release the mutex of \c acquired_reads.
+*	\li 1. release the mutex of \c acquired_reads;
+*	\li 2. (in the handoff mode) remove the item kept by wrlock from \c waiting_writes awakening a reader waiting there, if any.
 *
 *
 *	rdlock(__worker_instance, __waiter_instance, __item_instance)
@@ -285,7 +544,7 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t
 *	----------
 *
 *	\li 1. Check if \c waiting_writes is empty; if not then goto 9;
-*	\li 2. Make 8 attempts to link \c __item_instance with its "previous" pointer into \c express_reads using CAS atomic operations; if all the attempts fail then goto 6;
+*	\li 2. Make 8 attempts to link \c __item_instance with its "previous" pointer into the \c express_reads stripe selected by the current execution core using CAS atomic operations; if all the attempts fail then goto 6;
 *	\li 3. Check whether \c acquired_reads contains at least one item; if yes then exit with success status (a lock-free acquisition)
 *	\li 4. acquire the mutex of \c acquired_reads;
 *	\li 5. goto 21
@@ -304,12 +563,25 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t
 *	\li 18. remove \c __item_instance from its current queue awakening the next queued reader there, if any;
 *	\li 19. goto 6;
 *	\li 20. add \c __item_instance with \c __worker_instance into \c acquired_reads;
-*	\li 21. atomically extract the single-linked list from the \c express_reads, link the list's element "next" pointers and splice it whole into the \c acquired_reads; 
+*	\li 21. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers and splice it whole into the \c acquired_reads; 
 *	\li 22. release the mutex of \c acquired_reads.
 *
 *	(exiting with having the \c __item_instance with the \c __worker_instance added either into \c express_reads or into \c acquired_reads)
 *
 *
+*	tryrdlock(__worker_instance, __item_instance)
+*
+*	----------
+*
+*	\li 1. check whether \c waiting_writes is empty; if not then exit with EBUSY;
+*	\li 2. try-acquire the mutex of \c acquired_reads, exit with EBUSY if the mutex is busy;
+*	\li 3. if \c waiting_writes is not empty then release the mutex of \c acquired_reads and exit with EBUSY;
+*	\li 4. add \c __item_instance with \c __worker_instance into \c acquired_reads;
+*	\li 5. perform steps 21 and 22 of rdlock.
+*
+*	(exiting with having the \c __item_instance with the \c __worker_instance added into \c acquired_reads in case of success)
+*
+*
 *	rdunlock(__worker_instance, __item_instance)
 *
 *	----------
@@ -317,31 +589,111 @@ _MUTEXGEAR_API int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t
 *	\li 1. acquire the mutex of \c acquired_reads;
 *	\li 2. check whether \c __item_instance is already linked into \c acquired_reads; if not (i.e. the item is still in \c express_reads) then goto 7
 *	\li 3. remove \c __item_instance from \c acquired_reads;
-*	\li 4. atomically extract the single-linked list from the \c express_reads, link the list's element "next" pointers and splice it whole into the \c acquired_reads;
+*	\li 4. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers and splice it whole into the \c acquired_reads;
 *	\li 5. release the mutex of \c acquired_reads;
 *	\li 6. awaken a writer blocked on \c __worker_instance in the \c __item_instance, if any, and exit.
-*	\li 7. atomically extract the single-linked list from the \c express_reads, link the list's element "next" pointers removing the \c __item_instance from the chain, then splice the remainder into the \c acquired_reads;
+*	\li 7. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers removing the \c __item_instance from the chain, then splice the remainder into the \c acquired_reads;
 *	\li 8. release the mutex of \c acquired_reads;
 *
 *
+*	wrdowngrade(__worker_instance, __item_instance)
+*
+*	----------
+*
+*	(entering with the mutex of \c acquired_reads acquired by the preceding wrlock; in the handoff mode, the item kept by wrlock is removed from \c waiting_writes first)
+*
+*	\li 1. add \c __item_instance with \c __worker_instance into \c acquired_reads;
+*	\li 2. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers and splice it whole into the \c acquired_reads;
+*	\li 3. release the mutex of \c acquired_reads.
+*
+*	(exiting with having the \c __item_instance with the \c __worker_instance added into \c acquired_reads)
+*
+*
+*	uprdlock(__worker_instance, __waiter_instance, __item_instance)
+*
+*	----------
+*
+*	\li 1. acquire \c upgrade_lock;
+*	\li 2. perform rdlock(__worker_instance, __waiter_instance, __item_instance).
+*
+*	(with the upgradable mode enabled, wrlock acquires \c upgrade_lock before its step 1 and releases it on exit; trywrlock try-acquires it and exits with EBUSY if the mutex is busy)
+*
+*
+*	uprdunlock(__worker_instance, __item_instance)
+*
+*	----------
+*
+*	\li 1. perform rdunlock(__worker_instance, __item_instance);
+*	\li 2. release \c upgrade_lock.
+*
+*
+*	rdupgrade(__worker_instance, __waiter_instance, __item_instance)
+*
+*	----------
+*
+*	\li 1. perform rdunlock(__worker_instance, __item_instance) retaining the thread's count within the queue based implementation;
+*	\li 2. perform wrlock(__worker_instance, __waiter_instance, __item_instance) starting from its step 1 (with \c upgrade_lock being already owned);
+*	\li 3. release \c upgrade_lock.
+*
+*	(exiting having the mutex of \c acquired_reads acquired)
+*
+*
+*	fast path
+*
+*	----------
+*
+*	The \c fastpath_state is zero for a free object, contains \c __worker_instance offset tagged as a writer for a write lock acquired with the fast path,
+*	contains \c __item_instance offset tagged as a reader for a read lock acquired with the fast path, or otherwise contains the number of threads 
+*	executing the queue based operations above.
+*
+*	\li F1. (wrlock, rdlock, tryrdlock) CAS \c fastpath_state from zero to the tagged \c __worker_instance or \c __item_instance (the latter pre-started with \c __worker_instance); exit on success;
+*	\li F2. (wrlock, rdlock, trywrlock, tryrdlock) if \c fastpath_state contains a thread count, CAS it incremented and proceed with the queue based operation on success;
+*	\li F3. (wrlock, rdlock, tryrdlock) if \c fastpath_state contains a reader, acquire the mutex of \c acquired_reads, CAS the state to two threads, add the reader's item into \c acquired_reads, 
+*	release the mutex and proceed with the queue based operation on success;
+*	\li F4. (wrlock, rdlock) if \c fastpath_state contains a writer, acquire \c fastpath_wait_lock and the mutex of \c waiting_writes, CAS a wait tag into the state, 
+*	add \c __item_instance with the writer's worker into \c waiting_writes and wait on it with \c __waiter_instance, atomically releasing the mutex of \c waiting_writes; 
+*	release \c fastpath_wait_lock and proceed with the queue based operation after the wait (the writer counts this thread in);
+*	\li F5. (trywrlock) exit with EBUSY if \c fastpath_state contains a reader or a writer; (tryrdlock) exit with EBUSY if it contains a writer; otherwise goto F2;
+*	\li F6. (wrunlock, rdunlock) CAS \c fastpath_state from own tagged value to zero; exit on success;
+*	\li F7. (wrunlock) if the writer has a wait tag, acquire the mutex of \c waiting_writes, remove the waiter's item, store one thread count into \c fastpath_state,
+*	release the mutex and awaken the waiter;
+*	\li F8. (all the queue based operations) CAS \c fastpath_state decremented after an unlock or a failed lock attempt.
+*	\li F9. (wrdowngrade) CAS \c fastpath_state from own tagged value to the tagged \c __item_instance pre-started with \c __worker_instance; exit on success;
+*	otherwise (the writer has a wait tag) add \c __item_instance into \c acquired_reads under its mutex and proceed as in F7 storing two thread counts into \c fastpath_state.
+*	\li F10. (rdupgrade) CAS \c fastpath_state from own tagged \c __item_instance to the tagged \c __worker_instance; release \c upgrade_lock and exit on success.
+*
+*
 *	\see mutexgear_rwlock_init
 *	\see mutexgear_rwlock_destroy
 *	\see mutexgear_rwlock_wrlock
 *	\see mutexgear_rwlock_trywrlock
 *	\see mutexgear_rwlock_wrunlock
 *	\see mutexgear_rwlock_rdlock
+*	\see mutexgear_rwlock_tryrdlock
 *	\see mutexgear_rwlock_rdunlock
+*	\see mutexgear_rwlock_wrdowngrade
+*	\see mutexgear_rwlock_uprdlock
+*	\see mutexgear_rwlock_rdupgrade
 *	\see mutexgear_trdl_rwlock_t
 */
 typedef struct _mutexgear_rwlock
 {
 	// Fields modified by readers
 	mutexgear_completion_drainablequeue_t waiting_reads;
-	mutexgear_dlraitem_prev_t    express_reads;
+	union
+	{
+		mutexgear_dlraitem_prev_t             inline_reads;
+		_mutexgear_rwlock_expressreadstripe_t *allocated_stripes; // For stripe counts exceeding one
+
+	} express_reads;
 	ptrdiff_t                    express_commits;
+	ptrdiff_t                    queued_reads; // The number of readers blocked waiting for the writers (for mutexgear_rwlock_getstate() only)
 	// Rarely modified fields for separation
 	mutexgear_completion_queue_t waiting_writes;
 	mutexgear_completion_drain_t read_wait_drain;
+	_MUTEXGEAR_LOCK_T            fastpath_wait_lock;
+	_MUTEXGEAR_LOCK_T            upgrade_lock;
+	_MUTEXGEAR_LOCK_T            execute_lock; // The lock held by the writer combining the requests submitted with wrexecute
 	// Fields accessed by writers
 	union
 	{
@@ -350,9 +702,29 @@ typedef struct _mutexgear_rwlock
 
 	} fl_un;
 	// Fields modified by writers
-	_MUTEXGEAR_LOCK_T            reader_push_locks[_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT];
+	union
+	{
+		_MUTEXGEAR_LOCK_T           inline_locks[_MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT];
+		_MUTEXGEAR_LOCK_T           *allocated_locks; // For channel counts exceeding _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT
+
+	} reader_push_locks;
+	ptrdiff_t                    adaptivewp_writers; // The number of writers with the adaptive writer priority waiting for access
+	ptrdiff_t                    adaptivewp_score; // A running average of the adaptive writer contention
+	ptrdiff_t                    prioritywp_writers; // The number of writers with a raised writer class queued in waiting_writes
+	ptrdiff_t                    queued_writes; // The number of writers waiting for access (for mutexgear_rwlock_getstate() only)
+	mutexgear_completion_item_t  *handoff_item; // The item kept in waiting_writes by the write lock owner in the handoff mode
+	mutexgear_completion_worker_t *handoff_worker;
+	ptrdiff_t                    execute_requests; // The stack of the requests submitted with wrexecute and not taken for execution yet
+	ptrdiff_t                    write_sequence; // The counter incremented by the write lock owner on acquisition and release (odd while write-locked) for optimistic reads
+	uint64_t                     readerbias_inhibit_until; // The time before which the reader bias is not re-enabled after a revocation (accessed by lock owners only)
+	ptrdiff_t                    readerbias_state; // Non-zero while readers may be published in the visible readers table
 	// Fields modified by both readers and writers are to be kept at an end to minimize cache invalidations among the threads on other fields
+	ptrdiff_t                    fastpath_state;
 	mutexgear_completion_queue_t acquired_reads;
+#if defined(_MUTEXGEAR_WITH_STATS)
+	// The statistics counters are kept at the very end to not mix their modifications with the other fields
+	_mutexgear_rwlock_statsdata_t stats;
+#endif
 
 } mutexgear_rwlock_t;
 
@@ -366,7 +738,8 @@ typedef struct _mutexgear_rwlock
 *	thus requiring more memory and kernel objects. Also, wrlock and trywrlock operations perform an extra lock-unlock sequence 
 *	on the extra mutex to guard against potential tryrdlock's.
 *
-*	If you don't intend using tryrdlock restrain from using this object and create basic \c mutexgear_rwlock_t objects instead.
+*	If you don't intend using tryrdlock, or the lightweight tryrdlock of \c mutexgear_rwlock_t suffices, 
+*	restrain from using this object and create basic \c mutexgear_rwlock_t objects instead.
 *
 *	The operation pseudo-codes are provided below.
 *
@@ -401,7 +774,8 @@ typedef struct _mutexgear_rwlock
 *	----------
 *
 *	\li 1. atomically decrement \c wrlock_waits;
-*	\li 2. release the mutex of \c acquired_reads.
+*	\li 2. release the mutex of \c acquired_reads;
+*	\li 3. (in the handoff mode) remove the item kept by wrlock from \c waiting_writes awakening a reader waiting there, if any.
 *
 *
 *	rdlock(__worker_instance, __waiter_instance, __item_instance)
@@ -433,13 +807,30 @@ typedef struct _mutexgear_rwlock
 *	\li 3. if the read-lock being released for \c __item_instance has been acquired with a try-lock operation then acquire \c tryread_queue_lock;
 *	\li 4. remove \c __item_instance from \c acquired_reads;
 *	\li 5. release \c tryread_queue_lock if it was locked in step 3;
-*	\li 6. atomically extract the single-linked list from the \c express_reads, link the list's element "next" pointers and splice it whole before \c tryread_queue_separator into the \c acquired_reads;
+*	\li 6. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers and splice it whole before \c tryread_queue_separator into the \c acquired_reads;
 *	\li 7. release the mutex of \c acquired_reads;
 *	\li 8. awaken a writer blocked on \c __worker_instance in the \c __item_instance, if any, and exit.
-*	\li 9. atomically extract the single-linked list from the \c express_reads, link the list's element "next" pointers removing the \c __item_instance from the chain, then splice the remainder before \c tryread_queue_separator into the \c acquired_reads;
+*	\li 9. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers removing the \c __item_instance from the chain, then splice the remainder before \c tryread_queue_separator into the \c acquired_reads;
 *	\li 10. release the mutex of \c acquired_reads;
 *
 *
+*	wrdowngrade(__worker_instance, __item_instance)
+*
+*	----------
+*
+*	\li 1. add \c __item_instance with \c __worker_instance before the \c tryread_queue_separator into \c acquired_reads;
+*	\li 2. atomically extract the single-linked list from each of the \c express_reads stripes, link the list's element "next" pointers and splice it whole before \c tryread_queue_separator into the \c acquired_reads;
+*	\li 3. atomically decrement \c wrlock_waits;
+*	\li 4. release the mutex of \c acquired_reads.
+*
+*
+*	uprdlock(__worker_instance, __waiter_instance, __item_instance), uprdunlock(__worker_instance, __item_instance), rdupgrade(__worker_instance, __waiter_instance, __item_instance)
+*
+*	----------
+*
+*	(the algorithms are identical, with the trdl variants of rdlock, rdunlock and wrlock being used)
+*
+*
 *	\see mutexgear_rwlock_init
 *	\see mutexgear_rwlock_destroy
 *	\see mutexgear_rwlock_wrlock
@@ -448,6 +839,9 @@ typedef struct _mutexgear_rwlock
 *	\see mutexgear_rwlock_rdlock
 *	\see mutexgear_rwlock_tryrdlock
 *	\see mutexgear_rwlock_rdunlock
+*	\see mutexgear_rwlock_wrdowngrade
+*	\see mutexgear_rwlock_uprdlock
+*	\see mutexgear_rwlock_rdupgrade
 *	\see mutexgear_rwlock_t
 */
 typedef struct _mutexgear_trdl_rwlock
@@ -589,6 +983,13 @@ _MUTEXGEAR_BEGIN_EXTERN_C();
 #endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
 
 
+/**
+*	\def MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE
+*	\brief A value for the \c __readers_till_wp parameter of \c mutexgear_rwlock_wrlock_cwp to have the writer priority delay selected automatically
+*/
+#define MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE	(-1 - 0x7FFFFFFF) // INT_MIN
+
+
 /**
 *	\fn int mutexgear_rwlock_wrlock_cwp(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, int __readers_till_wp)
 *	\brief Acquires the object write (exclusive) lock with ability to customize write priority behavior.
@@ -609,11 +1010,20 @@ _MUTEXGEAR_BEGIN_EXTERN_C();
 *	until a particular writer gets access to a waiting channel and starts counting read lock releases. The general rule is though:
 *	the higher the parameter value is - the longer a writer could wait before forcing new incoming readers to let it ahead.
 *
+*	If \p __readers_till_wp is \c MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE the value is selected automatically for each call.
+*	The object keeps a running average of how often the adaptive writers find other adaptive writers already waiting on arrival.
+*	With rare writers among readers the writer priority is claimed immediately so that the continuous reads could not starve the writer.
+*	With write intensive mixes, where the readers are going to be blocked behind the queued writers anyway, the priority is delayed
+*	for up to 16 reader lock releases. As the delay is counted in reader lock releases it also scales with the read release rate.
+*	The writers of an object should either all use the adaptive mode or the mode should be used for the most of write locks 
+*	as writers locking with fixed \p __readers_till_wp values are not accounted.
+*
 *	\return EOK on success or a system error code on failure.
 *	\see mutexgear_rwlock_wrlock
 *	\see mutexgear_rwlock_wrunlock
 *	\see mutexgear_rwlockattr_setwritechannels
 *	\see mutexgear_rwlock_trywrlock
+*	\see mutexgear_rwlock_wrlock_twp
 */
 _MUTEXGEAR_API int mutexgear_rwlock_wrlock_cwp(mutexgear_rwlock_t *__rwlock_instance,
 	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, int __readers_till_wp);
@@ -642,171 +1052,582 @@ _MUTEXGEAR_BEGIN_EXTERN_C();
 
 
 /**
-*	\fn int mutexgear_rwlock_trywrlock(mutexgear_rwlock_t *__rwlock_instance)
-*	\brief Tries to acquire the object write (exclusive) lock without blocking
+*	\fn int mutexgear_rwlock_wrlock_twp(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, uint64_t __nanoseconds_till_wp)
+*	\brief Acquires the object write (exclusive) lock claiming write priority after a timeout.
 *
 *	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+* 
+*	The function behaves identically to \c mutexgear_rwlock_wrlock_cwp with the exception that 
+*	the write priority is claimed after the function has been waiting for \p __nanoseconds_till_wp nanoseconds 
+*	rather than after a number of reader lock releases. Until then, new readers are allowed to keep acquiring the lock.
+*	If the parameter is zero the function claims write priority immediately if there are active readers.
 *
-*	The object must not be locked for write by a single thread recursively.
+*	\note
+*	A write locking thread blocks waiting for the reader lock releases and, therefore, the timeout is only checked after each 
+*	reader lock release it witnesses. The priority is claimed at the first reader lock release after the timeout expiration.
+*	The timeout is measured with a monotonic clock where one is available.
 *
-*	\return EOK on success, EBUSY if the object is already locked by another thread, or a system error code on failure.
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlock_wrlock_cwp
 *	\see mutexgear_rwlock_wrunlock
-*	\see mutexgear_rwlock_wrlock
 */
-_MUTEXGEAR_API int mutexgear_rwlock_trywrlock(mutexgear_rwlock_t *__rwlock_instance);
+_MUTEXGEAR_API int mutexgear_rwlock_wrlock_twp(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, uint64_t __nanoseconds_till_wp);
 
-_MUTEXGEAR_API int mutexgear_trdl_rwlock_trywrlock(mutexgear_trdl_rwlock_t *__rwlock_instance);
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_wrlock_twp(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, uint64_t __nanoseconds_till_wp);
 
 #if defined(__cplusplus)
 _MUTEXGEAR_END_EXTERN_C();
 
 static inline
-int mutexgear_rwlock_trywrlock(mutexgear_trdl_rwlock_t *__rwlock_instance)
+int mutexgear_rwlock_wrlock_twp(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, uint64_t __nanoseconds_till_wp)
 {
-	return mutexgear_trdl_rwlock_trywrlock(__rwlock_instance);
+	return mutexgear_trdl_rwlock_wrlock_twp(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __nanoseconds_till_wp);
 }
 
 _MUTEXGEAR_BEGIN_EXTERN_C();
 #endif // #if defined(__cplusplus)
 
 #if defined(MUTEXGEAR_USE_C11_GENERICS)
-#define mutexgear_rwlock_trywrlock(__rwlock_instance) _Generic(__rwlock_instance, \
-	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_trywrlock, \
-	default: mutexgear_rwlock_trywrlock)(__rwlock_instance)
+#define mutexgear_rwlock_wrlock_twp(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __nanoseconds_till_wp) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_wrlock_twp, \
+	default: mutexgear_rwlock_wrlock_twp)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __nanoseconds_till_wp)
 #endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
 
 
 /**
-*	\fn int mutexgear_rwlock_wrunlock(mutexgear_rwlock_t *__rwlock_instance)
-*	\brief Releases the previously acquired object write (exclusive) lock
+*	\def MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL
+*	\brief The writer class of the regular write locks for \c mutexgear_rwlock_wrlock_pri
+*/
+#define MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL		0
+/**
+*	\def MUTEXGEAR_RWLOCK_WRITERCLASS_MAX
+*	\brief The highest writer class accepted by \c mutexgear_rwlock_wrlock_pri
+*/
+#define MUTEXGEAR_RWLOCK_WRITERCLASS_MAX		3
+/**
+*	\def MUTEXGEAR_RWLOCK_WRITERCLASS_SCHEDULING
+*	\brief A value for the \c __writer_class parameter of \c mutexgear_rwlock_wrlock_pri to have the class derived from the calling thread's scheduling priority
+*/
+#define MUTEXGEAR_RWLOCK_WRITERCLASS_SCHEDULING	(-1)
+
+
+/**
+*	\fn int mutexgear_rwlock_wrlock_pri(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, int __writer_class)
+*	\brief Acquires the object write (exclusive) lock ahead of the writers of lower classes.
 *
 *	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+* 
+*	The function behaves identically to \c mutexgear_rwlock_wrlock with the exception that the writer is assigned 
+*	the class \p __writer_class in the range from \c MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL to \c MUTEXGEAR_RWLOCK_WRITERCLASS_MAX.
+*	A writer of a raised class is queued ahead of the waiting writers of lower classes (after the ones of its own class or higher), 
+*	and a writer of a lower class that acquires the object while a higher class writer is waiting lets the latter go first. 
+*	This way, the next exclusive lock is granted to the highest class writer waiting. The writers of the normal class
+*	lock exactly like \c mutexgear_rwlock_wrlock does.
 *
-*	\return EOK on success or a system error code on failure.
+*	If \p __writer_class is \c MUTEXGEAR_RWLOCK_WRITERCLASS_SCHEDULING the class is derived from the calling thread's scheduling priority.
+*	On POSIX targets, the threads of \c SCHED_FIFO and \c SCHED_RR policies get the raised classes with their static priority range 
+*	evenly mapped onto them and the rest of the threads get the normal class. On Windows, \c THREAD_PRIORITY_ABOVE_NORMAL, 
+*	\c THREAD_PRIORITY_HIGHEST and \c THREAD_PRIORITY_TIME_CRITICAL threads get the raised classes in the ascending order.
+*
+*	A raised class writer claims write priority immediately as with the zero \c __readers_till_wp of \c mutexgear_rwlock_wrlock_cwp.
+*
+*	\note
+*	The class is honored among the writers blocked within the object only. An uncontended fast path writer is not preempted, 
+*	and with the upgradable mode enabled, the writers are serialized on the upgrade mutex in the order the system grants it 
+*	before they get into the queue. \c mutexgear_rwlock_trywrlock does not consider the waiting writers either.
+*	A lower class writer yields the processor repeatedly while the higher class writers are waiting, so the classes 
+*	are intended for a minority of latency critical writers among the regular ones.
+*
+*	\return EOK on success, EINVAL for an invalid \p __writer_class value, or a system error code on failure.
 *	\see mutexgear_rwlock_wrlock
-*	\see mutexgear_rwlock_trywrlock
+*	\see mutexgear_rwlock_wrlock_cwp
+*	\see mutexgear_rwlock_wrunlock
 */
-_MUTEXGEAR_API int mutexgear_rwlock_wrunlock(mutexgear_rwlock_t *__rwlock_instance);
+_MUTEXGEAR_API int mutexgear_rwlock_wrlock_pri(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, int __writer_class);
 
-_MUTEXGEAR_API int mutexgear_trdl_rwlock_wrunlock(mutexgear_trdl_rwlock_t *__rwlock_instance);
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_wrlock_pri(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, int __writer_class);
 
 #if defined(__cplusplus)
 _MUTEXGEAR_END_EXTERN_C();
 
 static inline
-int mutexgear_rwlock_wrunlock(mutexgear_trdl_rwlock_t *__rwlock_instance)
+int mutexgear_rwlock_wrlock_pri(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, int __writer_class)
 {
-	return mutexgear_trdl_rwlock_wrunlock(__rwlock_instance);
+	return mutexgear_trdl_rwlock_wrlock_pri(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __writer_class);
 }
 
 _MUTEXGEAR_BEGIN_EXTERN_C();
 #endif // #if defined(__cplusplus)
 
 #if defined(MUTEXGEAR_USE_C11_GENERICS)
-#define mutexgear_rwlock_wrunlock(__rwlock_instance) _Generic(__rwlock_instance, \
-	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_wrunlock, \
-	default: mutexgear_rwlock_wrunlock)(__rwlock_instance)
+#define mutexgear_rwlock_wrlock_pri(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __writer_class) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_wrlock_pri, \
+	default: mutexgear_rwlock_wrlock_pri)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __writer_class)
 #endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
 
 
 /**
-*	\fn int mutexgear_rwlock_rdlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
-*	\brief Acquires the object read (shared) lock
+*	\fn int mutexgear_rwlock_timedwrlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, const struct timespec *__abs_timeout)
+*	\brief Acquires the object write (exclusive) lock waiting no longer than until a deadline
 *
 *	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+* 
+*	The function behaves identically to \c mutexgear_rwlock_wrlock with the exception that it gives up 
+*	if the lock could not be acquired until the \p __abs_timeout deadline. The deadline is an absolute time 
+*	of the \c CLOCK_MONOTONIC clock (of the clock \c std::chrono::steady_clock uses on Windows).
+*	A deadline that has already expired still lets the lock be acquired if it is available without waiting.
 *
-*	The function requires initialized \p __worker_instance, \p __waiter_instance and
-*	\p __item_instance objects that must be allocated per calling thread (e.g. on stack).
-*	The \p __worker_instance and \p __item_instance must remain valid and not reused for other purposes 
-*	until the read lock is released with a call to \c mutexgear_rwlock_rdunlock (in particular, 
-*	the same parameters must not be used for enclosed read or write locks of other \c rwlock objects). 
-*	The \p __worker_instance must be locked with a \c mutexgear_completion_worker_lock call after initialization. 
-*	The \p __waiter_instance may be reused for nested acquisitions of other \c rwlock objects.
-*	It is recommended that the objects are allocated with calling thread for its lifetime. 
-*	If a thread may call to acquire both read and write locks during its execution 
-*	the same set of objects may be used in all the calls.
+*	On expiration, the function withdraws all its waits and leaves the object as if the call has not been made.
+*	The readers blocked behind the write lock attempt are released to re-evaluate the object state.
 *
-*	In case of inter-process synchronization all the parameters must be allocated in the same
-*	shared section as the \c rwlock object.
+*	\note
+*	If the object is held by an uncontended fast path writer the function polls for the writer 
+*	to release the object yielding the processor in between rather than blocking.
 *
-*	\return EOK on success or a system error code on failure.
-*	\see mutexgear_rwlock_rdunlock
-*	\see mutexgear_rwlock_tryrdlock
-*	\see mutexgear_completion_worker_lock
+*	\return EOK on success, ETIMEDOUT if the deadline has expired, or a system error code on failure.
+*	\see mutexgear_rwlock_wrlock
+*	\see mutexgear_rwlock_timedrdlock
+*	\see mutexgear_rwlock_wrunlock
 */
-_MUTEXGEAR_API int mutexgear_rwlock_rdlock(mutexgear_rwlock_t *__rwlock_instance,
-	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+_MUTEXGEAR_API int mutexgear_rwlock_timedwrlock(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, const struct timespec *__abs_timeout);
 
-_MUTEXGEAR_API int mutexgear_trdl_rwlock_rdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
-	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_timedwrlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, const struct timespec *__abs_timeout);
 
 #if defined(__cplusplus)
 _MUTEXGEAR_END_EXTERN_C();
 
 static inline
-int mutexgear_rwlock_rdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
-	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+int mutexgear_rwlock_timedwrlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/, const struct timespec *__abs_timeout)
 {
-	return mutexgear_trdl_rwlock_rdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance);
+	return mutexgear_trdl_rwlock_timedwrlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __abs_timeout);
 }
 
 _MUTEXGEAR_BEGIN_EXTERN_C();
 #endif // #if defined(__cplusplus)
 
 #if defined(MUTEXGEAR_USE_C11_GENERICS)
-#define mutexgear_rwlock_rdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance) _Generic(__rwlock_instance, \
-	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_rdlock, \
-	default: mutexgear_rwlock_rdlock)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance)
+#define mutexgear_rwlock_timedwrlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __abs_timeout) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_timedwrlock, \
+	default: mutexgear_rwlock_timedwrlock)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __abs_timeout)
 #endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
 
 
 /**
-*	\fn int mutexgear_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
-*	\brief Tries to acquire the object read (shared) lock without blocking
-*
-*	The function is available for \c mutexgear_trdl_rwlock_t objects only.
-*
-*	The function may speculatively return EBUSY if there would be concurrent \c mutexgear_rwlock_trywrlock
-*	calls from other threads even if those calls were going to fail due to the object being already read-locked 
-*	by yet some other threads. Also, the call obeys write lock priority and will return EBUSY if there are
-*	threads waiting to acquire the object for write.
+*	\fn int mutexgear_rwlock_trywrlock(mutexgear_rwlock_t *__rwlock_instance)
+*	\brief Tries to acquire the object write (exclusive) lock without blocking
 *
-*	The restrictions and requirements for \p __worker_instance, \p __waiter_instance objects and
-*	\p __item_instance objects match those for \c mutexgear_rwlock_rdlock call.
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
 *
-*	In case of inter-process synchronization all the parameters must be allocated in the same
-*	shared section as the \c rwlock object.
+*	The object must not be locked for write by a single thread recursively.
 *
-*	\return EOK on success, EBUSY if the object is already write-locked by another thread, or a system error code on failure.
-*	\see mutexgear_rwlock_rdunlock
-*	\see mutexgear_rwlock_rdlock
-*	\see mutexgear_completion_worker_lock
+*	\return EOK on success, EBUSY if the object is already locked by another thread, or a system error code on failure.
+*	\see mutexgear_rwlock_wrunlock
+*	\see mutexgear_rwlock_wrlock
 */
-#ifdef __MUTEXGEAR_DOXYGEN__
-_MUTEXGEAR_API int mutexgear_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
-	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
-#endif
-_MUTEXGEAR_API int mutexgear_trdl_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
-	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+_MUTEXGEAR_API int mutexgear_rwlock_trywrlock(mutexgear_rwlock_t *__rwlock_instance);
 
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_trywrlock(mutexgear_trdl_rwlock_t *__rwlock_instance);
 
 #if defined(__cplusplus)
 _MUTEXGEAR_END_EXTERN_C();
 
 static inline
-int mutexgear_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance, 
-	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+int mutexgear_rwlock_trywrlock(mutexgear_trdl_rwlock_t *__rwlock_instance)
 {
-	return mutexgear_trdl_rwlock_tryrdlock(__rwlock_instance, __worker_instance, __item_instance);
+	return mutexgear_trdl_rwlock_trywrlock(__rwlock_instance);
 }
 
 _MUTEXGEAR_BEGIN_EXTERN_C();
 #endif // #if defined(__cplusplus)
 
 #if defined(MUTEXGEAR_USE_C11_GENERICS)
-#define mutexgear_rwlock_tryrdlock(__rwlock_instance, __worker_instance, __item_instance) _Generic(__rwlock_instance, \
-	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_tryrdlock)(__rwlock_instance, __worker_instance, __item_instance)
-#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_trywrlock(__rwlock_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_trywrlock, \
+	default: mutexgear_rwlock_trywrlock)(__rwlock_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_wrunlock(mutexgear_rwlock_t *__rwlock_instance)
+*	\brief Releases the previously acquired object write (exclusive) lock
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlock_wrlock
+*	\see mutexgear_rwlock_trywrlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_wrunlock(mutexgear_rwlock_t *__rwlock_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_wrunlock(mutexgear_trdl_rwlock_t *__rwlock_instance);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_wrunlock(mutexgear_trdl_rwlock_t *__rwlock_instance)
+{
+	return mutexgear_trdl_rwlock_wrunlock(__rwlock_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_wrunlock(__rwlock_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_wrunlock, \
+	default: mutexgear_rwlock_wrunlock)(__rwlock_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_wrlock_multiple(mutexgear_rwlock_t **__rwlock_instances, size_t __rwlock_count, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance)
+*	\brief Acquires write (exclusive) locks of several objects at once without a risk of deadlock
+*
+*	The function sorts the \p __rwlock_instances array by the object addresses (the array is reordered in place) 
+*	and fails with \c EINVAL if an object appears more than once.
+*
+*	The acquisition proceeds in rounds. Each round blocks in \c mutexgear_rwlock_wrlock on a single object 
+*	(the first one in the sorted order initially, and the one found busy in the previous round later) 
+*	and then try-locks the rest with \c mutexgear_rwlock_trywrlock in the sorted order. If any of them is busy, all the acquired 
+*	locks are released, the thread yields, and a new round starts. This way, the thread does not hold any locks while blocking 
+*	and does not convoy the other threads behind the objects it has already acquired.
+*	After \c MUTEXGEAR_RWLOCK_MULTIPLE_BACKOFF_ROUNDS unsuccessful rounds the function stops backing off 
+*	and acquires the remaining locks blocking in the sorted order, which is deadlock free provided that other threads 
+*	acquiring several of the objects also use this function or follow the address order.
+*
+*	The same \p __worker_instance and \p __waiter_instance are used for all the objects. No item is passed to the individual 
+*	write locks (see \c mutexgear_rwlock_wrlock for the \c NULL item implications, e.g. the handoff mode not applying).
+*	On failure, all the locks acquired by the call are released.
+*
+*	\return EOK on success, EINVAL for duplicate objects, or a system error code on failure.
+*	\see mutexgear_rwlock_wrunlock_multiple
+*	\see mutexgear_rwlock_wrlock
+*	\see mutexgear_rwlock_trywrlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_wrlock_multiple(mutexgear_rwlock_t **__rwlock_instances, size_t __rwlock_count,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance);
+
+/**
+*	\def MUTEXGEAR_RWLOCK_MULTIPLE_BACKOFF_ROUNDS
+*	\brief The number of rounds \c mutexgear_rwlock_wrlock_multiple releases all the locks and retries before it starts blocking in the address order
+*/
+#define MUTEXGEAR_RWLOCK_MULTIPLE_BACKOFF_ROUNDS	16
+
+/**
+*	\fn int mutexgear_rwlock_wrunlock_multiple(mutexgear_rwlock_t *const *__rwlock_instances, size_t __rwlock_count)
+*	\brief Releases write (exclusive) locks of several objects acquired with \c mutexgear_rwlock_wrlock_multiple
+*
+*	The locks are released in the reverse order of the array. All the locks are attempted to be released even if some of the releases fail.
+*
+*	\return EOK on success or the first system error code encountered on failure.
+*	\see mutexgear_rwlock_wrlock_multiple
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_wrunlock_multiple(mutexgear_rwlock_t *const *__rwlock_instances, size_t __rwlock_count);
+
+
+/**
+*	\fn int mutexgear_rwlock_rdlock_coupled(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, mutexgear_rwlock_t *__parent_rwlock_instance, mutexgear_completion_item_t *__parent_item_instance)
+*	\brief Acquires the object read (shared) lock and then releases the lock of the parent object (a hand-over-hand step)
+*
+*	The function is intended for lock coupling in data structure traversals (e.g. a tree descent) where a child node must be locked 
+*	before the parent node is released. The \p __parent_rwlock_instance must be locked by the caller with the same \p __worker_instance, 
+*	either for read with \p __parent_item_instance, or for write, in which case \p __parent_item_instance must be \c NULL.
+*	The \p __parent_rwlock_instance may be \c NULL for the first step of a traversal (\p __parent_item_instance must be \c NULL then as well).
+*
+*	Unlike with the generic nested locks (see \c mutexgear_rwlock_rdlock), the \p __worker_instance is allowed to hold both the locks transiently. 
+*	The \p __item_instance must differ from \p __parent_item_instance. As the parent item is free again after the call, 
+*	a traversal of any depth can alternate just two items with a single worker.
+*
+*	If the child lock fails, the parent lock remains held. If the parent release fails, the error is returned with the child lock held.
+*	The parent and the child must be different objects. The locks must be acquired in a consistent (e.g. top-down) order among the threads to avoid deadlocks.
+*
+*	\return EOK on success, EINVAL for invalid parameter combinations, or a system error code on failure.
+*	\see mutexgear_rwlock_wrlock_coupled
+*	\see mutexgear_rwlock_rdlock
+*	\see mutexgear_rwlock_rdunlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_rdlock_coupled(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance,
+	mutexgear_rwlock_t *__parent_rwlock_instance, mutexgear_completion_item_t *__parent_item_instance);
+
+/**
+*	\fn int mutexgear_rwlock_wrlock_coupled(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, mutexgear_rwlock_t *__parent_rwlock_instance, mutexgear_completion_item_t *__parent_item_instance)
+*	\brief Acquires the object write (exclusive) lock and then releases the lock of the parent object (a hand-over-hand step)
+*
+*	The function is the write lock counterpart of \c mutexgear_rwlock_rdlock_coupled with the same parameter requirements.
+*	The \p __item_instance is passed to \c mutexgear_rwlock_wrlock and can be \c NULL.
+*
+*	\return EOK on success, EINVAL for invalid parameter combinations, or a system error code on failure.
+*	\see mutexgear_rwlock_rdlock_coupled
+*	\see mutexgear_rwlock_wrlock
+*	\see mutexgear_rwlock_wrunlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_wrlock_coupled(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance,
+	mutexgear_rwlock_t *__parent_rwlock_instance, mutexgear_completion_item_t *__parent_item_instance);
+
+
+/**
+*	\fn int mutexgear_rwlock_wrdowngrade(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+*	\brief Atomically converts the previously acquired object write (exclusive) lock into a read (shared) lock
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	No other writer can acquire the object between the write lock release and the read lock acquisition.
+*	The readers that have already been queued into \c express_reads are admitted together with the caller
+*	while the readers blocked because of waiting writers keep waiting as usual.
+*
+*	The restrictions and requirements for \p __worker_instance and \p __item_instance objects match those for \c mutexgear_rwlock_rdlock call.
+*	The acquired read lock is to be released with \c mutexgear_rwlock_rdunlock with the same \p __worker_instance and \p __item_instance.
+*
+*	\return EOK on success or a system error code on failure (the write lock remains acquired in this case).
+*	\see mutexgear_rwlock_wrlock
+*	\see mutexgear_rwlock_rdunlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_wrdowngrade(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_wrdowngrade(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_wrdowngrade(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+{
+	return mutexgear_trdl_rwlock_wrdowngrade(__rwlock_instance, __worker_instance, __item_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_wrdowngrade(__rwlock_instance, __worker_instance, __item_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_wrdowngrade, \
+	default: mutexgear_rwlock_wrdowngrade)(__rwlock_instance, __worker_instance, __item_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\typedef void (*mutexgear_rwlock_execute_fn_t)(void *__execute_context)
+*	\brief A type of procedure to be executed under the object write lock with \c mutexgear_rwlock_wrexecute
+*/
+typedef void (*mutexgear_rwlock_execute_fn_t)(void *__execute_context);
+
+/**
+*	\fn int mutexgear_rwlock_wrexecute(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context)
+*	\brief Executes a procedure under the object write (exclusive) lock combining it with the procedures submitted by other threads
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The function submits the \p __execute_proc to be called with \p __execute_context and returns after the call has been made.
+*	The submitting threads serialize on an internal lock and the thread that obtains it first acquires the write lock 
+*	(as with \c mutexgear_rwlock_wrlock) and executes all the procedures submitted by the time, including the ones submitted 
+*	while it is executing, before releasing the write lock. The other threads find their procedures executed 
+*	as they obtain the internal lock and return without accessing the object. Thus, a burst of small updates shares 
+*	a single write lock acquisition and a single wait for the readers to release the object.
+*
+*	The procedures may be executed in any thread calling the function and in any order. A procedure must not 
+*	lock the object recursively, nor may it wait for other threads to call the function for the object.
+*
+*	The restrictions and requirements for \p __worker_instance, \p __waiter_instance and \p __item_instance objects 
+*	match those for \c mutexgear_rwlock_wrlock call.
+*
+*	The function is not supported for process shared objects as the procedures submitted are not accessible in other processes.
+*
+*	\return EOK on success or a system error code on failure (the procedure is not executed in this case).
+*	\see mutexgear_rwlock_wrlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_wrexecute(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/,
+	mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_wrexecute(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/,
+	mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_wrexecute(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance/*=NULL*/,
+	mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context)
+{
+	return mutexgear_trdl_rwlock_wrexecute(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __execute_proc, __execute_context);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_wrexecute(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __execute_proc, __execute_context) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_wrexecute, \
+	default: mutexgear_rwlock_wrexecute)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __execute_proc, __execute_context)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_rdlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+*	\brief Acquires the object read (shared) lock
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The function requires initialized \p __worker_instance, \p __waiter_instance and
+*	\p __item_instance objects that must be allocated per calling thread (e.g. on stack).
+*	The \p __worker_instance and \p __item_instance must remain valid and not reused for other purposes 
+*	until the read lock is released with a call to \c mutexgear_rwlock_rdunlock (in particular, 
+*	the same \p __item_instance must not be used for enclosed read or write locks of other \c rwlock objects). 
+*	The \p __worker_instance may be shared by enclosed read locks of other objects provided that each of them 
+*	is given a distinct item (e.g. with \c mg::mtx_helpers::multi_bourgeois in C++).
+*	The \p __worker_instance must be locked with a \c mutexgear_completion_worker_lock call after initialization. 
+*	The \p __waiter_instance may be reused for nested acquisitions of other \c rwlock objects.
+*	It is recommended that the objects are allocated with calling thread for its lifetime. 
+*	If a thread may call to acquire both read and write locks during its execution 
+*	the same set of objects may be used in all the calls.
+*
+*	In case of inter-process synchronization all the parameters must be allocated in the same
+*	shared section as the \c rwlock object.
+*
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlock_rdunlock
+*	\see mutexgear_rwlock_tryrdlock
+*	\see mutexgear_completion_worker_lock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_rdlock(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_rdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_rdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+{
+	return mutexgear_trdl_rwlock_rdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_rdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_rdlock, \
+	default: mutexgear_rwlock_rdlock)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_timedrdlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, const struct timespec *__abs_timeout)
+*	\brief Acquires the object read (shared) lock waiting no longer than until a deadline
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The function behaves identically to \c mutexgear_rwlock_rdlock with the exception that it gives up
+*	if the lock could not be acquired until the \p __abs_timeout deadline (see \c mutexgear_rwlock_timedwrlock 
+*	for the deadline clock). On expiration, the \p __item_instance is unlinked from the object and can be reused immediately.
+*
+*	\return EOK on success, ETIMEDOUT if the deadline has expired, or a system error code on failure.
+*	\see mutexgear_rwlock_rdlock
+*	\see mutexgear_rwlock_timedwrlock
+*	\see mutexgear_rwlock_rdunlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_timedrdlock(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, const struct timespec *__abs_timeout);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_timedrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, const struct timespec *__abs_timeout);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_timedrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance, const struct timespec *__abs_timeout)
+{
+	return mutexgear_trdl_rwlock_timedrdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __abs_timeout);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_timedrdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __abs_timeout) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_timedrdlock, \
+	default: mutexgear_rwlock_timedrdlock)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance, __abs_timeout)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_tryrdlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+*	\brief Tries to acquire the object read (shared) lock without blocking
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	For \c mutexgear_rwlock_t objects, the function succeeds if the object can be read-locked without waiting:
+*	through the reader bias (see \c mutexgear_rwlockattr_setreaderbias), through the fast path on a free object, 
+*	or by joining the current readers in \c acquired_reads when \c waiting_writes is empty. Since the mutex of \c acquired_reads 
+*	is only try-locked, the function may speculatively return EBUSY when another thread is momentarily committing its reads there.
+*	Unlike with \c mutexgear_trdl_rwlock_t, the express path, which can't be withdrawn once the item has been linked there, is not used.
+*
+*	For \c mutexgear_trdl_rwlock_t objects, the function may speculatively return EBUSY if there would be concurrent \c mutexgear_rwlock_trywrlock
+*	calls from other threads even if those calls were going to fail due to the object being already read-locked 
+*	by yet some other threads. 
+*
+*	With both kinds of objects, the call obeys write lock priority and will return EBUSY if there are
+*	threads waiting to acquire the object for write.
+*
+*	The restrictions and requirements for \p __worker_instance, \p __waiter_instance objects and
+*	\p __item_instance objects match those for \c mutexgear_rwlock_rdlock call.
+*
+*	In case of inter-process synchronization all the parameters must be allocated in the same
+*	shared section as the \c rwlock object.
+*
+*	\return EOK on success, EBUSY if the object is already write-locked by another thread, or a system error code on failure.
+*	\see mutexgear_rwlock_rdunlock
+*	\see mutexgear_rwlock_rdlock
+*	\see mutexgear_completion_worker_lock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_tryrdlock(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock_instance, 
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+{
+	return mutexgear_trdl_rwlock_tryrdlock(__rwlock_instance, __worker_instance, __item_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_tryrdlock(__rwlock_instance, __worker_instance, __item_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_tryrdlock, \
+	default: mutexgear_rwlock_tryrdlock)(__rwlock_instance, __worker_instance, __item_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
 
 
 /**
@@ -846,6 +1667,345 @@ _MUTEXGEAR_BEGIN_EXTERN_C();
 #endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
 
 
+/**
+*	\typedef mutexgear_rwlock_optread_t
+*	\brief A type for the write sequence snapshot taken at an optimistic read start
+*
+*	\see mutexgear_rwlock_optread_begin
+*/
+typedef ptrdiff_t mutexgear_rwlock_optread_t;
+
+/**
+*	\fn int mutexgear_rwlock_optread_begin(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t *__out_read_sequence)
+*	\brief Starts an optimistic (sequence lock style) read of the data protected by the object
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	An optimistic read does not acquire the object and does not write into any memory shared with other threads. 
+*	The reader copies the protected data without a lock and then calls \c mutexgear_rwlock_optread_validate 
+*	with the sequence value returned in \p __out_read_sequence to check that no write lock has been acquired meanwhile. 
+*	If the validation fails the copy must be discarded and the read must be retried or 
+*	performed with a regular read lock (e.g. \c mutexgear_rwlock_rdlock).
+*
+*	Since a concurrent writer may be modifying the data being copied, the reader must not make any decisions 
+*	based on the copied values (dereference copied pointers, use copied sizes for memory access, etc.) before the validation succeeds.
+*	The optimistic reads are suitable for small read-mostly data that can be copied quickly.
+*
+*	\return EOK on success, EBUSY if the object is currently write-locked (the read should be 
+*	performed with a regular read lock in this case), or a system error code on failure.
+*	\see mutexgear_rwlock_optread_validate
+*	\see mutexgear_rwlock_rdlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_optread_begin(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t *__out_read_sequence);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_optread_begin(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t *__out_read_sequence);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_optread_begin(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t *__out_read_sequence)
+{
+	return mutexgear_trdl_rwlock_optread_begin(__rwlock_instance, __out_read_sequence);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_optread_begin(__rwlock_instance, __out_read_sequence) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_optread_begin, \
+	default: mutexgear_rwlock_optread_begin)(__rwlock_instance, __out_read_sequence)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_optread_validate(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t __read_sequence)
+*	\brief Validates the data copied within an optimistic read started with \c mutexgear_rwlock_optread_begin
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The \p __read_sequence must be the value obtained from the \c mutexgear_rwlock_optread_begin call on the \c rwlock. 
+*	The validation may be repeated with the same sequence value to check further data reads.
+*
+*	\return EOK if no write lock has been acquired since the optimistic read start and the copied data is consistent, 
+*	EAGAIN if the data might have been modified (the copy must be discarded), or a system error code on failure.
+*	\see mutexgear_rwlock_optread_begin
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_optread_validate(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t __read_sequence);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_optread_validate(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t __read_sequence);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_optread_validate(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_optread_t __read_sequence)
+{
+	return mutexgear_trdl_rwlock_optread_validate(__rwlock_instance, __read_sequence);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_optread_validate(__rwlock_instance, __read_sequence) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_optread_validate, \
+	default: mutexgear_rwlock_optread_validate)(__rwlock_instance, __read_sequence)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\struct mutexgear_rwlock_state_t
+*	\brief An approximate snapshot of a \c rwlock object state retrieved with \c mutexgear_rwlock_getstate
+*
+*	\see mutexgear_rwlock_getstate
+*/
+typedef struct _mutexgear_rwlock_state
+{
+	size_t      active_readers; // The estimated number of read lock owners
+	size_t      queued_writers; // The number of writers waiting for access
+	size_t      queued_readers; // The number of readers blocked waiting for the writers
+	int         write_locked; // Non-zero if the object appeared to be write-locked
+
+} mutexgear_rwlock_state_t;
+
+/**
+*	\fn int mutexgear_rwlock_getstate(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_state_t *__out_state)
+*	\brief Retrieves an approximate count of the active readers, the queued writers, and the queued readers of the object
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The function does not acquire any locks and does not modify the object. The state fields are sampled one after another 
+*	without synchronization with the lock operations and may be inconsistent among each other and outdated by the time 
+*	the function returns. The result is intended for diagnostics, progress reporting, and contention heuristics only.
+*
+*	The queued thread counts are only maintained on the blocking paths and do not add shared writes to the uncontended 
+*	read lock path. The active reader count is derived from the fast path state and the reader bias table 
+*	(see \c mutexgear_rwlockattr_setfastpath and \c mutexgear_rwlockattr_setreaderbias). With the fast path disabled, 
+*	or for \c mutexgear_trdl_rwlock_t objects, the readers locking via the queue based implementation are not reflected 
+*	in the count. The threads waiting for a fast path owner to exit and the writers draining the reader bias 
+*	readers are not counted as queued.
+*
+*	\return EOK on success (the function does not fail with valid arguments).
+*	\see mutexgear_rwlock_state_t
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_getstate(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_state_t *__out_state);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_getstate(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_state_t *__out_state);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_getstate(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_state_t *__out_state)
+{
+	return mutexgear_trdl_rwlock_getstate(__rwlock_instance, __out_state);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_getstate(__rwlock_instance, __out_state) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_getstate, \
+	default: mutexgear_rwlock_getstate)(__rwlock_instance, __out_state)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\struct mutexgear_rwlock_stats_t
+*	\brief Contention statistics of a \c rwlock object retrieved with \c mutexgear_rwlock_getstats
+*
+*	The time values are in nanoseconds.
+*
+*	\see mutexgear_rwlock_getstats
+*/
+typedef struct _mutexgear_rwlock_stats
+{
+	uint64_t    fastpath_reads; // Read locks acquired with the fast path or via the reader bias table
+	uint64_t    express_reads; // Read locks acquired via the express queue
+	uint64_t    slow_reads; // Read locks acquired under the mutex of the acquired reads queue
+	uint64_t    writes; // Write locks acquired
+	uint64_t    writer_priority_claims; // Writers that queued themselves to hold the new readers back
+	uint64_t    reader_push_lock_waits; // Writers that found a reader push lock owned and had to block on it
+	uint64_t    unlockandwaits; // Unlock-and-wait operations performed on the internal completion queues
+	uint64_t    total_wait_ns; // The total time the readers and the writers were blocked waiting for the access
+	uint64_t    max_wait_ns; // The longest single wait for the access
+	uint64_t    total_hold_ns; // The total time write locks were held
+	uint64_t    max_hold_ns; // The longest single write lock hold
+
+} mutexgear_rwlock_stats_t;
+
+/**
+*	\fn int mutexgear_rwlock_getstats(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_stats_t *__out_stats)
+*	\brief Retrieves the contention statistics collected for the object since its initialization
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The statistics are only collected if the library and its clients are built with \c _MUTEXGEAR_WITH_STATS defined
+*	(\c --enable-stats configure option). The counters are placed at the end of the object structure and are updated 
+*	with relaxed non-interlocked memory accesses, so concurrent updates may occasionally be lost and the values are 
+*	only approximate. The waits are only timed where a thread blocks on the queues; spinning and the waits of writers 
+*	for the reader bias readers to leave are not included. Read lock hold times are not tracked as the read locks 
+*	are released without touching the shared object fields on their fast paths. The counters have the size of a pointer 
+*	and the time totals wrap around after about two seconds on 32-bit targets.
+*
+*	\return EOK on success or ENOSYS if the statistics collection is not enabled in the build.
+*	\see mutexgear_rwlock_stats_t
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_getstats(mutexgear_rwlock_t *__rwlock_instance, mutexgear_rwlock_stats_t *__out_stats);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_getstats(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_stats_t *__out_stats);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_getstats(mutexgear_trdl_rwlock_t *__rwlock_instance, mutexgear_rwlock_stats_t *__out_stats)
+{
+	return mutexgear_trdl_rwlock_getstats(__rwlock_instance, __out_stats);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_getstats(__rwlock_instance, __out_stats) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_getstats, \
+	default: mutexgear_rwlock_getstats)(__rwlock_instance, __out_stats)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_uprdlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+*	\brief Acquires the object upgradable read (shared) lock
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The object must have been initialized with the upgradable mode enabled (see \c mutexgear_rwlockattr_setupgradable).
+*
+*	An upgradable read lock is shared with plain read locks but only one upgradable read lock can be held on the object 
+*	at a time, and no write lock can be acquired while it is held. The lock can be released with \c mutexgear_rwlock_uprdunlock 
+*	or promoted into a write lock with \c mutexgear_rwlock_rdupgrade.
+*
+*	The restrictions and requirements for \p __worker_instance, \p __waiter_instance and \p __item_instance objects match 
+*	those for \c mutexgear_rwlock_rdlock call.
+*
+*	\return EOK on success, EINVAL if the upgradable mode is not enabled for the object, or a system error code on failure.
+*	\see mutexgear_rwlock_uprdunlock
+*	\see mutexgear_rwlock_rdupgrade
+*	\see mutexgear_rwlockattr_setupgradable
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_uprdlock(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_uprdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_uprdlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+{
+	return mutexgear_trdl_rwlock_uprdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_uprdlock(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_uprdlock, \
+	default: mutexgear_rwlock_uprdlock)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_uprdunlock(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+*	\brief Releases the previously acquired object upgradable read (shared) lock
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The \p __worker_instance and \p __item_instance must be the same objects that were used in the previous call
+*	to \c mutexgear_rwlock_uprdlock on the \c rwlock.
+*	\return EOK on success or a system error code on failure.
+*	\see mutexgear_rwlock_uprdlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_uprdunlock(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_uprdunlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_uprdunlock(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_item_t *__item_instance)
+{
+	return mutexgear_trdl_rwlock_uprdunlock(__rwlock_instance, __worker_instance, __item_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_uprdunlock(__rwlock_instance, __worker_instance, __item_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_uprdunlock, \
+	default: mutexgear_rwlock_uprdunlock)(__rwlock_instance, __worker_instance, __item_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
+/**
+*	\fn int mutexgear_rwlock_rdupgrade(mutexgear_rwlock_t *__rwlock_instance, mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+*	\brief Promotes the previously acquired object upgradable read lock into a write (exclusive) lock
+*
+*	The function can also be called for \c mutexgear_trdl_rwlock_t objects.
+*
+*	The function waits for all the other read locks to be released the same way as \c mutexgear_rwlock_wrlock does 
+*	(claiming write priority immediately and waiting on \c reader_push_locks). Since write locks and other upgradable read locks 
+*	are excluded while the upgradable read lock is held, no other writer can acquire the object before the caller.
+*	An upgradable read lock acquired with the fast path is promoted with a single atomic operation.
+*
+*	The \p __worker_instance and \p __item_instance must be the same objects that were used in the previous call
+*	to \c mutexgear_rwlock_uprdlock on the \c rwlock. The \p __item_instance is reused for waiting for the readers.
+*	The acquired write lock is to be released with \c mutexgear_rwlock_wrunlock 
+*	(or downgraded with \c mutexgear_rwlock_wrdowngrade).
+*
+*	\return EOK on success or a system error code on failure (the upgradable read lock is retained if it could not be released; otherwise, the object is released completely).
+*	\see mutexgear_rwlock_uprdlock
+*	\see mutexgear_rwlock_wrunlock
+*/
+_MUTEXGEAR_API int mutexgear_rwlock_rdupgrade(mutexgear_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+
+_MUTEXGEAR_API int mutexgear_trdl_rwlock_rdupgrade(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance);
+
+#if defined(__cplusplus)
+_MUTEXGEAR_END_EXTERN_C();
+
+static inline
+int mutexgear_rwlock_rdupgrade(mutexgear_trdl_rwlock_t *__rwlock_instance,
+	mutexgear_completion_worker_t *__worker_instance, mutexgear_completion_waiter_t *__waiter_instance, mutexgear_completion_item_t *__item_instance)
+{
+	return mutexgear_trdl_rwlock_rdupgrade(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance);
+}
+
+_MUTEXGEAR_BEGIN_EXTERN_C();
+#endif // #if defined(__cplusplus)
+
+#if defined(MUTEXGEAR_USE_C11_GENERICS)
+#define mutexgear_rwlock_rdupgrade(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance) _Generic(__rwlock_instance, \
+	mutexgear_trdl_rwlock_t *: mutexgear_trdl_rwlock_rdupgrade, \
+	default: mutexgear_rwlock_rdupgrade)(__rwlock_instance, __worker_instance, __waiter_instance, __item_instance)
+#endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
+
+
 //////////////////////////////////////////////////////////////////////////
 
 
@@ -41,8 +41,11 @@
 #include <mutexgear/_mtx_helpers.hpp>
 #include <mutexgear/rwlock.h>
 #include <algorithm>
+#include <chrono>
 #include <limits>
+#include <memory>
 #include <system_error>
+#include <vector>
 #include <errno.h>
 
 
@@ -54,20 +57,179 @@ using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::worker;
 using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::waiter;
 using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::item;
 using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::bourgeois;
+using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::multi_bourgeois;
+using _MUTEXGEAR_MTX_HELPERS_NAMESPACE::thread_context;
+
+
+template<class TDuration>
+inline ::timespec make_timed_lock_deadline(const std::chrono::time_point<std::chrono::steady_clock, TDuration> &tpAbsTime)
+{
+	::timespec tsResult;
+
+	const std::chrono::nanoseconds nsTimeSinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(tpAbsTime.time_since_epoch());
+	if (nsTimeSinceEpoch <= std::chrono::nanoseconds::zero())
+	{
+		tsResult.tv_sec = 0;
+		tsResult.tv_nsec = 0;
+	}
+	else
+	{
+		const std::chrono::seconds sSecondsSinceEpoch = std::chrono::duration_cast<std::chrono::seconds>(nsTimeSinceEpoch);
+		tsResult.tv_sec = static_cast<time_t>(sSecondsSinceEpoch.count());
+		tsResult.tv_nsec = static_cast<long>((nsTimeSinceEpoch - sSecondsSinceEpoch).count());
+	}
+
+	return tsResult;
+}
+
+// NOTE: The library deadlines are measured with the steady clock. Other clocks are rebased onto it at the time of call.
+template<class TClock, class TDuration>
+inline ::timespec make_timed_lock_deadline(const std::chrono::time_point<TClock, TDuration> &tpAbsTime)
+{
+	return make_timed_lock_deadline(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(tpAbsTime - TClock::now()));
+}
+
+
+/**
+*	\class thread_shared_locks
+*	\brief A per-thread record of the items the shared locks are held with.
+*
+*	The record allows the shared lock methods without helper parameters to find the item a lock was acquired with.
+*	The \c thread_context items are used first. Extra items are allocated when a thread holds more shared locks 
+*	than the context has items, and are kept for reuse until the thread exits.
+*/
+class thread_shared_locks
+{
+public:
+	static thread_shared_locks &current()
+	{
+		thread_local thread_shared_locks slThreadInstance;
+		return slThreadInstance;
+	}
+
+	thread_shared_locks() noexcept
+	{
+		std::fill(m_apvContextSlotObjects, m_apvContextSlotObjects + thread_context::item_count(), nullptr);
+	}
+
+	thread_shared_locks(const thread_shared_locks &slAnotherInstance) = delete;
+
+	~thread_shared_locks() noexcept = default;
+
+	thread_shared_locks &operator =(const thread_shared_locks &slAnotherInstance) = delete;
+
+public:
+	std::size_t acquire_slot(const void *pvLockedObject)
+	{
+		MG_ASSERT(pvLockedObject != nullptr);
+
+		std::size_t siSlotIndex = find_slot(nullptr);
+
+		if (siSlotIndex == invalid_slot_index)
+		{
+			m_vesExtraSlots.push_back(extra_slot{ nullptr, std::unique_ptr<item>(new item()) });
+			siSlotIndex = thread_context::item_count() + (m_vesExtraSlots.size() - 1);
+		}
+
+		assign_slot_object(siSlotIndex, pvLockedObject);
+		return siSlotIndex;
+	}
+
+	std::size_t find_slot(const void *pvLockedObject) const noexcept
+	{
+		std::size_t siResult = invalid_slot_index;
+
+		const void *const *ppvContextSlotFound = std::find(m_apvContextSlotObjects, m_apvContextSlotObjects + thread_context::item_count(), pvLockedObject);
+
+		if (ppvContextSlotFound != m_apvContextSlotObjects + thread_context::item_count())
+		{
+			siResult = ppvContextSlotFound - m_apvContextSlotObjects;
+		}
+		else
+		{
+			for (std::size_t siExtraIndex = 0, siExtraCount = m_vesExtraSlots.size(); siExtraIndex != siExtraCount; ++siExtraIndex)
+			{
+				if (m_vesExtraSlots[siExtraIndex].m_pvLockedObject == pvLockedObject)
+				{
+					siResult = thread_context::item_count() + siExtraIndex;
+					break;
+				}
+			}
+		}
+
+		return siResult;
+	}
+
+	void release_slot(std::size_t siSlotIndex) noexcept
+	{
+		assign_slot_object(siSlotIndex, nullptr);
+	}
+
+	item &get_slot_item(thread_context &tcRefThreadContext, std::size_t siSlotIndex) noexcept
+	{
+		return siSlotIndex < thread_context::item_count() 
+			? tcRefThreadContext.get_item(siSlotIndex) 
+			: *m_vesExtraSlots[siSlotIndex - thread_context::item_count()].m_piSlotItem;
+	}
+
+	static const std::size_t invalid_slot_index = ~static_cast<std::size_t>(0);
+
+private:
+	void assign_slot_object(std::size_t siSlotIndex, const void *pvLockedObject) noexcept
+	{
+		MG_ASSERT(siSlotIndex != invalid_slot_index);
+
+		if (siSlotIndex < thread_context::item_count())
+		{
+			m_apvContextSlotObjects[siSlotIndex] = pvLockedObject;
+		}
+		else
+		{
+			m_vesExtraSlots[siSlotIndex - thread_context::item_count()].m_pvLockedObject = pvLockedObject;
+		}
+	}
+
+private:
+	struct extra_slot
+	{
+		const void				*m_pvLockedObject;
+		std::unique_ptr<item>	m_piSlotItem; // The items are allocated individually to keep their addresses while the vector grows
+	};
+
+	const void				*m_apvContextSlotObjects[thread_context::item_count()];
+	std::vector<extra_slot>	m_vesExtraSlots;
+};
 
 
 _MUTEXGEAR_END_SHMTX_HELPERS_NAMESPACE();
 
 
 struct no_wp_t { explicit no_wp_t() noexcept = default; };
+struct adaptive_wp_t { explicit adaptive_wp_t() noexcept = default; };
+struct upgradable_t { explicit upgradable_t() noexcept = default; };
+struct writer_class
+{
+	explicit writer_class(int iClassValue) noexcept : m_iClassValue(iClassValue) {}
+
+	int value() const noexcept { return m_iClassValue; }
+
+	static writer_class scheduling() noexcept { return writer_class(MUTEXGEAR_RWLOCK_WRITERCLASS_SCHEDULING); }
+
+private:
+	int m_iClassValue;
+};
 
 
 /**
 *	\class wp_shared_mutex<std::size_t tsiWriteChannels>
 *	\brief A wrapper for \c mutexgear_rwlock_t and its related functions.
 *
-*	The class implements a read-write lock without try-read lock support and with possibility to customize write channel count. 
-*	If \p tsiWriteChannels is 0 the default initialization attributes are used.
+*	The class implements a read-write lock with a lightweight try-read lock (see \c mutexgear_rwlock_tryrdlock) and with possibility to customize write channel count. 
+*	If \p tsiWriteChannels is 0 the default initialization attributes are used. Otherwise, the value must not exceed 
+*	\c _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT and is rounded up to a power of two (see \c mutexgear_rwlockattr_setwritechannels).
+*
+*	The \c lock_upgrade, \c unlock_upgrade and \c unlock_upgrade_and_lock methods can only be used with objects 
+*	constructed with the \c upgradable_t tag (see \c mutexgear_rwlockattr_setupgradable); \c lock_upgrade throws otherwise.
 *
 *	The class method names are compatible with those of \c std::shared_mutex.
 *
@@ -76,6 +238,8 @@ struct no_wp_t { explicit no_wp_t() noexcept = default; };
 template<std::size_t tsiWriteChannels=0>
 class wp_shared_mutex
 {
+	static_assert(tsiWriteChannels <= _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT, "The write channel count exceeds the implementation limit");
+
 public:
 	typedef mutexgear_rwlock_t *native_handle_type;
 
@@ -83,12 +247,29 @@ public:
 	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::worker helper_worker_type;
 	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::waiter helper_waiter_type;
 	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::item helper_item_type;
+	template<std::size_t tsiItemCount>
+	using helper_multi_bourgeois_type = _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::multi_bourgeois<tsiItemCount>;
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::thread_context helper_thread_context_type;
+
+	wp_shared_mutex() : wp_shared_mutex(false) {}
+	explicit wp_shared_mutex(upgradable_t) : wp_shared_mutex(true) {}
 
-	wp_shared_mutex()
+	wp_shared_mutex(const wp_shared_mutex &mtAnotherInstance) = delete;
+
+	~wp_shared_mutex() noexcept
+	{
+		int iSharedMutexDestructionResult;
+		MG_CHECK(iSharedMutexDestructionResult, (iSharedMutexDestructionResult = mutexgear_rwlock_destroy(&m_wlRWLockInstance)) == EOK);
+	}
+
+	wp_shared_mutex &operator =(const wp_shared_mutex &mtAnotherInstance) = delete;
+
+private:
+	explicit wp_shared_mutex(bool bUpgradableMode)
 	{
 		int iInitializationResult;
 
-		constexpr const bool bAttributesRequired = tsiWriteChannels != 0;
+		const bool bAttributesRequired = tsiWriteChannels != 0 || bUpgradableMode;
 		bool bAttributesInitialized = false, bAttributesFailed = false;
 
 		mutexgear_rwlockattr_t laLockAttributesStorage;
@@ -112,6 +293,14 @@ public:
 					bAttributesFailed = true;
 				}
 			}
+
+			if (!bAttributesFailed && bUpgradableMode)
+			{
+				if ((iInitializationResult = mutexgear_rwlockattr_setupgradable(&laLockAttributesStorage, 1)) != EOK)
+				{
+					bAttributesFailed = true;
+				}
+			}
 		}
 
 		if (!bAttributesFailed)
@@ -128,119 +317,628 @@ public:
 			}
 		}
 
-		if (iInitializationResult != EOK)
-		{
-			throw std::system_error(std::error_code(iInitializationResult, std::system_category()));
-		}
+		if (iInitializationResult != EOK)
+		{
+			throw std::system_error(std::error_code(iInitializationResult, std::system_category()));
+		}
+	}
+
+public:
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iLockResult = mutexgear_rwlock_wrlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, std::size_t siReadersTillWP)
+	{
+		// NOTE!
+		// Define NOMINMAX if you have problems building this code on Windows.
+		int iLimitedReadersTillWP = static_cast<int>(std::min(siReadersTillWP, static_cast<std::size_t>(std::numeric_limits<int>::max())));
+		int iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), iLimitedReadersTillWP);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, no_wp_t)
+	{
+		int iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), -1);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, adaptive_wp_t)
+	{
+		int iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, writer_class wcWriterClass)
+	{
+		int iLockResult = mutexgear_rwlock_wrlock_pri(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), wcWriterClass.value());
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	template<class TRep, class TPeriod>
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::duration<TRep, TPeriod> &dTimeTillWP)
+	{
+		typedef std::chrono::duration<TRep, TPeriod> time_till_wp_type;
+
+		std::uint64_t uiNanosecondsTillWP = dTimeTillWP <= time_till_wp_type::zero() ? 0U 
+			: dTimeTillWP >= std::chrono::duration_cast<time_till_wp_type>(std::chrono::nanoseconds::max()) ? static_cast<std::uint64_t>(std::chrono::nanoseconds::max().count())
+			: static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(dTimeTillWP).count());
+		int iLockResult = mutexgear_rwlock_wrlock_twp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), uiNanosecondsTillWP);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	bool try_lock()
+	{
+		int iTryLockResult = mutexgear_rwlock_trywrlock(&m_wlRWLockInstance);
+		return iTryLockResult == EOK || (iTryLockResult != EBUSY && (throw std::system_error(std::error_code(iTryLockResult, std::system_category())), false));
+	}
+
+	template<class TRep, class TPeriod>
+	bool try_lock_for(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::duration<TRep, TPeriod> &dRelTimeout)
+	{
+		return try_lock_until(bRefBourgeoisInstance, wRefWaiterInstance, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(dRelTimeout));
+	}
+
+	template<class TClock, class TDuration>
+	bool try_lock_until(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::time_point<TClock, TDuration> &tpAbsTimeout)
+	{
+		const ::timespec tsAbsTimeout = _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::make_timed_lock_deadline(tpAbsTimeout);
+		int iLockResult = mutexgear_rwlock_timedwrlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), &tsAbsTimeout);
+		return iLockResult == EOK || (iLockResult != ETIMEDOUT && (throw std::system_error(std::error_code(iLockResult, std::system_category())), false));
+	}
+
+	void unlock() noexcept
+	{
+		int iRWLockWrUnlockResult;
+		MG_CHECK(iRWLockWrUnlockResult, (iRWLockWrUnlockResult = mutexgear_rwlock_wrunlock(&m_wlRWLockInstance)) == EOK);
+	}
+
+	void unlock_and_lock_shared(helper_bourgeois_type &bRefBourgeoisInstance)
+	{
+		int iDowngradeResult = mutexgear_rwlock_wrdowngrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iDowngradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iDowngradeResult, std::system_category()));
+		}
+	}
+
+	void lock_upgrade(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iLockResult = mutexgear_rwlock_uprdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void unlock_upgrade(helper_bourgeois_type &bRefBourgeoisInstance) noexcept
+	{
+		int iRWLockUpRdUnlockResult;
+		MG_CHECK(iRWLockUpRdUnlockResult, (iRWLockUpRdUnlockResult = mutexgear_rwlock_uprdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance))) == EOK);
+	}
+
+	void unlock_upgrade_and_lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iUpgradeResult = mutexgear_rwlock_rdupgrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iUpgradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iUpgradeResult, std::system_category()));
+		}
+	}
+
+	void lock_shared(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iLockResult = mutexgear_rwlock_rdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	template<class TRep, class TPeriod>
+	bool try_lock_shared_for(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::duration<TRep, TPeriod> &dRelTimeout)
+	{
+		return try_lock_shared_until(bRefBourgeoisInstance, wRefWaiterInstance, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(dRelTimeout));
+	}
+
+	template<class TClock, class TDuration>
+	bool try_lock_shared_until(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::time_point<TClock, TDuration> &tpAbsTimeout)
+	{
+		const ::timespec tsAbsTimeout = _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::make_timed_lock_deadline(tpAbsTimeout);
+		int iLockResult = mutexgear_rwlock_timedrdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), &tsAbsTimeout);
+		return iLockResult == EOK || (iLockResult != ETIMEDOUT && (throw std::system_error(std::error_code(iLockResult, std::system_category())), false));
+	}
+
+	bool try_lock_shared(helper_bourgeois_type &bRefBourgeoisInstance)
+	{
+		int iTryLockResult = mutexgear_rwlock_tryrdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+		return iTryLockResult == EOK || (iTryLockResult != EBUSY && (throw std::system_error(std::error_code(iTryLockResult, std::system_category())), false));
+	}
+
+	void unlock_shared(helper_bourgeois_type &bRefBourgeoisInstance) noexcept
+	{
+		int iRWLockRdUnlockResult;
+		MG_CHECK(iRWLockRdUnlockResult, (iRWLockRdUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance))) == EOK);
+	}
+
+	/**
+	*	\brief Calls \p fnReadFunction to read the protected data optimistically (without locking), and under a shared lock if that fails
+	*
+	*	The function is called without a lock up to \p uiOptimisticAttempts times while the reads keep being invalidated 
+	*	by concurrent writes (see \c mutexgear_rwlock_optread_begin), and then, if still unsuccessful, with the shared lock held.
+	*	The last call's results are the valid ones. The function must tolerate inconsistent data in the optimistic calls:
+	*	it should only copy the values and must not dereference or otherwise rely on them.
+	*/
+	template<class TReadFunction>
+	void optimistic_read(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, TReadFunction &&fnReadFunction, unsigned int uiOptimisticAttempts=2)
+	{
+		for (unsigned int uiAttemptsRemaining = uiOptimisticAttempts; uiAttemptsRemaining != 0; --uiAttemptsRemaining)
+		{
+			mutexgear_rwlock_optread_t orReadSequence;
+			int iBeginResult = mutexgear_rwlock_optread_begin(&m_wlRWLockInstance, &orReadSequence);
+
+			if (iBeginResult != EOK)
+			{
+				if (iBeginResult != EBUSY)
+				{
+					throw std::system_error(std::error_code(iBeginResult, std::system_category()));
+				}
+
+				// A writer is active -- waiting for it with the shared lock is better than spinning
+				break;
+			}
+
+			fnReadFunction();
+
+			int iValidateResult = mutexgear_rwlock_optread_validate(&m_wlRWLockInstance, orReadSequence);
+
+			if (iValidateResult == EOK)
+			{
+				return;
+			}
+
+			if (iValidateResult != EAGAIN)
+			{
+				throw std::system_error(std::error_code(iValidateResult, std::system_category()));
+			}
+		}
+
+		lock_shared(bRefBourgeoisInstance, wRefWaiterInstance);
+
+		try
+		{
+			fnReadFunction();
+		}
+		catch (...)
+		{
+			unlock_shared(bRefBourgeoisInstance);
+			throw;
+		}
+
+		unlock_shared(bRefBourgeoisInstance);
+	}
+
+	/**
+	*	\brief Retrieves an approximate count of the active readers and the queued writers and readers without locking
+	*
+	*	See \c mutexgear_rwlock_getstate for the details on the snapshot accuracy.
+	*/
+	mutexgear_rwlock_state_t get_state() const noexcept
+	{
+		mutexgear_rwlock_state_t rsStateSnapshot;
+		int iGetStateResult;
+		MG_CHECK(iGetStateResult, (iGetStateResult = mutexgear_rwlock_getstate(native_handle(), &rsStateSnapshot)) == EOK);
+		return rsStateSnapshot;
+	}
+
+	/**
+	*	\brief Retrieves the contention statistics collected for the object
+	*
+	*	See \c mutexgear_rwlock_getstats for the details on the collection.
+	*
+	*	\return true on success or false if the statistics collection is not enabled in the build.
+	*/
+	bool get_stats(mutexgear_rwlock_stats_t &rsOutStats) const noexcept
+	{
+		int iGetStatsResult = mutexgear_rwlock_getstats(native_handle(), &rsOutStats);
+		MG_ASSERT(iGetStatsResult == EOK || iGetStatsResult == ENOSYS);
+
+		return iGetStatsResult == EOK;
+	}
+
+public: // Less convenient overloads
+	void lock(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iLockResult = mutexgear_rwlock_wrlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), nullptr);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void lock_shared(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance, helper_item_type &iRefItemInstance)
+	{
+		int iLockResult = mutexgear_rwlock_rdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void unlock_and_lock_shared(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance)
+	{
+		int iDowngradeResult = mutexgear_rwlock_wrdowngrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iDowngradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iDowngradeResult, std::system_category()));
+		}
+	}
+
+	void lock_upgrade(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance, helper_item_type &iRefItemInstance)
+	{
+		int iLockResult = mutexgear_rwlock_uprdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void unlock_upgrade(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance) noexcept
+	{
+		int iRWLockUpRdUnlockResult;
+		MG_CHECK(iRWLockUpRdUnlockResult, (iRWLockUpRdUnlockResult = mutexgear_rwlock_uprdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance))) == EOK);
+	}
+
+	void unlock_upgrade_and_lock(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance, helper_item_type &iRefItemInstance)
+	{
+		int iUpgradeResult = mutexgear_rwlock_rdupgrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iUpgradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iUpgradeResult, std::system_category()));
+		}
+	}
+
+	bool try_lock_shared(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance)
+	{
+		int iTryLockResult = mutexgear_rwlock_tryrdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+		return iTryLockResult == EOK || (iTryLockResult != EBUSY && (throw std::system_error(std::error_code(iTryLockResult, std::system_category())), false));
+	}
+
+	void unlock_shared(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance) noexcept
+	{
+		int iRWLockRdUnlockResult;
+		MG_CHECK(iRWLockRdUnlockResult, (iRWLockRdUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance))) == EOK);
+	}
+
+public: // Thread context overloads (see thread_context::current()). The item index selects the context item to hold a shared lock with.
+	void lock(helper_thread_context_type &tcRefThreadContext)
+	{
+		lock(tcRefThreadContext.get_worker(), tcRefThreadContext.get_waiter());
+	}
+
+	void lock_shared(helper_thread_context_type &tcRefThreadContext, std::size_t siItemIndex=0)
+	{
+		lock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_waiter(), tcRefThreadContext.get_item(siItemIndex));
+	}
+
+	bool try_lock_shared(helper_thread_context_type &tcRefThreadContext, std::size_t siItemIndex=0)
+	{
+		return try_lock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_item(siItemIndex));
+	}
+
+	void unlock_shared(helper_thread_context_type &tcRefThreadContext, std::size_t siItemIndex=0) noexcept
+	{
+		unlock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_item(siItemIndex));
+	}
+
+public:
+	native_handle_type native_handle() const noexcept { return static_cast<native_handle_type>(const_cast<mutexgear_rwlock_t *>(&m_wlRWLockInstance)); }
+
+private:
+	mutexgear_rwlock_t		m_wlRWLockInstance;
+};
+
+using shared_mutex = wp_shared_mutex<0>;
+
+
+/**
+*	\fn void lock_all(_MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::bourgeois &bRefBourgeoisInstance, _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::waiter &wRefWaiterInstance, TSharedMutexes &...smRefSharedMutexes)
+*	\brief Write-locks several \c wp_shared_mutex objects at once without a risk of deadlock (see \c mutexgear_rwlock_wrlock_multiple).
+*
+*	The objects must be distinct. A single bourgeois/waiter pair serves all the objects.
+*	Throws \c std::system_error on failure with none of the objects remaining locked.
+*/
+template<class... TSharedMutexes>
+void lock_all(_MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::bourgeois &bRefBourgeoisInstance, _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::waiter &wRefWaiterInstance, TSharedMutexes &...smRefSharedMutexes)
+{
+	mutexgear_rwlock_t *apwlRWLockInstances[] = { smRefSharedMutexes.native_handle()... };
+
+	int iLockResult = mutexgear_rwlock_wrlock_multiple(apwlRWLockInstances, sizeof(apwlRWLockInstances) / sizeof(apwlRWLockInstances[0]), static_cast<_MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::worker::pointer>(bRefBourgeoisInstance), static_cast<_MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::waiter::pointer>(wRefWaiterInstance));
+
+	if (iLockResult != EOK)
+	{
+		throw std::system_error(std::error_code(iLockResult, std::system_category()));
+	}
+}
+
+/**
+*	\fn void unlock_all(TSharedMutexes &...smRefSharedMutexes)
+*	\brief Releases write locks of several \c wp_shared_mutex objects acquired with \c lock_all.
+*/
+template<class... TSharedMutexes>
+void unlock_all(TSharedMutexes &...smRefSharedMutexes) noexcept
+{
+	mutexgear_rwlock_t *const apwlRWLockInstances[] = { smRefSharedMutexes.native_handle()... };
+
+	int iRWLockWrUnlockResult;
+	MG_CHECK(iRWLockWrUnlockResult, (iRWLockWrUnlockResult = mutexgear_rwlock_wrunlock_multiple(apwlRWLockInstances, sizeof(apwlRWLockInstances) / sizeof(apwlRWLockInstances[0]))) == EOK);
+}
+
+
+/**
+*	\class coupled_lock_iterator
+*	\brief A hand-over-hand (lock coupling) helper for traversals over \c wp_shared_mutex objects.
+*
+*	Each \c advance_shared or \c advance call locks the next object and releases the one locked by the previous step 
+*	(see \c mutexgear_rwlock_rdlock_coupled and \c mutexgear_rwlock_wrlock_coupled). The helper alternates the item of the bourgeois 
+*	with an item of its own so that a traversal of any depth is served with a single bourgeois/waiter pair.
+*	The last object locked is released with \c release or on destruction.
+*
+*	The bourgeois must not be used for other locks while the helper holds an object.
+*/
+class coupled_lock_iterator
+{
+public:
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::bourgeois helper_bourgeois_type;
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::worker helper_worker_type;
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::waiter helper_waiter_type;
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::item helper_item_type;
+
+	coupled_lock_iterator(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance) noexcept:
+		m_bRefBourgeoisInstance(bRefBourgeoisInstance),
+		m_wRefWaiterInstance(wRefWaiterInstance),
+		m_pwlCurrentRWLock(nullptr),
+		m_piCurrentItem(nullptr),
+		m_bCurrentExclusive(false)
+	{
 	}
 
-	wp_shared_mutex(const wp_shared_mutex &mtAnotherInstance) = delete;
+	coupled_lock_iterator(const coupled_lock_iterator &ciAnotherInstance) = delete;
 
-	~wp_shared_mutex() noexcept
+	~coupled_lock_iterator() noexcept
 	{
-		int iSharedMutexDestructionResult;
-		MG_CHECK(iSharedMutexDestructionResult, (iSharedMutexDestructionResult = mutexgear_rwlock_destroy(&m_wlRWLockInstance)) == EOK);
+		release();
 	}
 
-	wp_shared_mutex &operator =(const wp_shared_mutex &mtAnotherInstance) = delete;
+	coupled_lock_iterator &operator =(const coupled_lock_iterator &ciAnotherInstance) = delete;
 
 public:
-	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	template<class TSharedMutex>
+	void advance_shared(TSharedMutex &smRefNextMutex)
 	{
-		int iLockResult = mutexgear_rwlock_wrlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+		mutexgear_rwlock_t *pwlNextRWLock = smRefNextMutex.native_handle();
+		helper_item_type::pointer piNextItem = select_next_item();
+		int iLockResult = mutexgear_rwlock_rdlock_coupled(pwlNextRWLock, static_cast<helper_worker_type::pointer>(m_bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(m_wRefWaiterInstance), piNextItem, 
+			m_pwlCurrentRWLock, !m_bCurrentExclusive ? m_piCurrentItem : nullptr);
 
 		if (iLockResult != EOK)
 		{
 			throw std::system_error(std::error_code(iLockResult, std::system_category()));
 		}
+
+		assign_current(pwlNextRWLock, piNextItem, false);
 	}
 
-	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, std::size_t siReadersTillWP)
+	template<class TSharedMutex>
+	void advance(TSharedMutex &smRefNextMutex)
 	{
-		// NOTE!
-		// Define NOMINMAX if you have problems building this code on Windows.
-		int iLimitedReadersTillWP = static_cast<int>(std::min(siReadersTillWP, static_cast<std::size_t>(std::numeric_limits<int>::max())));
-		int iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), iLimitedReadersTillWP);
+		mutexgear_rwlock_t *pwlNextRWLock = smRefNextMutex.native_handle();
+		helper_item_type::pointer piNextItem = select_next_item();
+		int iLockResult = mutexgear_rwlock_wrlock_coupled(pwlNextRWLock, static_cast<helper_worker_type::pointer>(m_bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(m_wRefWaiterInstance), piNextItem, 
+			m_pwlCurrentRWLock, !m_bCurrentExclusive ? m_piCurrentItem : nullptr);
 
 		if (iLockResult != EOK)
 		{
 			throw std::system_error(std::error_code(iLockResult, std::system_category()));
 		}
+
+		assign_current(pwlNextRWLock, piNextItem, true);
 	}
 
-	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, no_wp_t)
+	void release() noexcept
 	{
-		int iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), -1);
-
-		if (iLockResult != EOK)
+		if (m_pwlCurrentRWLock != nullptr)
 		{
-			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+			int iRWLockUnlockResult;
+
+			if (m_bCurrentExclusive)
+			{
+				MG_CHECK(iRWLockUnlockResult, (iRWLockUnlockResult = mutexgear_rwlock_wrunlock(m_pwlCurrentRWLock)) == EOK);
+			}
+			else
+			{
+				MG_CHECK(iRWLockUnlockResult, (iRWLockUnlockResult = mutexgear_rwlock_rdunlock(m_pwlCurrentRWLock, static_cast<helper_worker_type::pointer>(m_bRefBourgeoisInstance), m_piCurrentItem)) == EOK);
+			}
+
+			assign_current(nullptr, nullptr, false);
 		}
 	}
 
-	bool try_lock()
+	bool owns_lock() const noexcept { return m_pwlCurrentRWLock != nullptr; }
+	bool owns_exclusive_lock() const noexcept { return m_pwlCurrentRWLock != nullptr && m_bCurrentExclusive; }
+
+private:
+	helper_item_type::pointer select_next_item() noexcept
 	{
-		int iTryLockResult = mutexgear_rwlock_trywrlock(&m_wlRWLockInstance);
-		return iTryLockResult == EOK || (iTryLockResult != EBUSY && (throw std::system_error(std::error_code(iTryLockResult, std::system_category())), false));
+		// The item of the current lock may remain in use until the lock is released (e.g. for a write lock in the handoff mode), 
+		// so the next lock always takes the other one
+		helper_item_type::pointer piBourgeoisItem = static_cast<helper_item_type::pointer>(m_bRefBourgeoisInstance);
+		return m_piCurrentItem != piBourgeoisItem ? piBourgeoisItem : static_cast<helper_item_type::pointer>(m_iAlternateItem);
 	}
 
-	void unlock() noexcept
+	void assign_current(mutexgear_rwlock_t *pwlCurrentRWLock, helper_item_type::pointer piCurrentItem, bool bCurrentExclusive) noexcept
 	{
-		int iRWLockWrUnlockResult;
-		MG_CHECK(iRWLockWrUnlockResult, (iRWLockWrUnlockResult = mutexgear_rwlock_wrunlock(&m_wlRWLockInstance)) == EOK);
+		m_pwlCurrentRWLock = pwlCurrentRWLock;
+		m_piCurrentItem = piCurrentItem;
+		m_bCurrentExclusive = bCurrentExclusive;
 	}
 
-	void lock_shared(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+private:
+	helper_bourgeois_type			&m_bRefBourgeoisInstance;
+	helper_waiter_type				&m_wRefWaiterInstance;
+	helper_item_type				m_iAlternateItem;
+	mutexgear_rwlock_t				*m_pwlCurrentRWLock;
+	helper_item_type::pointer		m_piCurrentItem;
+	bool							m_bCurrentExclusive;
+};
+
+
+/**
+*	\class standard_shared_mutex<class TSharedMutex>
+*	\brief An adapter for a \c wp_shared_mutex with the method signatures of \c std::shared_mutex.
+*
+*	The adapter takes the helper objects from the calling thread's \c thread_context. A shared lock is held with 
+*	a free context item, which is recorded in \c thread_shared_locks to be found on unlock. This allows the class to be used 
+*	with \c std::unique_lock, \c std::shared_lock, \c std::scoped_lock and other templates expecting the standard interface 
+*	and to replace \c std::shared_mutex in existing code. No allocations are made unless a thread holds more than 
+*	\c thread_context::item_count() shared locks at a time.
+*
+*	A thread must not lock the same object recursively, just as with \c std::shared_mutex.
+*/
+template<class TSharedMutex>
+class standard_shared_mutex
+{
+public:
+	typedef TSharedMutex wrapped_mutex_type;
+	typedef typename TSharedMutex::native_handle_type native_handle_type;
+
+	typedef typename TSharedMutex::helper_thread_context_type helper_thread_context_type;
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::thread_shared_locks helper_thread_shared_locks_type;
+
+	standard_shared_mutex() = default;
+	explicit standard_shared_mutex(upgradable_t utUpgradableTag) : m_smSharedMutexInstance(utUpgradableTag) {}
+
+	standard_shared_mutex(const standard_shared_mutex &smAnotherInstance) = delete;
+
+	~standard_shared_mutex() noexcept = default;
+
+	standard_shared_mutex &operator =(const standard_shared_mutex &smAnotherInstance) = delete;
+
+public:
+	void lock()
 	{
-		int iLockResult = mutexgear_rwlock_rdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+		m_smSharedMutexInstance.lock(helper_thread_context_type::current());
+	}
 
-		if (iLockResult != EOK)
-		{
-			throw std::system_error(std::error_code(iLockResult, std::system_category()));
-		}
+	bool try_lock()
+	{
+		return m_smSharedMutexInstance.try_lock();
 	}
 
-	void unlock_shared(helper_bourgeois_type &bRefBourgeoisInstance) noexcept
+	void unlock() noexcept
 	{
-		int iRWLockRdUnlockResult;
-		MG_CHECK(iRWLockRdUnlockResult, (iRWLockRdUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance))) == EOK);
+		m_smSharedMutexInstance.unlock();
 	}
 
-public: // Less convenient overloads
-	void lock(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance)
+	void lock_shared()
 	{
-		int iLockResult = mutexgear_rwlock_wrlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), nullptr);
+		helper_thread_context_type &tcRefThreadContext = helper_thread_context_type::current();
+		helper_thread_shared_locks_type &slRefSharedLocks = helper_thread_shared_locks_type::current();
+		const std::size_t siSlotIndex = slRefSharedLocks.acquire_slot(this);
 
-		if (iLockResult != EOK)
+		try
 		{
-			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+			m_smSharedMutexInstance.lock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_waiter(), slRefSharedLocks.get_slot_item(tcRefThreadContext, siSlotIndex));
+		}
+		catch (...)
+		{
+			slRefSharedLocks.release_slot(siSlotIndex);
+			throw;
 		}
 	}
 
-	void lock_shared(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance, helper_item_type &iRefItemInstance)
+	bool try_lock_shared()
 	{
-		int iLockResult = mutexgear_rwlock_rdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+		helper_thread_context_type &tcRefThreadContext = helper_thread_context_type::current();
+		helper_thread_shared_locks_type &slRefSharedLocks = helper_thread_shared_locks_type::current();
+		const std::size_t siSlotIndex = slRefSharedLocks.acquire_slot(this);
 
-		if (iLockResult != EOK)
+		bool bLockResult;
+
+		try
 		{
-			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+			bLockResult = m_smSharedMutexInstance.try_lock_shared(tcRefThreadContext.get_worker(), slRefSharedLocks.get_slot_item(tcRefThreadContext, siSlotIndex));
+		}
+		catch (...)
+		{
+			slRefSharedLocks.release_slot(siSlotIndex);
+			throw;
 		}
+
+		if (!bLockResult)
+		{
+			slRefSharedLocks.release_slot(siSlotIndex);
+		}
+
+		return bLockResult;
 	}
 
-	void unlock_shared(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance) noexcept
+	void unlock_shared() noexcept
 	{
-		int iRWLockRdUnlockResult;
-		MG_CHECK(iRWLockRdUnlockResult, (iRWLockRdUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance))) == EOK);
+		// The context exists since the lock was acquired
+		helper_thread_context_type &tcRefThreadContext = helper_thread_context_type::current();
+		helper_thread_shared_locks_type &slRefSharedLocks = helper_thread_shared_locks_type::current();
+		const std::size_t siSlotIndex = slRefSharedLocks.find_slot(this);
+		MG_ASSERT(siSlotIndex != helper_thread_shared_locks_type::invalid_slot_index);
+
+		m_smSharedMutexInstance.unlock_shared(tcRefThreadContext.get_worker(), slRefSharedLocks.get_slot_item(tcRefThreadContext, siSlotIndex));
+		slRefSharedLocks.release_slot(siSlotIndex);
 	}
 
 public:
-	native_handle_type native_handle() const noexcept { return static_cast<native_handle_type>(const_cast<mutexgear_rwlock_t *>(&m_wlRWLockInstance)); }
+	wrapped_mutex_type &wrapped_mutex() noexcept { return m_smSharedMutexInstance; }
+	native_handle_type native_handle() const noexcept { return m_smSharedMutexInstance.native_handle(); }
 
 private:
-	mutexgear_rwlock_t		m_wlRWLockInstance;
+	wrapped_mutex_type		m_smSharedMutexInstance;
 };
 
-using shared_mutex = wp_shared_mutex<0>;
+using std_shared_mutex = standard_shared_mutex<shared_mutex>;
 
 
 /**
@@ -254,7 +952,11 @@ _MUTEXGEAR_BEGIN_TRDL_NAMESPACE()
 *	\brief A wrapper for \c mutexgear_trdl_rwlock_t and its related functions.
 *
 *	The class implements a read-write lock with try-read lock support and with possibility to customize write channel count.
-*	If \p tsiWriteChannels is 0 the default initialization attributes are used.
+*	If \p tsiWriteChannels is 0 the default initialization attributes are used. Otherwise, the value must not exceed 
+*	\c _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT and is rounded up to a power of two (see \c mutexgear_rwlockattr_setwritechannels).
+*
+*	The \c lock_upgrade, \c unlock_upgrade and \c unlock_upgrade_and_lock methods can only be used with objects 
+*	constructed with the \c upgradable_t tag (see \c mutexgear_rwlockattr_setupgradable); \c lock_upgrade throws otherwise.
 *
 *	The class method names are compatible with those of \c std::shared_mutex.
 *
@@ -263,6 +965,8 @@ _MUTEXGEAR_BEGIN_TRDL_NAMESPACE()
 template<std::size_t tsiWriteChannels=0>
 class wp_shared_mutex
 {
+	static_assert(tsiWriteChannels <= _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT, "The write channel count exceeds the implementation limit");
+
 public:
 	typedef mutexgear_trdl_rwlock_t *native_handle_type;
 
@@ -270,12 +974,29 @@ public:
 	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::worker helper_worker_type;
 	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::waiter helper_waiter_type;
 	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::item helper_item_type;
+	template<std::size_t tsiItemCount>
+	using helper_multi_bourgeois_type = _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::multi_bourgeois<tsiItemCount>;
+	typedef _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::thread_context helper_thread_context_type;
+
+	wp_shared_mutex() : wp_shared_mutex(false) {}
+	explicit wp_shared_mutex(upgradable_t) : wp_shared_mutex(true) {}
+
+	wp_shared_mutex(const wp_shared_mutex &mtAnotherInstance) = delete;
+
+	~wp_shared_mutex() noexcept
+	{
+		int iSharedMutexDestructionResult;
+		MG_CHECK(iSharedMutexDestructionResult, (iSharedMutexDestructionResult = mutexgear_trdl_rwlock_destroy(&m_wlRWLockInstance)) == EOK);
+	}
+
+	wp_shared_mutex &operator =(const wp_shared_mutex &mtAnotherInstance) = delete;
 
-	wp_shared_mutex()
+private:
+	explicit wp_shared_mutex(bool bUpgradableMode)
 	{
 		int iInitializationResult;
 
-		constexpr const bool bAttributesRequired = tsiWriteChannels != 0;
+		const bool bAttributesRequired = tsiWriteChannels != 0 || bUpgradableMode;
 		bool bAttributesInitialized = false, bAttributesFailed = false;
 
 		mutexgear_rwlockattr_t laLockAttributesStorage;
@@ -299,6 +1020,14 @@ public:
 					bAttributesFailed = true;
 				}
 			}
+
+			if (!bAttributesFailed && bUpgradableMode)
+			{
+				if ((iInitializationResult = mutexgear_rwlockattr_setupgradable(&laLockAttributesStorage, 1)) != EOK)
+				{
+					bAttributesFailed = true;
+				}
+			}
 		}
 
 		if (!bAttributesFailed)
@@ -321,16 +1050,6 @@ public:
 		}
 	}
 
-	wp_shared_mutex(const wp_shared_mutex &mtAnotherInstance) = delete;
-
-	~wp_shared_mutex() noexcept
-	{
-		int iSharedMutexDestructionResult;
-		MG_CHECK(iSharedMutexDestructionResult, (iSharedMutexDestructionResult = mutexgear_trdl_rwlock_destroy(&m_wlRWLockInstance)) == EOK);
-	}
-
-	wp_shared_mutex &operator =(const wp_shared_mutex &mtAnotherInstance) = delete;
-
 public:
 	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
 	{
@@ -365,18 +1084,104 @@ public:
 		}
 	}
 
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, adaptive_wp_t)
+	{
+		int iLockResult = mutexgear_trdl_rwlock_wrlock_cwp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, writer_class wcWriterClass)
+	{
+		int iLockResult = mutexgear_trdl_rwlock_wrlock_pri(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), wcWriterClass.value());
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	template<class TRep, class TPeriod>
+	void lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::duration<TRep, TPeriod> &dTimeTillWP)
+	{
+		typedef std::chrono::duration<TRep, TPeriod> time_till_wp_type;
+
+		std::uint64_t uiNanosecondsTillWP = dTimeTillWP <= time_till_wp_type::zero() ? 0U 
+			: dTimeTillWP >= std::chrono::duration_cast<time_till_wp_type>(std::chrono::nanoseconds::max()) ? static_cast<std::uint64_t>(std::chrono::nanoseconds::max().count())
+			: static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(dTimeTillWP).count());
+		int iLockResult = mutexgear_trdl_rwlock_wrlock_twp(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), uiNanosecondsTillWP);
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
 	bool try_lock()
 	{
 		int iTryLockResult = mutexgear_trdl_rwlock_trywrlock(&m_wlRWLockInstance);
 		return iTryLockResult == EOK || (iTryLockResult != EBUSY && (throw std::system_error(std::error_code(iTryLockResult, std::system_category())), false));
 	}
 
+	template<class TRep, class TPeriod>
+	bool try_lock_for(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::duration<TRep, TPeriod> &dRelTimeout)
+	{
+		return try_lock_until(bRefBourgeoisInstance, wRefWaiterInstance, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(dRelTimeout));
+	}
+
+	template<class TClock, class TDuration>
+	bool try_lock_until(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::time_point<TClock, TDuration> &tpAbsTimeout)
+	{
+		const ::timespec tsAbsTimeout = _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::make_timed_lock_deadline(tpAbsTimeout);
+		int iLockResult = mutexgear_trdl_rwlock_timedwrlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), &tsAbsTimeout);
+		return iLockResult == EOK || (iLockResult != ETIMEDOUT && (throw std::system_error(std::error_code(iLockResult, std::system_category())), false));
+	}
+
 	void unlock() noexcept
 	{
 		int iRWLockWrUnlockResult;
 		MG_CHECK(iRWLockWrUnlockResult, (iRWLockWrUnlockResult = mutexgear_trdl_rwlock_wrunlock(&m_wlRWLockInstance)) == EOK);
 	}
 
+	void unlock_and_lock_shared(helper_bourgeois_type &bRefBourgeoisInstance)
+	{
+		int iDowngradeResult = mutexgear_trdl_rwlock_wrdowngrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iDowngradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iDowngradeResult, std::system_category()));
+		}
+	}
+
+	void lock_upgrade(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iLockResult = mutexgear_trdl_rwlock_uprdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void unlock_upgrade(helper_bourgeois_type &bRefBourgeoisInstance) noexcept
+	{
+		int iRWLockUpRdUnlockResult;
+		MG_CHECK(iRWLockUpRdUnlockResult, (iRWLockUpRdUnlockResult = mutexgear_trdl_rwlock_uprdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance))) == EOK);
+	}
+
+	void unlock_upgrade_and_lock(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
+	{
+		int iUpgradeResult = mutexgear_trdl_rwlock_rdupgrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
+
+		if (iUpgradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iUpgradeResult, std::system_category()));
+		}
+	}
+
 	void lock_shared(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance)
 	{
 		int iLockResult = mutexgear_trdl_rwlock_rdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
@@ -387,6 +1192,20 @@ public:
 		}
 	}
 
+	template<class TRep, class TPeriod>
+	bool try_lock_shared_for(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::duration<TRep, TPeriod> &dRelTimeout)
+	{
+		return try_lock_shared_until(bRefBourgeoisInstance, wRefWaiterInstance, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(dRelTimeout));
+	}
+
+	template<class TClock, class TDuration>
+	bool try_lock_shared_until(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, const std::chrono::time_point<TClock, TDuration> &tpAbsTimeout)
+	{
+		const ::timespec tsAbsTimeout = _MUTEXGEAR_SHMTX_HELPERS_NAMESPACE::make_timed_lock_deadline(tpAbsTimeout);
+		int iLockResult = mutexgear_trdl_rwlock_timedrdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance), &tsAbsTimeout);
+		return iLockResult == EOK || (iLockResult != ETIMEDOUT && (throw std::system_error(std::error_code(iLockResult, std::system_category())), false));
+	}
+
 	bool try_lock_shared(helper_bourgeois_type &bRefBourgeoisInstance)
 	{
 		int iTryLockResult = mutexgear_trdl_rwlock_tryrdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance));
@@ -399,6 +1218,91 @@ public:
 		MG_CHECK(iRWLockRdUnlockResult, (iRWLockRdUnlockResult = mutexgear_trdl_rwlock_rdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(bRefBourgeoisInstance), static_cast<helper_item_type::pointer>(bRefBourgeoisInstance))) == EOK);
 	}
 
+	/**
+	*	\brief Calls \p fnReadFunction to read the protected data optimistically (without locking), and under a shared lock if that fails
+	*
+	*	The function is called without a lock up to \p uiOptimisticAttempts times while the reads keep being invalidated 
+	*	by concurrent writes (see \c mutexgear_rwlock_optread_begin), and then, if still unsuccessful, with the shared lock held.
+	*	The last call's results are the valid ones. The function must tolerate inconsistent data in the optimistic calls:
+	*	it should only copy the values and must not dereference or otherwise rely on them.
+	*/
+	template<class TReadFunction>
+	void optimistic_read(helper_bourgeois_type &bRefBourgeoisInstance, helper_waiter_type &wRefWaiterInstance, TReadFunction &&fnReadFunction, unsigned int uiOptimisticAttempts=2)
+	{
+		for (unsigned int uiAttemptsRemaining = uiOptimisticAttempts; uiAttemptsRemaining != 0; --uiAttemptsRemaining)
+		{
+			mutexgear_rwlock_optread_t orReadSequence;
+			int iBeginResult = mutexgear_trdl_rwlock_optread_begin(&m_wlRWLockInstance, &orReadSequence);
+
+			if (iBeginResult != EOK)
+			{
+				if (iBeginResult != EBUSY)
+				{
+					throw std::system_error(std::error_code(iBeginResult, std::system_category()));
+				}
+
+				// A writer is active -- waiting for it with the shared lock is better than spinning
+				break;
+			}
+
+			fnReadFunction();
+
+			int iValidateResult = mutexgear_trdl_rwlock_optread_validate(&m_wlRWLockInstance, orReadSequence);
+
+			if (iValidateResult == EOK)
+			{
+				return;
+			}
+
+			if (iValidateResult != EAGAIN)
+			{
+				throw std::system_error(std::error_code(iValidateResult, std::system_category()));
+			}
+		}
+
+		lock_shared(bRefBourgeoisInstance, wRefWaiterInstance);
+
+		try
+		{
+			fnReadFunction();
+		}
+		catch (...)
+		{
+			unlock_shared(bRefBourgeoisInstance);
+			throw;
+		}
+
+		unlock_shared(bRefBourgeoisInstance);
+	}
+
+	/**
+	*	\brief Retrieves an approximate count of the active readers and the queued writers and readers without locking
+	*
+	*	See \c mutexgear_rwlock_getstate for the details on the snapshot accuracy.
+	*/
+	mutexgear_rwlock_state_t get_state() const noexcept
+	{
+		mutexgear_rwlock_state_t rsStateSnapshot;
+		int iGetStateResult;
+		MG_CHECK(iGetStateResult, (iGetStateResult = mutexgear_trdl_rwlock_getstate(native_handle(), &rsStateSnapshot)) == EOK);
+		return rsStateSnapshot;
+	}
+
+	/**
+	*	\brief Retrieves the contention statistics collected for the object
+	*
+	*	See \c mutexgear_rwlock_getstats for the details on the collection.
+	*
+	*	\return true on success or false if the statistics collection is not enabled in the build.
+	*/
+	bool get_stats(mutexgear_rwlock_stats_t &rsOutStats) const noexcept
+	{
+		int iGetStatsResult = mutexgear_trdl_rwlock_getstats(native_handle(), &rsOutStats);
+		MG_ASSERT(iGetStatsResult == EOK || iGetStatsResult == ENOSYS);
+
+		return iGetStatsResult == EOK;
+	}
+
 public: // Less convenient overloads
 	void lock(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance)
 	{
@@ -420,6 +1324,42 @@ public: // Less convenient overloads
 		}
 	}
 
+	void unlock_and_lock_shared(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance)
+	{
+		int iDowngradeResult = mutexgear_trdl_rwlock_wrdowngrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iDowngradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iDowngradeResult, std::system_category()));
+		}
+	}
+
+	void lock_upgrade(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance, helper_item_type &iRefItemInstance)
+	{
+		int iLockResult = mutexgear_trdl_rwlock_uprdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iLockResult != EOK)
+		{
+			throw std::system_error(std::error_code(iLockResult, std::system_category()));
+		}
+	}
+
+	void unlock_upgrade(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance) noexcept
+	{
+		int iRWLockUpRdUnlockResult;
+		MG_CHECK(iRWLockUpRdUnlockResult, (iRWLockUpRdUnlockResult = mutexgear_trdl_rwlock_uprdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance))) == EOK);
+	}
+
+	void unlock_upgrade_and_lock(helper_worker_type &wRefWorkerInstance, helper_waiter_type &wRefWaiterInstance, helper_item_type &iRefItemInstance)
+	{
+		int iUpgradeResult = mutexgear_trdl_rwlock_rdupgrade(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_waiter_type::pointer>(wRefWaiterInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
+
+		if (iUpgradeResult != EOK)
+		{
+			throw std::system_error(std::error_code(iUpgradeResult, std::system_category()));
+		}
+	}
+
 	bool try_lock_shared(helper_worker_type &wRefWorkerInstance, helper_item_type &iRefItemInstance)
 	{
 		int iTryLockResult = mutexgear_trdl_rwlock_tryrdlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance));
@@ -432,6 +1372,27 @@ public: // Less convenient overloads
 		MG_CHECK(iRWLockRdUnlockResult, (iRWLockRdUnlockResult = mutexgear_trdl_rwlock_rdunlock(&m_wlRWLockInstance, static_cast<helper_worker_type::pointer>(wRefWorkerInstance), static_cast<helper_item_type::pointer>(iRefItemInstance))) == EOK);
 	}
 
+public: // Thread context overloads (see thread_context::current()). The item index selects the context item to hold a shared lock with.
+	void lock(helper_thread_context_type &tcRefThreadContext)
+	{
+		lock(tcRefThreadContext.get_worker(), tcRefThreadContext.get_waiter());
+	}
+
+	void lock_shared(helper_thread_context_type &tcRefThreadContext, std::size_t siItemIndex=0)
+	{
+		lock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_waiter(), tcRefThreadContext.get_item(siItemIndex));
+	}
+
+	bool try_lock_shared(helper_thread_context_type &tcRefThreadContext, std::size_t siItemIndex=0)
+	{
+		return try_lock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_item(siItemIndex));
+	}
+
+	void unlock_shared(helper_thread_context_type &tcRefThreadContext, std::size_t siItemIndex=0) noexcept
+	{
+		unlock_shared(tcRefThreadContext.get_worker(), tcRefThreadContext.get_item(siItemIndex));
+	}
+
 public:
 	native_handle_type native_handle() const noexcept { return static_cast<native_handle_type>(const_cast<mutexgear_trdl_rwlock_t *>(&m_wlRWLockInstance)); }
 
@@ -440,6 +1401,7 @@ private:
 };
 
 using shared_mutex = wp_shared_mutex<0>;
+using std_shared_mutex = _MUTEXGEAR_NAMESPACE::standard_shared_mutex<shared_mutex>;
 
 
 _MUTEXGEAR_END_TRDL_NAMESPACE();
@@ -150,6 +150,7 @@ extern volatile intmax_t mg_failed_check_status;
 #define __MUTEGEAR_ATOMIC_STORE_RELEASE_PTRDIFF(destination, value) (destination)->store((ptrdiff_t)(value), std::memory_order_release)
 #define __MUTEGEAR_ATOMIC_CAS_RELAXED_PTRDIFF(destination, comparand_and_update, value) (destination)->compare_exchange_strong(*(comparand_and_update), (ptrdiff_t)(value), std::memory_order_relaxed, std::memory_order_relaxed)
 #define __MUTEGEAR_ATOMIC_CAS_RELEASE_PTRDIFF(destination, comparand_and_update, value) (destination)->compare_exchange_strong(*(comparand_and_update), (ptrdiff_t)(value), std::memory_order_release, std::memory_order_relaxed)
+#define __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF(destination, comparand_and_update, value) (destination)->compare_exchange_strong(*(comparand_and_update), (ptrdiff_t)(value), std::memory_order_acq_rel, std::memory_order_relaxed)
 #define __MUTEGEAR_ATOMIC_SWAP_RELEASE_PTRDIFF(destination, value) (destination)->exchange((ptrdiff_t)(value), std::memory_order_release)
 #define __MUTEGEAR_ATOMIC_FETCH_ADD_RELAXED_PTRDIFF(destination, value) (destination)->fetch_add((ptrdiff_t)(value), std::memory_order_relaxed)
 #define __MUTEGEAR_ATOMIC_FETCH_SUB_RELAXED_PTRDIFF(destination, value) (destination)->fetch_sub((ptrdiff_t)(value), std::memory_order_relaxed)
@@ -159,6 +160,9 @@ extern volatile intmax_t mg_failed_check_status;
 #define __MUTEGEAR_ATOMIC_UNSAFEAND_RELAXED_PTRDIFF(destination, value, original_storage) ((original_storage) = (ptrdiff_t)(destination)->load(std::memory_order_relaxed), (void)(destination)->fetch_sub((ptrdiff_t)((original_storage) & ~(ptrdiff_t)(value)), std::memory_order_relaxed))
 #define __MUTEGEAR_ATOMIC_LOAD_RELAXED_PTRDIFF(source) ((ptrdiff_t)(source)->load(std::memory_order_relaxed))
 #define __MUTEGEAR_ATOMIC_LOAD_ACQUIRE_PTRDIFF(source) ((ptrdiff_t)(source)->load(std::memory_order_acquire))
+#define __MUTEGEAR_ATOMIC_THREAD_FENCE_ACQUIRE() std::atomic_thread_fence(std::memory_order_acquire)
+#define __MUTEGEAR_ATOMIC_THREAD_FENCE_RELEASE() std::atomic_thread_fence(std::memory_order_release)
+#define __MUTEGEAR_ATOMIC_THREAD_FENCE_SEQCST() std::atomic_thread_fence(std::memory_order_seq_cst)
 
 
 #else // #ifndef _MUTEXGEAR_HAVE_CXX11_ATOMICS
@@ -195,6 +199,7 @@ extern volatile intmax_t mg_failed_check_status;
 #define __MUTEGEAR_ATOMIC_STORE_RELEASE_PTRDIFF(destination, value) atomic_store_explicit(destination, (ptrdiff_t)(value), memory_order_release)
 #define __MUTEGEAR_ATOMIC_CAS_RELAXED_PTRDIFF(destination, comparand_and_update, value) atomic_compare_exchange_strong_explicit(destination, comparand_and_update, (ptrdiff_t)(value), memory_order_relaxed, memory_order_relaxed)
 #define __MUTEGEAR_ATOMIC_CAS_RELEASE_PTRDIFF(destination, comparand_and_update, value) atomic_compare_exchange_strong_explicit(destination, comparand_and_update, (ptrdiff_t)(value), memory_order_release, memory_order_relaxed)
+#define __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF(destination, comparand_and_update, value) atomic_compare_exchange_strong_explicit(destination, comparand_and_update, (ptrdiff_t)(value), memory_order_acq_rel, memory_order_relaxed)
 #define __MUTEGEAR_ATOMIC_SWAP_RELEASE_PTRDIFF(destination, value) atomic_exchange_explicit(destination, (ptrdiff_t)(value), memory_order_release)
 #define __MUTEGEAR_ATOMIC_FETCH_ADD_RELAXED_PTRDIFF(destination, value) atomic_fetch_add_explicit(destination, (ptrdiff_t)(value), memory_order_relaxed)
 #define __MUTEGEAR_ATOMIC_FETCH_SUB_RELAXED_PTRDIFF(destination, value) atomic_fetch_sub_explicit(destination, (ptrdiff_t)(value), memory_order_relaxed)
@@ -204,6 +209,9 @@ extern volatile intmax_t mg_failed_check_status;
 #define __MUTEGEAR_ATOMIC_UNSAFEAND_RELAXED_PTRDIFF(destination, value, original_storage) ((original_storage) = (ptrdiff_t)atomic_load_explicit(destination, memory_order_relaxed), (void)atomic_fetch_sub_explicit(destination, (ptrdiff_t)((original_storage) & ~(ptrdiff_t)(value)), memory_order_relaxed))
 #define __MUTEGEAR_ATOMIC_LOAD_RELAXED_PTRDIFF(source) ((ptrdiff_t)atomic_load_explicit(source, memory_order_relaxed))
 #define __MUTEGEAR_ATOMIC_LOAD_ACQUIRE_PTRDIFF(source) ((ptrdiff_t)atomic_load_explicit(source, memory_order_acquire))
+#define __MUTEGEAR_ATOMIC_THREAD_FENCE_ACQUIRE() atomic_thread_fence(memory_order_acquire)
+#define __MUTEGEAR_ATOMIC_THREAD_FENCE_RELEASE() atomic_thread_fence(memory_order_release)
+#define __MUTEGEAR_ATOMIC_THREAD_FENCE_SEQCST() atomic_thread_fence(memory_order_seq_cst)
 
 
 #else // #ifndef _MUTEXGEAR_HAVE_C11
@@ -262,6 +270,10 @@ extern volatile intmax_t mg_failed_check_status;
 #error Please define __MUTEGEAR_ATOMIC_CAS_RELEASE_PTRDIFF
 #endif
 
+#ifndef __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF
+#error Please define __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF
+#endif
+
 #ifndef __MUTEGEAR_ATOMIC_SWAP_RELEASE_PTRDIFF
 #error Please define __MUTEGEAR_ATOMIC_SWAP_RELEASE_PTRDIFF
 #endif
@@ -290,6 +302,18 @@ extern volatile intmax_t mg_failed_check_status;
 #error Please define __MUTEGEAR_ATOMIC_LOAD_ACQUIRE_PTRDIFF
 #endif
 
+#ifndef __MUTEGEAR_ATOMIC_THREAD_FENCE_ACQUIRE
+#error Please define __MUTEGEAR_ATOMIC_THREAD_FENCE_ACQUIRE
+#endif
+
+#ifndef __MUTEGEAR_ATOMIC_THREAD_FENCE_RELEASE
+#error Please define __MUTEGEAR_ATOMIC_THREAD_FENCE_RELEASE
+#endif
+
+#ifndef __MUTEGEAR_ATOMIC_THREAD_FENCE_SEQCST
+#error Please define __MUTEGEAR_ATOMIC_THREAD_FENCE_SEQCST
+#endif
+
 #ifndef __MUTEGEAR_ATOMIC_OR_RELAXED_PTRDIFF
 _MUTEXGEAR_PURE_INLINE _MUTEXGEAR_ALWAYS_INLINE
 ptrdiff_t __mg_atomic_or_relaxed_ptrdiff_helper(volatile __MUTEXGEAR_ATOMIC_PTRDIFF_NS __MUTEXGEAR_ATOMIC_PTRDIFF_T *ppdDestination, ptrdiff_t pdValue)
@@ -404,6 +428,12 @@ bool _mg_atomic_cas_release_ptrdiff(volatile _mg_atomic_ptrdiff_t *__destination
 	return __MUTEGEAR_ATOMIC_CAS_RELEASE_PTRDIFF(__destination, __comparand_and_update, __value1);
 }
 
+_MUTEXGEAR_PURE_INLINE _MUTEXGEAR_ALWAYS_INLINE
+bool _mg_atomic_cas_acqrel_ptrdiff(volatile _mg_atomic_ptrdiff_t *__destination, ptrdiff_t *__comparand_and_update, ptrdiff_t __value1)
+{
+	return __MUTEGEAR_ATOMIC_CAS_ACQREL_PTRDIFF(__destination, __comparand_and_update, __value1);
+}
+
 _MUTEXGEAR_PURE_INLINE _MUTEXGEAR_ALWAYS_INLINE
 ptrdiff_t _mg_atomic_swap_release_ptrdiff(volatile _mg_atomic_ptrdiff_t *__destination, ptrdiff_t __value1)
 {
@@ -470,6 +500,24 @@ ptrdiff_t _mg_atomic_load_acquire_ptrdiff(const volatile _mg_atomic_ptrdiff_t *_
 	return __MUTEGEAR_ATOMIC_LOAD_ACQUIRE_PTRDIFF((volatile _mg_atomic_ptrdiff_t *)__source);
 }
 
+_MUTEXGEAR_PURE_INLINE _MUTEXGEAR_ALWAYS_INLINE
+void _mg_atomic_thread_fence_acquire()
+{
+	__MUTEGEAR_ATOMIC_THREAD_FENCE_ACQUIRE();
+}
+
+_MUTEXGEAR_PURE_INLINE _MUTEXGEAR_ALWAYS_INLINE
+void _mg_atomic_thread_fence_release()
+{
+	__MUTEGEAR_ATOMIC_THREAD_FENCE_RELEASE();
+}
+
+_MUTEXGEAR_PURE_INLINE _MUTEXGEAR_ALWAYS_INLINE
+void _mg_atomic_thread_fence_seqcst()
+{
+	__MUTEGEAR_ATOMIC_THREAD_FENCE_SEQCST();
+}
+
 
 #endif // #ifndef __MUTEXGEAR_UTILITY_H_INCLUDED
 
@@ -23,8 +23,15 @@
  */
 
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For PTHREAD_MUTEX_ADAPTIVE_NP
+#endif
+
+
 #include "completion.h"
 
+#include <stdlib.h>
+
 
 //////////////////////////////////////////////////////////////////////////
  // Completion CancelableQueue Implementation
@@ -295,6 +302,120 @@ void _mutexgear_completion_cancelablequeueditem_unsafefinish__unlocked(mutexgear
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Completion Thread Context Implementation
+
+static _MUTEXGEAR_ONCE_T g_threadcontext_keyonce = _MUTEXGEAR_ONCE_INITIALIZER;
+static _MUTEXGEAR_TSSKEY_T g_threadcontext_key;
+static int g_threadcontext_keystatus = EOK;
+
+
+static
+int _mutexgear_completion_threadcontext_create(mutexgear_completion_threadcontext_t **__out_context)
+{
+	int ret;
+	bool success = false;
+	mutexgear_completion_threadcontext_t *context_instance;
+	bool worker_initialized = false, waiter_initialized = false, worker_locked = false;
+	unsigned int item_index;
+
+	do
+	{
+		if ((context_instance = (mutexgear_completion_threadcontext_t *)malloc(sizeof(mutexgear_completion_threadcontext_t))) == NULL)
+		{
+			ret = ENOMEM;
+			break;
+		}
+
+		if ((ret = _mutexgear_completion_worker_init(&context_instance->thread_worker, NULL)) != EOK)
+		{
+			break;
+		}
+		worker_initialized = true;
+
+		if ((ret = _mutexgear_completion_waiter_init(&context_instance->thread_waiter, NULL)) != EOK)
+		{
+			break;
+		}
+		waiter_initialized = true;
+
+		if ((ret = _mutexgear_completion_worker_lock(&context_instance->thread_worker)) != EOK)
+		{
+			break;
+		}
+		worker_locked = true;
+
+		for (item_index = 0; item_index != MUTEXGEAR_COMPLETION_THREADCONTEXT_ITEM_COUNT; ++item_index)
+		{
+			mutexgear_completion_item_init(&context_instance->thread_items[item_index]);
+		}
+
+		*__out_context = context_instance;
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		int worker_unlock_status, waiter_destroy_status, worker_destroy_status;
+
+		if (worker_locked)
+		{
+			MG_CHECK(worker_unlock_status, (worker_unlock_status = _mutexgear_completion_worker_unlock(&context_instance->thread_worker)) == EOK); // This should succeed normally
+		}
+
+		if (waiter_initialized)
+		{
+			MG_CHECK(waiter_destroy_status, (waiter_destroy_status = _mutexgear_completion_waiter_destroy(&context_instance->thread_waiter)) == EOK); // This should succeed normally
+		}
+
+		if (worker_initialized)
+		{
+			MG_CHECK(worker_destroy_status, (worker_destroy_status = _mutexgear_completion_worker_destroy(&context_instance->thread_worker)) == EOK); // This should succeed normally
+		}
+
+		if (context_instance != NULL)
+		{
+			free(context_instance);
+		}
+	}
+
+	return ret;
+}
+
+static
+void _mutexgear_completion_threadcontext_destroy(mutexgear_completion_threadcontext_t *__context_instance)
+{
+	int worker_unlock_status, waiter_destroy_status, worker_destroy_status;
+	unsigned int item_index;
+
+	for (item_index = 0; item_index != MUTEXGEAR_COMPLETION_THREADCONTEXT_ITEM_COUNT; ++item_index)
+	{
+		mutexgear_completion_item_destroy(&__context_instance->thread_items[item_index]);
+	}
+
+	MG_CHECK(worker_unlock_status, (worker_unlock_status = _mutexgear_completion_worker_unlock(&__context_instance->thread_worker)) == EOK); // This should succeed normally
+	MG_CHECK(waiter_destroy_status, (waiter_destroy_status = _mutexgear_completion_waiter_destroy(&__context_instance->thread_waiter)) == EOK); // This should succeed normally
+	MG_CHECK(worker_destroy_status, (worker_destroy_status = _mutexgear_completion_worker_destroy(&__context_instance->thread_worker)) == EOK); // This should succeed normally
+
+	free(__context_instance);
+}
+
+static
+_MUTEXGEAR_TSSKEY_DESTRUCTOR(_mutexgear_completion_threadcontext_keydestructor, __key_value)
+{
+	// The key values are only destroyed with their owner threads exiting
+	_mutexgear_completion_threadcontext_destroy((mutexgear_completion_threadcontext_t *)__key_value);
+}
+
+static
+void _mutexgear_completion_threadcontext_createkey(void)
+{
+	g_threadcontext_keystatus = _mutexgear_tsskey_create(&g_threadcontext_key, &_mutexgear_completion_threadcontext_keydestructor);
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 // Completion Attribute Public APIs Implementation
 
@@ -348,6 +469,18 @@ int mutexgear_completion_genattr_setprotocol(mutexgear_completion_genattr_t *__a
 	return _mutexgear_completion_genattr_setprotocol(__attr, __protocol);
 }
 
+/*_MUTEXGEAR_API */
+int mutexgear_completion_genattr_getadaptivespin(const mutexgear_completion_genattr_t *__attr, int *__out_spin_enabled)
+{
+	return _mutexgear_completion_genattr_getadaptivespin(__attr, __out_spin_enabled);
+}
+
+/*_MUTEXGEAR_API */
+int mutexgear_completion_genattr_setadaptivespin(mutexgear_completion_genattr_t *__attr, int __spin_enabled)
+{
+	return _mutexgear_completion_genattr_setadaptivespin(__attr, __spin_enabled);
+}
+
 /*_MUTEXGEAR_API */
 int mutexgear_completion_genattr_setmutexattr(mutexgear_completion_genattr_t *__attr, const _MUTEXGEAR_LOCKATTR_T *__mutexattr)
 {
@@ -396,6 +529,47 @@ int mutexgear_completion_waiter_destroy(mutexgear_completion_waiter_t *__waiter_
 }
 
 
+/*_MUTEXGEAR_API */
+int mutexgear_completion_threadcontext_get(mutexgear_completion_threadcontext_t **__out_context)
+{
+	int ret;
+	mutexgear_completion_threadcontext_t *context_instance;
+
+	do
+	{
+		if ((ret = _mutexgear_once_execute(&g_threadcontext_keyonce, &_mutexgear_completion_threadcontext_createkey)) != EOK)
+		{
+			break;
+		}
+
+		if ((ret = g_threadcontext_keystatus) != EOK)
+		{
+			break;
+		}
+
+		if ((context_instance = (mutexgear_completion_threadcontext_t *)_mutexgear_tsskey_getvalue(g_threadcontext_key)) == NULL)
+		{
+			if ((ret = _mutexgear_completion_threadcontext_create(&context_instance)) != EOK)
+			{
+				break;
+			}
+
+			if ((ret = _mutexgear_tsskey_setvalue(g_threadcontext_key, context_instance)) != EOK)
+			{
+				_mutexgear_completion_threadcontext_destroy(context_instance);
+				break;
+			}
+		}
+
+		*__out_context = context_instance;
+		MG_ASSERT(ret == EOK);
+	}
+	while (false);
+
+	return ret;
+}
+
+
 /*_MUTEXGEAR_API */
 int mutexgear_completion_queue_init(mutexgear_completion_queue_t *__queue_instance, const mutexgear_completion_genattr_t *__attr/*=NULL*/)
 {
@@ -409,15 +583,64 @@ int mutexgear_completion_queue_destroy(mutexgear_completion_queue_t *__queue_ins
 }
 
 
+// The statistics are only collected by the public lock and unlock entry points
+// so that the queues used internally by the other objects do not pay for them
+
+_MUTEXGEAR_PURE_INLINE
+int completion_queue_stats_lock(mutexgear_completion_locktoken_t *__out_acquired_lock/*=NULL*/, mutexgear_completion_queue_t *__queue_instance)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	int ret;
+
+	if ((ret = _mutexgear_completion_queue_trylock(__out_acquired_lock, __queue_instance)) == EBUSY)
+	{
+		_mutexgear_stats_increment(&__queue_instance->stats.contended_locks);
+
+		uint64_t wait_start = _mutexgear_stats_gettime();
+		ret = _mutexgear_completion_queue_lock(__out_acquired_lock, __queue_instance);
+		_mutexgear_stats_addtime(&__queue_instance->stats.total_wait_ns, &__queue_instance->stats.max_wait_ns, wait_start);
+	}
+
+	if (ret == EOK)
+	{
+		_mutexgear_stats_increment(&__queue_instance->stats.locks);
+		__queue_instance->stats.hold_start = _mutexgear_stats_gettime();
+	}
+
+	return ret;
+#else
+	return _mutexgear_completion_queue_lock(__out_acquired_lock, __queue_instance);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void completion_queue_stats_leavelock(mutexgear_completion_queue_t *__queue_instance, bool __wait_requested)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_addtime(&__queue_instance->stats.total_hold_ns, &__queue_instance->stats.max_hold_ns, __queue_instance->stats.hold_start);
+
+	if (__wait_requested)
+	{
+		_mutexgear_stats_increment(&__queue_instance->stats.unlockandwaits);
+	}
+#else
+	MG_DO_NOTHING(__queue_instance);
+	MG_DO_NOTHING(__wait_requested);
+#endif
+}
+
+
 /*_MUTEXGEAR_API */
 int mutexgear_completion_queue_lock(mutexgear_completion_locktoken_t *__out_acquired_lock/*=NULL*/, mutexgear_completion_queue_t *__queue_instance)
 {
-	return _mutexgear_completion_queue_lock(__out_acquired_lock, __queue_instance);
+	return completion_queue_stats_lock(__out_acquired_lock, __queue_instance);
 }
 
 /*_MUTEXGEAR_API */
 int mutexgear_completion_queue_plainunlock(mutexgear_completion_queue_t *__queue_instance)
 {
+	completion_queue_stats_leavelock(__queue_instance, false);
+
 	return _mutexgear_completion_queue_plainunlock(__queue_instance);
 }
 
@@ -425,9 +648,50 @@ int mutexgear_completion_queue_plainunlock(mutexgear_completion_queue_t *__queue
 int mutexgear_completion_queue_unlockandwait(mutexgear_completion_queue_t *__queue_instance,
 	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance)
 {
+	completion_queue_stats_leavelock(__queue_instance, true);
+
 	return _mutexgear_completion_queue_unlockandwait(__queue_instance, __item_to_be_waited, __waiter_instance);
 }
 
+/*_MUTEXGEAR_API */
+int mutexgear_completion_queue_unlockandtimedwait(mutexgear_completion_queue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout)
+{
+	completion_queue_stats_leavelock(__queue_instance, true);
+
+	int ret = _mutexgear_completion_queue_unlockandtimedwait(__queue_instance, __item_to_be_waited, __waiter_instance, _mutexgear_deadline_fromtimespec(__abs_timeout));
+
+	if (ret == ETIMEDOUT)
+	{
+		int mutex_unlock_status;
+		// The internal call returns with the queue locked on expiration
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(__queue_instance)) == EOK); // Should succeed normally
+	}
+
+	return ret;
+}
+
+/*_MUTEXGEAR_API */
+int mutexgear_completion_queue_getstats(mutexgear_completion_queue_t *__queue_instance, mutexgear_completion_queue_stats_t *__out_stats)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	__out_stats->locks = _mutexgear_stats_getvalue(&__queue_instance->stats.locks);
+	__out_stats->contended_locks = _mutexgear_stats_getvalue(&__queue_instance->stats.contended_locks);
+	__out_stats->unlockandwaits = _mutexgear_stats_getvalue(&__queue_instance->stats.unlockandwaits);
+	__out_stats->total_wait_ns = _mutexgear_stats_getvalue(&__queue_instance->stats.total_wait_ns);
+	__out_stats->max_wait_ns = _mutexgear_stats_getvalue(&__queue_instance->stats.max_wait_ns);
+	__out_stats->total_hold_ns = _mutexgear_stats_getvalue(&__queue_instance->stats.total_hold_ns);
+	__out_stats->max_hold_ns = _mutexgear_stats_getvalue(&__queue_instance->stats.max_hold_ns);
+
+	return EOK;
+#else
+	MG_DO_NOTHING(__queue_instance);
+	MG_DO_NOTHING(__out_stats);
+
+	return ENOSYS;
+#endif
+}
+
 
 /*_MUTEXGEAR_API */
 int mutexgear_completion_queue_enqueue(mutexgear_completion_queue_t *__queue_instance, mutexgear_completion_item_t *__item_instance,
@@ -541,6 +805,13 @@ int mutexgear_completion_drainablequeue_unlockandwait(mutexgear_completion_drain
 	return _mutexgear_completion_drainablequeue_unlockandwait(__queue_instance, __item_to_be_waited, __waiter_instance);
 }
 
+/*_MUTEXGEAR_API */
+int mutexgear_completion_drainablequeue_unlockandtimedwait(mutexgear_completion_drainablequeue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, const struct timespec *__abs_timeout)
+{
+	return mutexgear_completion_queue_unlockandtimedwait(&__queue_instance->basic_queue, __item_to_be_waited, __waiter_instance, __abs_timeout);
+}
+
 
 /*_MUTEXGEAR_API */
 int mutexgear_completion_drainablequeue_enqueue(mutexgear_completion_drainablequeue_t *__queue_instance, mutexgear_completion_item_t *__item_instance,
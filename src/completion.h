@@ -45,6 +45,8 @@ _MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_getprioceiling(const mu
 _MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_getprotocol(const mutexgear_completion_genattr_t *__attr, int *__protocol);
 _MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_setprioceiling(mutexgear_completion_genattr_t *__attr, int __prioceiling);
 _MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_setprotocol(mutexgear_completion_genattr_t *__attr, int __protocol);
+_MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_getadaptivespin(const mutexgear_completion_genattr_t *__attr, int *__out_spin_enabled);
+_MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_setadaptivespin(mutexgear_completion_genattr_t *__attr, int __spin_enabled);
 _MUTEXGEAR_PURE_INLINE int _mutexgear_completion_genattr_setmutexattr(mutexgear_completion_genattr_t *__attr, const _MUTEXGEAR_LOCKATTR_T *__mutexattr);
 
 
@@ -110,6 +112,21 @@ int _mutexgear_completion_genattr_setprotocol(mutexgear_completion_genattr_t *__
 }
 
 
+_MUTEXGEAR_PURE_INLINE 
+int _mutexgear_completion_genattr_getadaptivespin(const mutexgear_completion_genattr_t *__attr, int *__out_spin_enabled)
+{
+	int ret = _mutexgear_lockattr_getadaptivespin(&__attr->lock_attr, __out_spin_enabled);
+	return ret;
+}
+
+_MUTEXGEAR_PURE_INLINE 
+int _mutexgear_completion_genattr_setadaptivespin(mutexgear_completion_genattr_t *__attr, int __spin_enabled)
+{
+	int ret = _mutexgear_lockattr_setadaptivespin(&__attr->lock_attr, __spin_enabled);
+	return ret;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 // Completion Queue Types
 
@@ -250,6 +267,9 @@ int _mutexgear_completion_queue_plainunlock(mutexgear_completion_queue_t *__queu
 
 static int _mutexgear_completion_queue_unlockandwait(mutexgear_completion_queue_t *__queue_instance,
 	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance);
+// NOTE: On ETIMEDOUT, the function returns with the queue lock re-acquired and the wait withdrawn
+static int _mutexgear_completion_queue_unlockandtimedwait(mutexgear_completion_queue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, uint64_t __deadline);
 
 
 _MUTEXGEAR_PURE_INLINE
@@ -706,6 +726,14 @@ int _mutexgear_completion_drainablequeue_unlockandwait(mutexgear_completion_drai
 	return ret;
 }
 
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_completion_drainablequeue_unlockandtimedwait(mutexgear_completion_drainablequeue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, uint64_t __deadline)
+{
+	int ret = _mutexgear_completion_queue_unlockandtimedwait(&__queue_instance->basic_queue, __item_to_be_waited, __waiter_instance, __deadline);
+	return ret;
+}
+
 
 _MUTEXGEAR_PURE_INLINE
 bool _mutexgear_completion_drainablequeue_lodisempty(const mutexgear_completion_drainablequeue_t *__queue_instance)
@@ -905,7 +933,7 @@ int _mutexgear_completion_genattr_setmutexattr(mutexgear_completion_genattr_t *_
 
 	do
 	{
-		int prioceiling_value, protocol_value, pshared_value = 0;
+		int prioceiling_value, protocol_value, adaptivespin_value, pshared_value = 0;
 
 		bool pshared_missing = false;
 		if ((ret = _mutexgear_lockattr_getpshared(__mutexattr, &pshared_value)) != EOK)
@@ -934,6 +962,11 @@ int _mutexgear_completion_genattr_setmutexattr(mutexgear_completion_genattr_t *_
 			break;
 		}
 
+		if ((ret = _mutexgear_lockattr_getadaptivespin(__mutexattr, &adaptivespin_value)) != EOK)
+		{
+			break;
+		}
+
 		if (!pshared_missing && (ret = _mutexgear_lockattr_setpshared(&__attr->lock_attr, pshared_value)) != EOK)
 		{
 			break;
@@ -950,6 +983,11 @@ int _mutexgear_completion_genattr_setmutexattr(mutexgear_completion_genattr_t *_
 			break;
 		}
 
+		if ((ret = _mutexgear_lockattr_setadaptivespin(&__attr->lock_attr, adaptivespin_value)) != EOK)
+		{
+			break;
+		}
+
 		MG_ASSERT(ret == EOK);
 	}
 	while (false);
@@ -1117,6 +1155,17 @@ int _mutexgear_completion_queue_init(mutexgear_completion_queue_t *__queue_insta
 
 		mutexgear_dlralist_init(&__queue_instance->work_list);
 
+#if defined(_MUTEXGEAR_WITH_STATS)
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.locks), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.contended_locks), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.unlockandwaits), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.total_wait_ns), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.max_wait_ns), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.total_hold_ns), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.max_hold_ns), 0);
+		__queue_instance->stats.hold_start = 0;
+#endif
+
 		MG_ASSERT(ret == EOK);
 
 		success = true;
@@ -1212,6 +1261,16 @@ void _mutexgear_completion_queue_completedestroy(mutexgear_completion_queue_t *_
 	MG_CHECK(list_emptiness_check, mutexgear_dlralist_isempty(&__queue_instance->work_list) || (list_emptiness_check = EBUSY, false));
 
 	mutexgear_dlralist_destroy(&__queue_instance->work_list);
+
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.locks));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.contended_locks));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.unlockandwaits));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.total_wait_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.max_wait_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.total_hold_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__queue_instance->stats.max_hold_ns));
+#endif
 }
 
 /*_MUTEXGEAR_PURE_INLINE */
@@ -1334,6 +1393,118 @@ void _mutexgear_completion_wait_item_completion_and_detach(mutexgear_completion_
 }
 
 
+static bool _mutexgear_completion_timedwait_item_completion(mutexgear_completion_item_t *__item_to_be_waited,
+	mutexgear_completion_worker_t *__worker_instance, uint64_t __deadline);
+
+/*static */
+int _mutexgear_completion_queue_unlockandtimedwait(mutexgear_completion_queue_t *__queue_instance,
+	mutexgear_completion_item_t *__item_to_be_waited, mutexgear_completion_waiter_t *__waiter_instance, uint64_t __deadline)
+{
+	int ret, wait_detach_lock_status, mutex_lock_status, mutex_unlock_status;
+
+	do
+	{
+		if (__deadline == _MUTEXGEAR_DEADLINE_INFINITE)
+		{
+			ret = _mutexgear_completion_queue_unlockandwait(__queue_instance, __item_to_be_waited, __waiter_instance);
+			break;
+		}
+
+		mutexgear_completion_worker_t *worker_instance = (mutexgear_completion_worker_t *)_mutexgear_completion_item_getwow(__item_to_be_waited);
+
+		if ((void *)worker_instance != (void *)__item_to_be_waited) // != NULL
+		{
+			wait_detach_lock_status = _mutexgear_lock_acquire(&__waiter_instance->wait_detach_lock);
+
+			if (wait_detach_lock_status == EOK)
+			{
+				_mutexgear_completion_item_setwow(__item_to_be_waited, __waiter_instance);
+			}
+		}
+
+		// Due to the function contract, the mutex must be unlocked regardless of the return status (except for the timeout)
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__queue_instance->access_lock)) == EOK);
+
+		if ((void *)worker_instance == (void *)__item_to_be_waited) // == NULL
+		{
+			ret = ESRCH;
+			break;
+		}
+
+		if (wait_detach_lock_status != EOK)
+		{
+			ret = wait_detach_lock_status;
+			break;
+		}
+
+		if (!_mutexgear_completion_timedwait_item_completion(__item_to_be_waited, worker_instance, __deadline))
+		{
+			// The worker only accesses the waiter pointer after it has unlinked the item with the queue lock held.
+			// Hence, if the item is still linked, the wait can be withdrawn by restoring the worker pointer.
+			MG_CHECK(mutex_lock_status, (mutex_lock_status = _mutexgear_lock_acquire(&__queue_instance->access_lock)) == EOK); // No way to handle -- must succeed
+
+			if (mutexgear_dlraitem_islinked(&__item_to_be_waited->data.work_item))
+			{
+				_mutexgear_completion_item_setwow(__item_to_be_waited, worker_instance);
+
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__waiter_instance->wait_detach_lock)) == EOK); // No way to handle -- must succeed
+
+				// The queue lock is returned acquired to let the caller revert any item state related to the wait
+				ret = ETIMEDOUT;
+				break;
+			}
+
+			// Otherwise, the worker has already got the waiter pointer and the completion is imminent -- finish the wait in full
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__queue_instance->access_lock)) == EOK); // Should succeed normally
+		}
+
+		_mutexgear_completion_wait_item_completion_and_detach(__queue_instance, __item_to_be_waited, __waiter_instance, worker_instance);
+
+		ret = EOK;
+	}
+	while (false);
+
+	return ret;
+}
+
+static
+bool _mutexgear_completion_timedwait_item_completion(mutexgear_completion_item_t *__item_to_be_waited,
+	mutexgear_completion_worker_t *__worker_instance, uint64_t __deadline)
+{
+	int wheel_grip_status, wheel_turn_status, wheel_release_status;
+
+	bool completed = true, enter_loop = false, continue_loop;
+
+	// Check if the worker has not marked the item as completed yet...
+	if (_mutexgear_completion_item_getwow(__item_to_be_waited) != (void *)__item_to_be_waited) // != NULL
+	{
+		// ... grip on to the wheel if not
+		MG_CHECK(wheel_grip_status, (wheel_grip_status = _mutexgear_wheel_gripon(&__worker_instance->progress_wheel)) == EOK); // No way to handle -- must succeed
+		enter_loop = true;
+	}
+
+	// Continue turning the wheel until the worker marks the item as complete or the deadline is reached
+	for (continue_loop = enter_loop && _mutexgear_completion_item_getwow(__item_to_be_waited) != (void *)__item_to_be_waited/* != NULL*/;
+		continue_loop; continue_loop = _mutexgear_completion_item_getwow(__item_to_be_waited) != (void *)__item_to_be_waited/* != NULL*/)
+	{
+		if ((wheel_turn_status = _mutexgear_wheel_timedturn(&__worker_instance->progress_wheel, __deadline)) != EOK)
+		{
+			MG_CHECK(wheel_turn_status, wheel_turn_status == ETIMEDOUT); // No way to handle -- must succeed or time out
+			completed = false;
+			break;
+		}
+	}
+
+	// Release the wheel if it was gripped on to (the wheel is released before any completion-and-detach call re-grips it)
+	if (enter_loop)
+	{
+		MG_CHECK(wheel_release_status, (wheel_release_status = _mutexgear_wheel_release(&__worker_instance->progress_wheel)) == EOK); // No way to handle -- must succeed
+	}
+
+	return completed;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 // Completion DrainableQueue Implementation
 
@@ -23,6 +23,11 @@
 */
 
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For PTHREAD_MUTEX_ADAPTIVE_NP
+#endif
+
+
 #include <mutexgear/maintlock.h>
 
 #include "completion.h"
@@ -39,6 +44,116 @@
 #define _MUTEXGEAR_MAINTLOCK_MODE__ALLOWED_FLAGS			(_MUTEXGEAR_MAINTLOCK_MODE_PSHARED)
 
 
+//////////////////////////////////////////////////////////////////////////
+// MaintLock Statistics Helpers
+
+// The helpers compile into nothing unless the statistics collection is enabled
+
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_construct(mutexgear_maintlock_t *__maintlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.reads), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.busy_reads), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.maintenances), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.waits), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.unlockandwaits), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.total_wait_ns), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.max_wait_ns), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.total_hold_ns), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.max_hold_ns), 0);
+	__maintlock->stats.hold_start = 0;
+#else
+	MG_DO_NOTHING(__maintlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_destroy(mutexgear_maintlock_t *__maintlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.reads));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.busy_reads));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.maintenances));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.waits));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.unlockandwaits));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.total_wait_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.max_wait_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.total_hold_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->stats.max_hold_ns));
+#else
+	MG_DO_NOTHING(__maintlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_countread(mutexgear_maintlock_t *__maintlock, bool __read_acquired)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(__read_acquired ? &__maintlock->stats.reads : &__maintlock->stats.busy_reads);
+#else
+	MG_DO_NOTHING(__maintlock);
+	MG_DO_NOTHING(__read_acquired);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_countunlockandwait(mutexgear_maintlock_t *__maintlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(&__maintlock->stats.unlockandwaits);
+#else
+	MG_DO_NOTHING(__maintlock);
+#endif
+}
+
+// Returns the wait start time to be passed into maintlock_stats_endwait()
+_MUTEXGEAR_PURE_INLINE
+uint64_t maintlock_stats_beginwait(mutexgear_maintlock_t *__maintlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(&__maintlock->stats.waits);
+	return _mutexgear_stats_gettime();
+#else
+	MG_DO_NOTHING(__maintlock);
+	return 0;
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_endwait(mutexgear_maintlock_t *__maintlock, uint64_t __wait_start)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_addtime(&__maintlock->stats.total_wait_ns, &__maintlock->stats.max_wait_ns, __wait_start);
+#else
+	MG_DO_NOTHING(__maintlock);
+	MG_DO_NOTHING(__wait_start);
+#endif
+}
+
+// The maintenance mode is only set and cleared by its owner, so the start time needs no atomic access
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_beginmaintenance(mutexgear_maintlock_t *__maintlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(&__maintlock->stats.maintenances);
+	__maintlock->stats.hold_start = _mutexgear_stats_gettime();
+#else
+	MG_DO_NOTHING(__maintlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void maintlock_stats_endmaintenance(mutexgear_maintlock_t *__maintlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_addtime(&__maintlock->stats.total_hold_ns, &__maintlock->stats.max_hold_ns, __maintlock->stats.hold_start);
+#else
+	MG_DO_NOTHING(__maintlock);
+#endif
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 // MaintLock Attributes Implementation
 
@@ -107,6 +222,20 @@ int mutexgear_maintlockattr_setprotocol(mutexgear_maintlockattr_t *__attr, int _
 	return ret;
 }
 
+/*extern */
+int mutexgear_maintlockattr_getadaptivespin(const mutexgear_maintlockattr_t *__attr, int *__out_spin_enabled)
+{
+	int ret = _mutexgear_lockattr_getadaptivespin(&__attr->lock_attr, __out_spin_enabled);
+	return ret;
+}
+
+/*extern */
+int mutexgear_maintlockattr_setadaptivespin(mutexgear_maintlockattr_t *__attr, int __spin_enabled)
+{
+	int ret = _mutexgear_lockattr_setadaptivespin(&__attr->lock_attr, __spin_enabled);
+	return ret;
+}
+
 /*extern */
 int mutexgear_maintlockattr_setmutexattr(mutexgear_maintlockattr_t *__attr, const _MUTEXGEAR_LOCKATTR_T *__mutexattr)
 {
@@ -114,7 +243,7 @@ int mutexgear_maintlockattr_setmutexattr(mutexgear_maintlockattr_t *__attr, cons
 
 	do
 	{
-		int prioceiling_value, protocol_value, pshared_value = 0;
+		int prioceiling_value, protocol_value, adaptivespin_value, pshared_value = 0;
 
 		bool pshared_missing = false;
 		if ((ret = _mutexgear_lockattr_getpshared(__mutexattr, &pshared_value)) != EOK)
@@ -143,6 +272,11 @@ int mutexgear_maintlockattr_setmutexattr(mutexgear_maintlockattr_t *__attr, cons
 			break;
 		}
 
+		if ((ret = _mutexgear_lockattr_getadaptivespin(__mutexattr, &adaptivespin_value)) != EOK)
+		{
+			break;
+		}
+
 		if (!pshared_missing && (ret = _mutexgear_lockattr_setpshared(&__attr->lock_attr, pshared_value)) != EOK)
 		{
 			break;
@@ -159,6 +293,11 @@ int mutexgear_maintlockattr_setmutexattr(mutexgear_maintlockattr_t *__attr, cons
 			break;
 		}
 
+		if ((ret = _mutexgear_lockattr_setadaptivespin(&__attr->lock_attr, adaptivespin_value)) != EOK)
+		{
+			break;
+		}
+
 		MG_ASSERT(ret == EOK);
 	}
 	while (false);
@@ -232,6 +371,7 @@ int _mutexgear_maintlock_init(mutexgear_maintlock_t *__maintlock, mutexgear_main
 		}
 
 		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->fl_un.mode_and_lock_flags), mode_flags);
+		maintlock_stats_construct(__maintlock);
 
 		success = true;
 	}
@@ -309,6 +449,7 @@ int _mutexgear_maintlock_destroy(mutexgear_maintlock_t *__maintlock)
 		_mutexgear_completion_queue_completedestroy(&__maintlock->awaited_reads);
 		_mutexgear_completion_drainablequeue_completedestroy(&__maintlock->acquired_reads);
 		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__maintlock->fl_un.mode_and_lock_flags));
+		maintlock_stats_destroy(__maintlock);
 
 		success = true;
 	}
@@ -379,6 +520,8 @@ int _mutexgear_maintlock_set_maintenance(mutexgear_maintlock_t *__maintlock)
 			break;
 		}
 
+		maintlock_stats_beginmaintenance(__maintlock);
+
 		success = true;
 	}
 	while (false);
@@ -404,6 +547,8 @@ int _mutexgear_maintlock_clear_maintenance(mutexgear_maintlock_t *__maintlock)
 
 		if ((mode_and_lock_flags & _MUTEXGEAR_MAINTLOCK_LOCKED_FOR_UPDATE) != 0)
 		{
+			maintlock_stats_endmaintenance(__maintlock);
+
 			// WARNING! No protection here and the regular 'and' neoperation eds to be used rather than the unsafe one!
 			_mg_atomic_and_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__maintlock->fl_un.mode_and_lock_flags), ~(ptrdiff_t)_MUTEXGEAR_MAINTLOCK_LOCKED_FOR_UPDATE);
 		}
@@ -468,6 +613,8 @@ int _mutexgear_maintlock_tryrdlock(mutexgear_maintlock_t *__maintlock,
 
 		if ((preliminary_mode_and_lock_flags & _MUTEXGEAR_MAINTLOCK_LOCKED_FOR_UPDATE) != 0)
 		{
+			maintlock_stats_countread(__maintlock, false);
+
 			ret = EBUSY;
 			break;
 		}
@@ -488,6 +635,8 @@ int _mutexgear_maintlock_tryrdlock(mutexgear_maintlock_t *__maintlock,
 
 		if ((locked_mode_and_lock_flags & _MUTEXGEAR_MAINTLOCK_LOCKED_FOR_UPDATE) != 0)
 		{
+			maintlock_stats_countread(__maintlock, false);
+
 			ret = EBUSY;
 			break;
 		}
@@ -498,6 +647,8 @@ int _mutexgear_maintlock_tryrdlock(mutexgear_maintlock_t *__maintlock,
 
 		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_drainablequeue_plainunlock(&__maintlock->acquired_reads)) == EOK); // Should succeed normally
 
+		maintlock_stats_countread(__maintlock, true);
+
 		success = true;
 	}
 	while (false);
@@ -600,22 +751,29 @@ int _mutexgear_maintlock_rdunlock(mutexgear_maintlock_t *__maintlock,
 
 
 static int _mutexgear_maintlock_wait_rdunlock(mutexgear_maintlock_t *__maintlock,
-	mutexgear_completion_waiter_t *__waiter);
+	mutexgear_completion_waiter_t *__waiter, uint64_t __deadline);
 
 /*extern */
 int mutexgear_maintlock_wait_rdunlock(mutexgear_maintlock_t *__maintlock,
 	mutexgear_completion_waiter_t *__waiter)
 {
-	return _mutexgear_maintlock_wait_rdunlock(__maintlock, __waiter);
+	return _mutexgear_maintlock_wait_rdunlock(__maintlock, __waiter, _MUTEXGEAR_DEADLINE_INFINITE);
+}
+
+/*extern */
+int mutexgear_maintlock_timedwait_rdunlock(mutexgear_maintlock_t *__maintlock,
+	mutexgear_completion_waiter_t *__waiter, const struct timespec *__abs_timeout)
+{
+	return _mutexgear_maintlock_wait_rdunlock(__maintlock, __waiter, _mutexgear_deadline_fromtimespec(__abs_timeout));
 }
 
 
 static bool maintlock_process_and_unlock_awaited_reads_queue(mutexgear_maintlock_t *__maintlock,
-	mutexgear_completion_waiter_t *__waiter, int *__out_status);
+	mutexgear_completion_waiter_t *__waiter, uint64_t __deadline, int *__out_status);
 
 static 
 int _mutexgear_maintlock_wait_rdunlock(mutexgear_maintlock_t *__maintlock,
-	mutexgear_completion_waiter_t *__waiter)
+	mutexgear_completion_waiter_t *__waiter, uint64_t __deadline)
 {
 	bool success = false;
 	int ret, mutex_unlock_status;
@@ -667,7 +825,11 @@ int _mutexgear_maintlock_wait_rdunlock(mutexgear_maintlock_t *__maintlock,
 
 		if (any_reads)
 		{
-			if (!maintlock_process_and_unlock_awaited_reads_queue(__maintlock, __waiter, &ret))
+			uint64_t wait_start = maintlock_stats_beginwait(__maintlock);
+			bool reads_processed = maintlock_process_and_unlock_awaited_reads_queue(__maintlock, __waiter, __deadline, &ret);
+			maintlock_stats_endwait(__maintlock, wait_start);
+
+			if (!reads_processed)
 			{
 				awaiteds_locked = false; // by protocol, the queue is to be unlocked even in case of of a failure
 				break;
@@ -714,7 +876,7 @@ int _mutexgear_maintlock_wait_rdunlock(mutexgear_maintlock_t *__maintlock,
 
 static 
 bool maintlock_process_and_unlock_awaited_reads_queue(mutexgear_maintlock_t *__maintlock, 
-	mutexgear_completion_waiter_t *__waiter, int *__out_status)
+	mutexgear_completion_waiter_t *__waiter, uint64_t __deadline, int *__out_status)
 {
 	MG_ASSERT(!_mutexgear_completion_queue_lodisempty(&__maintlock->awaited_reads));
 
@@ -724,8 +886,16 @@ bool maintlock_process_and_unlock_awaited_reads_queue(mutexgear_maintlock_t *__m
 	mutexgear_completion_item_t *head_item = _mutexgear_completion_queue_unsafegetunsafehead(&__maintlock->awaited_reads);
 	for (; ; )
 	{
-		if ((ret = _mutexgear_completion_queue_unlockandwait(&__maintlock->awaited_reads, head_item, __waiter)) != EOK)
+		maintlock_stats_countunlockandwait(__maintlock);
+
+		if ((ret = _mutexgear_completion_queue_unlockandtimedwait(&__maintlock->awaited_reads, head_item, __waiter, __deadline)) != EOK)
 		{
+			if (ret == ETIMEDOUT)
+			{
+				// The wait has been withdrawn with the queue left locked. The remaining items stay in awaited_reads to be waited by the next call.
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__maintlock->awaited_reads)) == EOK); // Should succeed normally
+			}
+
 			fault = true;
 			break;
 		}
@@ -754,4 +924,28 @@ bool maintlock_process_and_unlock_awaited_reads_queue(mutexgear_maintlock_t *__m
 }
 
 
+/*extern */
+int mutexgear_maintlock_getstats(mutexgear_maintlock_t *__maintlock, mutexgear_maintlock_stats_t *__out_stats)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	__out_stats->reads = _mutexgear_stats_getvalue(&__maintlock->stats.reads);
+	__out_stats->busy_reads = _mutexgear_stats_getvalue(&__maintlock->stats.busy_reads);
+	__out_stats->maintenances = _mutexgear_stats_getvalue(&__maintlock->stats.maintenances);
+	__out_stats->waits = _mutexgear_stats_getvalue(&__maintlock->stats.waits);
+	__out_stats->unlockandwaits = _mutexgear_stats_getvalue(&__maintlock->stats.unlockandwaits);
+	__out_stats->total_wait_ns = _mutexgear_stats_getvalue(&__maintlock->stats.total_wait_ns);
+	__out_stats->max_wait_ns = _mutexgear_stats_getvalue(&__maintlock->stats.max_wait_ns);
+	__out_stats->total_hold_ns = _mutexgear_stats_getvalue(&__maintlock->stats.total_hold_ns);
+	__out_stats->max_hold_ns = _mutexgear_stats_getvalue(&__maintlock->stats.max_hold_ns);
+
+	return EOK;
+#else
+	MG_DO_NOTHING(__maintlock);
+	MG_DO_NOTHING(__out_stats);
+
+	return ENOSYS;
+#endif
+}
+
+
 //////////////////////////////////////////////////////////////////////////
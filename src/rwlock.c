@@ -23,6 +23,11 @@
 */
 
 
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For sched_getcpu() and PTHREAD_MUTEX_ADAPTIVE_NP
+#endif
+
+
 #include <mutexgear/rwlock.h>
 
 #if defined(MUTEXGEAR_USE_C11_GENERICS)
@@ -31,11 +36,24 @@
 #undef mutexgear_rwlock_destroy
 #undef mutexgear_rwlock_wrlock
 #undef mutexgear_rwlock_wrlock_cwp
+#undef mutexgear_rwlock_wrlock_twp
+#undef mutexgear_rwlock_wrlock_pri
+#undef mutexgear_rwlock_timedwrlock
 #undef mutexgear_rwlock_trywrlock
 #undef mutexgear_rwlock_wrunlock
 #undef mutexgear_rwlock_rdlock
+#undef mutexgear_rwlock_timedrdlock
 #undef mutexgear_rwlock_tryrdlock
 #undef mutexgear_rwlock_rdunlock
+#undef mutexgear_rwlock_wrdowngrade
+#undef mutexgear_rwlock_uprdlock
+#undef mutexgear_rwlock_uprdunlock
+#undef mutexgear_rwlock_rdupgrade
+#undef mutexgear_rwlock_wrexecute
+#undef mutexgear_rwlock_optread_begin
+#undef mutexgear_rwlock_optread_validate
+#undef mutexgear_rwlock_getstate
+#undef mutexgear_rwlock_getstats
 
 
 #endif // #if defined(MUTEXGEAR_USE_C11_GENERICS)
@@ -45,23 +63,78 @@
 #include "dlralist.h"
 #include "utility.h"
 
+#include <stdlib.h>
+
+#if !defined(_WIN32) && defined(_MUTEXGEAR_HAVE_SCHED_GETCPU)
+#include <sched.h>
+#endif
+
 
 // A macro to derive mutexgear_rwlock_t::reader_push_locks array index from waiter pointer
 #define _MUTEXGEAR_RWLOCK_MAKE_READER_PUSH_SELECTOR(Pointer) ((uintptr_t)(Pointer) / (size_t)_MUTEXGEAR_RWLOCK_READERPUSHSELECTOR_FACTOR)
-#define _MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(RWLock, Selector) ((RWLock)->reader_push_locks[(_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT - 1) - (Selector)])
+// The inline locks are accessed from the array end to keep the used ones closer to the subsequent fields
+#define _MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(RWLock, Selector) (*(_MUTEXGEAR_RWLOCK_ARE_READER_PUSH_LOCKS_INLINE((RWLock)->fl_un.mode_flags) \
+	? &(RWLock)->reader_push_locks.inline_locks[(_MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT - 1) - (Selector)] \
+	: &(RWLock)->reader_push_locks.allocated_locks[Selector]))
+#define _MUTEXGEAR_RWLOCK_ARE_READER_PUSH_LOCKS_INLINE(ModeFlags) ((((ModeFlags) >> _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) < _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT)
+
+// A single express read stripe is stored inline, bigger counts are allocated from the heap
+#define _MUTEXGEAR_RWLOCK_ACCESS_EXPRESS_READS(RWLock, StripeIndex) (*(_MUTEXGEAR_RWLOCK_ARE_EXPRESS_READS_INLINE((RWLock)->fl_un.mode_flags) \
+	? &(RWLock)->express_reads.inline_reads \
+	: &(RWLock)->express_reads.allocated_stripes[StripeIndex].express_reads))
+#define _MUTEXGEAR_RWLOCK_ARE_EXPRESS_READS_INLINE(ModeFlags) ((((ModeFlags) >> _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK) == 0)
 
 // Use a whole byte for the mask as that allows compiler to generate a byte memory access instead of masking
 #define _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK		0x00FF
 #define _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT	0
 
 #define _MUTEXGEAR_RWLOCK_MODE_PSHARED					0x0100
+#define _MUTEXGEAR_RWLOCK_MODE_NOFASTPATH				0x0200
+#define _MUTEXGEAR_RWLOCK_MODE_UPGRADABLE				0x0400
+#define _MUTEXGEAR_RWLOCK_MODE_HANDOFF					0x0800
+#define _MUTEXGEAR_RWLOCK_MODE_READERBIAS				0x1000
 
-#define _MUTEXGEAR_RWLOCK_MODE__ALLOWED_FLAGS			(_MUTEXGEAR_RWLOCK_MODE_PSHARED | ((_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT - 1) << _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT))
+#define _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK		0x00FF
+#define _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT		16
+
+#define _MUTEXGEAR_RWLOCK_MODE__ALLOWED_FLAGS			(_MUTEXGEAR_RWLOCK_MODE_PSHARED | _MUTEXGEAR_RWLOCK_MODE_NOFASTPATH | _MUTEXGEAR_RWLOCK_MODE_UPGRADABLE | _MUTEXGEAR_RWLOCK_MODE_HANDOFF | _MUTEXGEAR_RWLOCK_MODE_READERBIAS | ((_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT - 1) << _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT) \
+	| ((_MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT - 1) << _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT))
 MG_STATIC_ASSERT((((_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT - 1) | _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK)) == _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK);
+MG_STATIC_ASSERT((_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT & (_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT - 1)) == 0);
+MG_STATIC_ASSERT(_MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT <= _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT);
+MG_STATIC_ASSERT((((_MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT - 1) | _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK)) == _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK);
+MG_STATIC_ASSERT((_MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT & (_MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT - 1)) == 0);
+MG_STATIC_ASSERT(sizeof(_mutexgear_rwlock_expressreadstripe_t) >= _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_SIZE);
 
 
 #define _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY		EOK // A special status to indicate that all items are busy -- must not match any error codes that may appear naturally
 
+// The fastpath_state values: zero for a free object, a multiple of _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT for the number of threads within the queue based implementation,
+// or an offset of the owner's worker/item from the rwlock tagged with the owner kind (offsets are used instead of pointers to remain valid in process shared memory)
+#define _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK			0x03
+#define _MUTEXGEAR_RWLOCK_FASTPATH_WRITER				0x01
+#define _MUTEXGEAR_RWLOCK_FASTPATH_READER				0x02
+#define _MUTEXGEAR_RWLOCK_FASTPATH_WAITED				0x02 // Combined with _MUTEXGEAR_RWLOCK_FASTPATH_WRITER only
+#define _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT				0x04
+MG_STATIC_ASSERT(_MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT == _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK + 1);
+
+// The adaptivewp_score is a running average of the share of adaptive writers that found other adaptive writers waiting on arrival 
+// scaled to _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SCORE_MAX; each new arrival contributes 1/(2^_MUTEXGEAR_RWLOCK_ADAPTIVEWP_AVERAGING_SHIFT) into the average
+#define _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SCORE_MAX			256
+#define _MUTEXGEAR_RWLOCK_ADAPTIVEWP_AVERAGING_SHIFT	4
+#define _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SELECTOR_SHIFT		5
+
+// The writers with a time based priority count reader releases "infinitely" and claim the priority at the first reader release after the deadline instead.
+// The "no deadline" value is used for the writers with the priority based on reader release count only.
+#define _MUTEXGEAR_RWLOCK_TIMEDWP_READERS_TILL_WP		INT_MAX
+#define _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE				UINT64_MAX
+
+// The visible readers table is shared by all the objects with the reader bias mode. Each slot holds the address of the object read-locked 
+// by the reader published there, or zero. After a revocation, the bias is inhibited for the revocation duration multiplied by the constant.
+#define _MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT_BITS		12
+#define _MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT			(1U << _MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT_BITS)
+#define _MUTEXGEAR_RWLOCK_READERBIAS_INHIBIT_MULTIPLIER	9
+
 
 //////////////////////////////////////////////////////////////////////////
 // RWLock Attributes Implementation
@@ -131,6 +204,20 @@ int mutexgear_rwlockattr_setprotocol(mutexgear_rwlockattr_t *__attr, int __proto
 	return ret;
 }
 
+/*extern */
+int mutexgear_rwlockattr_getadaptivespin(const mutexgear_rwlockattr_t *__attr, int *__out_spin_enabled)
+{
+	int ret = _mutexgear_lockattr_getadaptivespin(&__attr->lock_attr, __out_spin_enabled);
+	return ret;
+}
+
+/*extern */
+int mutexgear_rwlockattr_setadaptivespin(mutexgear_rwlockattr_t *__attr, int __spin_enabled)
+{
+	int ret = _mutexgear_lockattr_setadaptivespin(&__attr->lock_attr, __spin_enabled);
+	return ret;
+}
+
 /*extern */
 int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__attr, const _MUTEXGEAR_LOCKATTR_T *__mutexattr)
 {
@@ -138,7 +225,7 @@ int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__attr, const _MUT
 
 	do
 	{
-		int prioceiling_value, protocol_value, pshared_value = 0;
+		int prioceiling_value, protocol_value, adaptivespin_value, pshared_value = 0;
 
 		bool pshared_missing = false;
 		if ((ret = _mutexgear_lockattr_getpshared(__mutexattr, &pshared_value)) != EOK)
@@ -167,6 +254,11 @@ int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__attr, const _MUT
 			break;
 		}
 
+		if ((ret = _mutexgear_lockattr_getadaptivespin(__mutexattr, &adaptivespin_value)) != EOK)
+		{
+			break;
+		}
+
 		if (!pshared_missing && (ret = _mutexgear_lockattr_setpshared(&__attr->lock_attr, pshared_value)) != EOK)
 		{
 			break;
@@ -183,6 +275,11 @@ int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__attr, const _MUT
 			break;
 		}
 
+		if ((ret = _mutexgear_lockattr_setadaptivespin(&__attr->lock_attr, adaptivespin_value)) != EOK)
+		{
+			break;
+		}
+
 		MG_ASSERT(ret == EOK);
 	}
 	while (false);
@@ -194,10 +291,8 @@ int mutexgear_rwlockattr_setmutexattr(mutexgear_rwlockattr_t *__attr, const _MUT
 /*extern */
 int mutexgear_rwlockattr_setwritechannels(mutexgear_rwlockattr_t *__attr, unsigned int __channel_count)
 {
-	unsigned int channel_count = __channel_count <= 1 ? 1
-		: __channel_count <= 2 ? 2
-		: 4;
-	MG_STATIC_ASSERT(_MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT == 4);
+	unsigned int channel_count;
+	for (channel_count = 1; channel_count < __channel_count && channel_count != _MUTEXGEAR_RWLOCK_READERPUSHLOCK_MAXCOUNT; channel_count *= 2) {}
 
 	__attr->mode_flags = (__attr->mode_flags & ~(_MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK << _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT))
 		| ((channel_count - 1) << _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT);
@@ -215,6 +310,88 @@ int mutexgear_rwlockattr_getwritechannels(mutexgear_rwlockattr_t *__attr, unsign
 }
 
 
+/*extern */
+int mutexgear_rwlockattr_setfastpath(mutexgear_rwlockattr_t *__attr, int __fastpath_enabled)
+{
+	__attr->mode_flags = __fastpath_enabled != 0 ? __attr->mode_flags & ~_MUTEXGEAR_RWLOCK_MODE_NOFASTPATH : __attr->mode_flags | _MUTEXGEAR_RWLOCK_MODE_NOFASTPATH;
+	return EOK;
+}
+
+/*extern */
+int mutexgear_rwlockattr_getfastpath(const mutexgear_rwlockattr_t *__attr, int *__out_fastpath_enabled)
+{
+	*__out_fastpath_enabled = (__attr->mode_flags & _MUTEXGEAR_RWLOCK_MODE_NOFASTPATH) == 0;
+	return EOK;
+}
+
+
+/*extern */
+int mutexgear_rwlockattr_setupgradable(mutexgear_rwlockattr_t *__attr, int __upgradable_enabled)
+{
+	__attr->mode_flags = __upgradable_enabled != 0 ? __attr->mode_flags | _MUTEXGEAR_RWLOCK_MODE_UPGRADABLE : __attr->mode_flags & ~_MUTEXGEAR_RWLOCK_MODE_UPGRADABLE;
+	return EOK;
+}
+
+/*extern */
+int mutexgear_rwlockattr_getupgradable(const mutexgear_rwlockattr_t *__attr, int *__out_upgradable_enabled)
+{
+	*__out_upgradable_enabled = (__attr->mode_flags & _MUTEXGEAR_RWLOCK_MODE_UPGRADABLE) != 0;
+	return EOK;
+}
+
+
+/*extern */
+int mutexgear_rwlockattr_sethandoff(mutexgear_rwlockattr_t *__attr, int __handoff_enabled)
+{
+	__attr->mode_flags = __handoff_enabled != 0 ? __attr->mode_flags | _MUTEXGEAR_RWLOCK_MODE_HANDOFF : __attr->mode_flags & ~_MUTEXGEAR_RWLOCK_MODE_HANDOFF;
+	return EOK;
+}
+
+/*extern */
+int mutexgear_rwlockattr_gethandoff(const mutexgear_rwlockattr_t *__attr, int *__out_handoff_enabled)
+{
+	*__out_handoff_enabled = (__attr->mode_flags & _MUTEXGEAR_RWLOCK_MODE_HANDOFF) != 0;
+	return EOK;
+}
+
+
+/*extern */
+int mutexgear_rwlockattr_setreaderbias(mutexgear_rwlockattr_t *__attr, int __readerbias_enabled)
+{
+	__attr->mode_flags = __readerbias_enabled != 0 ? __attr->mode_flags | _MUTEXGEAR_RWLOCK_MODE_READERBIAS : __attr->mode_flags & ~_MUTEXGEAR_RWLOCK_MODE_READERBIAS;
+	return EOK;
+}
+
+/*extern */
+int mutexgear_rwlockattr_getreaderbias(const mutexgear_rwlockattr_t *__attr, int *__out_readerbias_enabled)
+{
+	*__out_readerbias_enabled = (__attr->mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERBIAS) != 0;
+	return EOK;
+}
+
+
+/*extern */
+int mutexgear_rwlockattr_setreadstripes(mutexgear_rwlockattr_t *__attr, unsigned int __stripe_count)
+{
+	unsigned int stripe_count;
+	for (stripe_count = 1; stripe_count < __stripe_count && stripe_count != _MUTEXGEAR_RWLOCK_EXPRESSREADSTRIPE_MAXCOUNT; stripe_count *= 2) {}
+
+	__attr->mode_flags = (__attr->mode_flags & ~(_MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK << _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT))
+		| ((stripe_count - 1) << _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT);
+	MG_ASSERT(((stripe_count - 1) | _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK) == _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK);
+
+	return EOK;
+}
+
+/*extern */
+int mutexgear_rwlockattr_getreadstripes(const mutexgear_rwlockattr_t *__attr, unsigned int *__out_stripe_count)
+{
+	unsigned stripe_mask = (__attr->mode_flags >> _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK;
+	*__out_stripe_count = stripe_mask + 1;
+	return EOK;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 // RWLock Implementation
 
@@ -222,9 +399,23 @@ typedef enum _rwlock_rdlock_item_tag
 {
 	rdlock_itemtag_beingwaited,
 	rdlock_itemtag_trylocked,
+	rdlock_itemtag_readerbiased, // The reader is published in the visible readers table
 
 } rwlock_rdlock_item_tag_t;
 
+typedef enum _rwlock_wrlock_item_tag
+{
+	wrlock_itemtag__class_min = rdlock_itemtag_readerbiased + 1, // The writer class bits of an item queued into waiting_writes (zero for the normal class)
+	wrlock_itemtag__class_max = wrlock_itemtag__class_min + 2,
+
+} rwlock_wrlock_item_tag_t;
+
+MG_STATIC_ASSERT(MUTEXGEAR_RWLOCK_WRITERCLASS_MAX < 1U << (wrlock_itemtag__class_max - wrlock_itemtag__class_min));
+MG_STATIC_ASSERT(wrlock_itemtag__class_max <= MUTEXGEAR_COMPLETION_ITEM_TAGINDEX_COUNT);
+
+
+static ptrdiff_t g_rwlock_readerbias_slots[_MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT];
+
 
 _MUTEXGEAR_PURE_INLINE
 mutexgear_completion_item_t *_mutexgear_rtdl_rwlock_getseparator(const mutexgear_trdl_rwlock_t *__rwlock_instance)
@@ -234,6 +425,176 @@ mutexgear_completion_item_t *_mutexgear_rtdl_rwlock_getseparator(const mutexgear
 }
 
 
+// The statistics helpers compile into nothing unless the statistics collection is enabled
+
+typedef enum _rwlock_stats_read_kind
+{
+	rwlock_statsread_fastpath,
+	rwlock_statsread_express,
+	rwlock_statsread_slow,
+
+} rwlock_stats_read_kind_t;
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_construct(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.fastpath_reads), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.express_reads), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.slow_reads), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.writes), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.writer_priority_claims), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.reader_push_lock_waits), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.unlockandwaits), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.total_wait_ns), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.max_wait_ns), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.total_hold_ns), 0);
+	_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.max_hold_ns), 0);
+	__rwlock->stats.hold_start = 0;
+#else
+	MG_DO_NOTHING(__rwlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_destroy(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.fastpath_reads));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.express_reads));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.slow_reads));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.writes));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.writer_priority_claims));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.reader_push_lock_waits));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.unlockandwaits));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.total_wait_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.max_wait_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.total_hold_ns));
+	_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->stats.max_hold_ns));
+#else
+	MG_DO_NOTHING(__rwlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_countread(mutexgear_rwlock_t *__rwlock, rwlock_stats_read_kind_t __read_kind)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(__read_kind == rwlock_statsread_fastpath ? &__rwlock->stats.fastpath_reads 
+		: __read_kind == rwlock_statsread_express ? &__rwlock->stats.express_reads : &__rwlock->stats.slow_reads);
+#else
+	MG_DO_NOTHING(__rwlock);
+	MG_DO_NOTHING(__read_kind);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_countwpclaim(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(&__rwlock->stats.writer_priority_claims);
+#else
+	MG_DO_NOTHING(__rwlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_countunlockandwait(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(&__rwlock->stats.unlockandwaits);
+#else
+	MG_DO_NOTHING(__rwlock);
+#endif
+}
+
+// Returns the wait start time to be passed into rwlock_stats_endwait()
+_MUTEXGEAR_PURE_INLINE
+uint64_t rwlock_stats_beginwait()
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	return _mutexgear_stats_gettime();
+#else
+	return 0;
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_endwait(mutexgear_rwlock_t *__rwlock, uint64_t __wait_start)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_addtime(&__rwlock->stats.total_wait_ns, &__rwlock->stats.max_wait_ns, __wait_start);
+#else
+	MG_DO_NOTHING(__rwlock);
+	MG_DO_NOTHING(__wait_start);
+#endif
+}
+
+// The write lock hold is measured by the owner only, so the start time needs no atomic access
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_beginwrite(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_increment(&__rwlock->stats.writes);
+	__rwlock->stats.hold_start = _mutexgear_stats_gettime();
+#else
+	MG_DO_NOTHING(__rwlock);
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_stats_endwrite(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	_mutexgear_stats_addtime(&__rwlock->stats.total_hold_ns, &__rwlock->stats.max_hold_ns, __rwlock->stats.hold_start);
+#else
+	MG_DO_NOTHING(__rwlock);
+#endif
+}
+
+// Acquires a reader push lock counting the cases when it is found owned by another writer
+_MUTEXGEAR_PURE_INLINE
+int rwlock_wrlock_acquire_reader_push_lock(mutexgear_rwlock_t *__rwlock, _MUTEXGEAR_LOCK_T *__push_lock, uint64_t __lock_deadline)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	int ret;
+
+	if ((ret = _mutexgear_lock_tryacquire(__push_lock)) == EBUSY)
+	{
+		_mutexgear_stats_increment(&__rwlock->stats.reader_push_lock_waits);
+
+		ret = _mutexgear_lock_timedacquire(__push_lock, __lock_deadline);
+	}
+
+	return ret;
+#else
+	MG_DO_NOTHING(__rwlock);
+
+	return _mutexgear_lock_timedacquire(__push_lock, __lock_deadline);
+#endif
+}
+
+// Locks the acquired_reads queue for a writer timing the wait if the queue is found locked by another thread
+_MUTEXGEAR_PURE_INLINE
+int rwlock_wrlock_lock_acquired_reads(mutexgear_rwlock_t *__rwlock)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	int ret;
+
+	if ((ret = _mutexgear_completion_queue_trylock(NULL, &__rwlock->acquired_reads)) == EBUSY)
+	{
+		uint64_t wait_start = rwlock_stats_beginwait();
+		ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads);
+		rwlock_stats_endwait(__rwlock, wait_start);
+	}
+
+	return ret;
+#else
+	return _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads);
+#endif
+}
+
+
 static int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t *__attr/*=NULL*/);
 
 /*extern */
@@ -257,6 +618,10 @@ int mutexgear_trdl_rwlock_init(mutexgear_trdl_rwlock_t *__rwlock, mutexgear_rwlo
 			break;
 		}
 
+		// The try-read-lock capable objects do not support the reader bias mode
+		__rwlock->basic_lock.fl_un.mode_flags &= ~_MUTEXGEAR_RWLOCK_MODE_READERBIAS;
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->basic_lock.readerbias_state), 0);
+
 		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->wrlock_waits), 0);
 
 		_mutexgear_completion_itemdata_init(&__rwlock->tryread_queue_separator);
@@ -295,9 +660,9 @@ int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t
 	int ret, mutex_destroy_status, genattr_destroy_status, drainablequeue_destroy_status, queue_destroy_status;
 
 	mutexgear_completion_genattr_t genattr;
-	unsigned int mutex_index = 0, mutex_count = 0;
-	bool readers_push_was_allocated = false, genattr_was_allocated = false, acquired_reads_were_allocated = false;
-	bool waiting_writes_were_allocated = false, waiting_reads_were_allocated = false;
+	unsigned int mutex_index = 0, mutex_count = 0, stripe_count = 0;
+	bool stripe_storage_was_allocated = false, push_storage_was_allocated = false, readers_push_was_allocated = false, genattr_was_allocated = false, acquired_reads_were_allocated = false;
+	bool waiting_writes_were_allocated = false, waiting_reads_were_allocated = false, fastpath_lock_was_allocated = false, upgrade_lock_was_allocated = false, execute_lock_was_allocated = false;
 
 	do
 	{
@@ -309,9 +674,59 @@ int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t
 			break;
 		}
 
+		// The visible readers table is local to the process
+		if ((mode_flags & (_MUTEXGEAR_RWLOCK_MODE_READERBIAS | _MUTEXGEAR_RWLOCK_MODE_PSHARED)) == (_MUTEXGEAR_RWLOCK_MODE_READERBIAS | _MUTEXGEAR_RWLOCK_MODE_PSHARED))
+		{
+			ret = EINVAL;
+			break;
+		}
+
 		__rwlock->fl_un.mode_flags = mode_flags;
 
 		mutex_count = ((mode_flags >> _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) + 1;
+
+		// The channel count must be a power of two, and the heap storage cannot be used in process shared mode
+		if ((mutex_count & (mutex_count - 1)) != 0
+			|| (mutex_count > _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT && (mode_flags & _MUTEXGEAR_RWLOCK_MODE_PSHARED) != 0))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		stripe_count = ((mode_flags >> _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK) + 1;
+
+		// The same restrictions apply to the express read stripes
+		if ((stripe_count & (stripe_count - 1)) != 0
+			|| (stripe_count != 1 && (mode_flags & _MUTEXGEAR_RWLOCK_MODE_PSHARED) != 0))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		if (stripe_count != 1)
+		{
+			MG_ASSERT(!_MUTEXGEAR_RWLOCK_ARE_EXPRESS_READS_INLINE(mode_flags));
+
+			if ((__rwlock->express_reads.allocated_stripes = (_mutexgear_rwlock_expressreadstripe_t *)malloc(stripe_count * sizeof(_mutexgear_rwlock_expressreadstripe_t))) == NULL)
+			{
+				ret = ENOMEM;
+				break;
+			}
+		}
+		stripe_storage_was_allocated = true;
+
+		if (mutex_count > _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT)
+		{
+			MG_ASSERT(!_MUTEXGEAR_RWLOCK_ARE_READER_PUSH_LOCKS_INLINE(mode_flags));
+
+			if ((__rwlock->reader_push_locks.allocated_locks = (_MUTEXGEAR_LOCK_T *)malloc(mutex_count * sizeof(_MUTEXGEAR_LOCK_T))) == NULL)
+			{
+				ret = ENOMEM;
+				break;
+			}
+		}
+		push_storage_was_allocated = true;
+
 		MG_ASSERT(!readers_push_was_allocated);
 		MG_ASSERT(mutex_index == 0);
 
@@ -362,6 +777,24 @@ int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t
 		}
 		waiting_reads_were_allocated = true;
 
+		if ((ret = _mutexgear_lock_init(&__rwlock->fastpath_wait_lock, __attr != NULL ? &__attr->lock_attr : NULL)) != EOK)
+		{
+			break;
+		}
+		fastpath_lock_was_allocated = true;
+
+		if ((ret = _mutexgear_lock_init(&__rwlock->upgrade_lock, __attr != NULL ? &__attr->lock_attr : NULL)) != EOK)
+		{
+			break;
+		}
+		upgrade_lock_was_allocated = true;
+
+		if ((ret = _mutexgear_lock_init(&__rwlock->execute_lock, __attr != NULL ? &__attr->lock_attr : NULL)) != EOK)
+		{
+			break;
+		}
+		execute_lock_was_allocated = true;
+
 		if ((ret = _mutexgear_completion_drain_init(&__rwlock->read_wait_drain)) != EOK)
 		{
 			break;
@@ -372,10 +805,26 @@ int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t
 			MG_CHECK(genattr_destroy_status, (genattr_destroy_status = _mutexgear_completion_genattr_destroy(&genattr)) == EOK); // This should succeed normally
 		}
 
-		mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
-		_mutexgear_dlraitem_initprevious(express_reads, express_reads);
+		for (unsigned int stripe_index = 0; stripe_index != stripe_count; ++stripe_index)
+		{
+			mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&_MUTEXGEAR_RWLOCK_ACCESS_EXPRESS_READS(__rwlock, stripe_index));
+			_mutexgear_dlraitem_initprevious(express_reads, express_reads);
+		}
 
 		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->express_commits), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->queued_reads), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->adaptivewp_writers), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->adaptivewp_score), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->prioritywp_writers), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->queued_writes), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->fastpath_state), 0);
+		__rwlock->handoff_item = NULL;
+		__rwlock->handoff_worker = NULL;
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->execute_requests), 0);
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->write_sequence), 0);
+		__rwlock->readerbias_inhibit_until = 0;
+		_mg_atomic_construct_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->readerbias_state), (mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERBIAS) != 0);
+		rwlock_stats_construct(__rwlock);
 
 		success = true;
 	}
@@ -393,6 +842,21 @@ int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t
 					{
 						if (waiting_reads_were_allocated)
 						{
+							if (fastpath_lock_was_allocated)
+							{
+								if (upgrade_lock_was_allocated)
+								{
+									if (execute_lock_was_allocated)
+									{
+										MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&__rwlock->execute_lock)) == EOK); // This should succeed normally
+									}
+
+									MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&__rwlock->upgrade_lock)) == EOK); // This should succeed normally
+								}
+
+								MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&__rwlock->fastpath_wait_lock)) == EOK); // This should succeed normally
+							}
+
 							MG_CHECK(drainablequeue_destroy_status, (drainablequeue_destroy_status = _mutexgear_completion_drainablequeue_destroy(&__rwlock->waiting_reads)) == EOK);
 						}
 
@@ -419,6 +883,16 @@ int _mutexgear_rwlock_init(mutexgear_rwlock_t *__rwlock, mutexgear_rwlockattr_t
 			--mutex_index;
 			MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, mutex_index))) == EOK); // This should succeed normally
 		}
+
+		if (push_storage_was_allocated && mutex_count > _MUTEXGEAR_RWLOCK_READERPUSHLOCK_INLINECOUNT)
+		{
+			free(__rwlock->reader_push_locks.allocated_locks);
+		}
+
+		if (stripe_storage_was_allocated && stripe_count != 1)
+		{
+			free(__rwlock->express_reads.allocated_stripes);
+		}
 	}
 
 	return success ? EOK : ret;
@@ -519,8 +993,8 @@ int _mutexgear_rwlock_destroy(mutexgear_rwlock_t *__rwlock)
 	bool success = false;
 	int ret, mutex_unlock_status, mutex_destroy_status;
 
-	unsigned int mutex_index, mutex_count;
-	bool drain_prepared = false, waiting_reads_prepared = false, waiting_writes_prepared = false, acquired_reads_prepared = false, push_locks_acquired = false;
+	unsigned int mutex_index, mutex_count, stripe_index, stripe_count;
+	bool fastpath_lock_acquired = false, upgrade_lock_acquired = false, execute_lock_acquired = false, drain_prepared = false, waiting_reads_prepared = false, waiting_writes_prepared = false, acquired_reads_prepared = false, push_locks_acquired = false;
 
 	do
 	{
@@ -532,17 +1006,51 @@ int _mutexgear_rwlock_destroy(mutexgear_rwlock_t *__rwlock)
 			break;
 		}
 
-		mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
+		stripe_count = ((mode_flags >> _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK) + 1;
+
+		for (stripe_index = 0; stripe_index != stripe_count; ++stripe_index)
+		{
+			mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&_MUTEXGEAR_RWLOCK_ACCESS_EXPRESS_READS(__rwlock, stripe_index));
 
-		if (mutexgear_dlraitem_getprevious(express_reads) != express_reads)
+			if (mutexgear_dlraitem_getprevious(express_reads) != express_reads)
+			{
+				break;
+			}
+		}
+		if (stripe_index != stripe_count)
 		{
 			ret = EINVAL;
 			break;
 		}
 
+		if (_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state)) != 0
+			|| _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->execute_requests)) != 0)
+		{
+			ret = EBUSY;
+			break;
+		}
+
 		// Try "preparing" each of the contained objects to verify its validity 
 		// before starting to destroy anything.
 
+		if ((ret = _mutexgear_lock_tryacquire(&__rwlock->fastpath_wait_lock)) != EOK)
+		{
+			break;
+		}
+		fastpath_lock_acquired = true;
+
+		if ((ret = _mutexgear_lock_tryacquire(&__rwlock->upgrade_lock)) != EOK)
+		{
+			break;
+		}
+		upgrade_lock_acquired = true;
+
+		if ((ret = _mutexgear_lock_tryacquire(&__rwlock->execute_lock)) != EOK)
+		{
+			break;
+		}
+		execute_lock_acquired = true;
+
 		if ((ret = _mutexgear_completion_drain_preparedestroy(&__rwlock->read_wait_drain)) != EOK)
 		{
 			break;
@@ -592,12 +1100,46 @@ int _mutexgear_rwlock_destroy(mutexgear_rwlock_t *__rwlock)
 			MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, mutex_index - 1))) == EOK);
 		}
 
+		if (!_MUTEXGEAR_RWLOCK_ARE_READER_PUSH_LOCKS_INLINE(mode_flags))
+		{
+			free(__rwlock->reader_push_locks.allocated_locks);
+		}
+
 		_mutexgear_completion_queue_completedestroy(&__rwlock->acquired_reads);
 		_mutexgear_completion_queue_completedestroy(&__rwlock->waiting_writes);
 		_mutexgear_completion_drainablequeue_completedestroy(&__rwlock->waiting_reads);
 		_mutexgear_completion_drain_completedestroy(&__rwlock->read_wait_drain);
-		_mutexgear_dlraitem_destroyprevious(express_reads);
+
+		for (stripe_index = 0; stripe_index != stripe_count; ++stripe_index)
+		{
+			mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&_MUTEXGEAR_RWLOCK_ACCESS_EXPRESS_READS(__rwlock, stripe_index));
+			_mutexgear_dlraitem_destroyprevious(express_reads);
+		}
+
+		if (!_MUTEXGEAR_RWLOCK_ARE_EXPRESS_READS_INLINE(mode_flags))
+		{
+			free(__rwlock->express_reads.allocated_stripes);
+		}
 		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->express_commits));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->queued_reads));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->adaptivewp_writers));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->adaptivewp_score));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->prioritywp_writers));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->queued_writes));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->fastpath_state));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->execute_requests));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->write_sequence));
+		_mg_atomic_destroy_ptrdiff(_MG_PA_PTRDIFF(&__rwlock->readerbias_state));
+		rwlock_stats_destroy(__rwlock);
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->execute_lock)) == EOK);
+		MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&__rwlock->execute_lock)) == EOK);
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK);
+		MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&__rwlock->upgrade_lock)) == EOK);
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->fastpath_wait_lock)) == EOK);
+		MG_CHECK(mutex_destroy_status, (mutex_destroy_status = _mutexgear_lock_destroy(&__rwlock->fastpath_wait_lock)) == EOK);
 
 		success = true;
 	}
@@ -632,6 +1174,21 @@ int _mutexgear_rwlock_destroy(mutexgear_rwlock_t *__rwlock)
 
 			_mutexgear_completion_drain_unpreparedestroy(&__rwlock->read_wait_drain);
 		}
+
+		if (execute_lock_acquired)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->execute_lock)) == EOK);
+		}
+
+		if (upgrade_lock_acquired)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK);
+		}
+
+		if (fastpath_lock_acquired)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->fastpath_wait_lock)) == EOK);
+		}
 	}
 
 	return success ? EOK : ret;
@@ -678,1257 +1235,3951 @@ bool rwlock_wrlock_are_zero_wrlock_waits(mutexgear_trdl_rwlock_t *__rwlock)
 }
 
 
-static int _mutexgear_trdl_rwlock_wrlock(int __readers_till_wp, mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/);
-static int _mutexgear_rwlock_wrlock(int __readers_till_wp, mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/);
-static bool rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
-	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, mutexgear_completion_item_t *__wait_completion_item, int *__out_status);
-static bool rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
-	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, mutexgear_completion_item_t *__wait_completion_item, int *__out_status);
-static bool rwlock_wrlock_wait_all_reads_and_acquire_access(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
-	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, mutexgear_completion_item_t *__wait_completion_item, 
-	mutexgear_completion_item_t *__last_reader_item, int *__out_status);
-_MUTEXGEAR_PURE_INLINE bool rwlock_wrlock_find_notmarked_reader_item(mutexgear_completion_item_t **__out_reader_item,
-	mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__reader_item);
-
-/*extern */
-int mutexgear_trdl_rwlock_wrlock(mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_upgrade_isenabled(const mutexgear_rwlock_t *__rwlock)
 {
-	return _mutexgear_trdl_rwlock_wrlock(0, __rwlock, __worker, __waiter, __item);
+	return (__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_UPGRADABLE) != 0;
 }
 
-/*extern */
-int mutexgear_trdl_rwlock_wrlock_cwp(mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, int __readers_till_wp)
+
+_MUTEXGEAR_PURE_INLINE
+int rwlock_prioritywp_decodeclass(unsigned int *__out_writer_class, int __writer_class)
 {
-	return _mutexgear_trdl_rwlock_wrlock(__readers_till_wp, __rwlock, __worker, __waiter, __item);
+	int ret = EOK;
+
+	if (__writer_class == MUTEXGEAR_RWLOCK_WRITERCLASS_SCHEDULING)
+	{
+		*__out_writer_class = _mutexgear_thread_getschedulingrank(MUTEXGEAR_RWLOCK_WRITERCLASS_MAX);
+	}
+	else if (__writer_class >= MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL && __writer_class <= MUTEXGEAR_RWLOCK_WRITERCLASS_MAX)
+	{
+		*__out_writer_class = (unsigned int)__writer_class;
+	}
+	else
+	{
+		ret = EINVAL;
+	}
+
+	return ret;
 }
 
-static 
-int _mutexgear_trdl_rwlock_wrlock(int __readers_till_wp, mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+_MUTEXGEAR_PURE_INLINE
+unsigned int rwlock_prioritywp_getitemclass(const mutexgear_completion_item_t *__item)
 {
-	bool success = false;
-	int ret, mutex_unlock_status, item_completion_status;
+	unsigned int writer_class = 0;
 
-	int readers_till_wp = __readers_till_wp;
-	bool item_initialized = false, wrwaits_incremented = false, wait_initialized = false, wait_inserted = false;
+	for (unsigned int tag_index = wrlock_itemtag__class_min; tag_index != wrlock_itemtag__class_max; ++tag_index)
+	{
+		writer_class |= (unsigned int)_mutexgear_completion_itemdata_gettag(&__item->data, tag_index) << (tag_index - wrlock_itemtag__class_min);
+	}
 
-	mutexgear_completion_item_t wait_completion_item;
-	mutexgear_completion_item_t *wait_completion_to_use = __item;
+	return writer_class;
+}
 
-	do
+_MUTEXGEAR_PURE_INLINE
+void rwlock_prioritywp_setitemclass(mutexgear_completion_item_t *__item, unsigned int __writer_class)
+{
+	// The tags are only modified while the item is not queued and are only read by other threads with waiting_writes locked
+	for (unsigned int tag_index = wrlock_itemtag__class_min; tag_index != wrlock_itemtag__class_max; ++tag_index)
 	{
-		if (__item == NULL && readers_till_wp >= 0)
-		{
-			MG_STATIC_ASSERT(MUTEXGEAR_PROCESS_SHARED != 0);
+		_mutexgear_completion_itemdata_setunsafetag(&__item->data, tag_index, ((__writer_class >> (tag_index - wrlock_itemtag__class_min)) & 1) != 0);
+	}
+}
 
-			if ((__rwlock->basic_lock.fl_un.mode_flags & MUTEXGEAR_PROCESS_SHARED) != 0) // In case of shared mode, item parameter must not be NULL
-			{
-				ret = EINVAL;
-				break;
-			}
+_MUTEXGEAR_PURE_INLINE
+int rwlock_prioritywp_enqueueitem(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__item, unsigned int __writer_class)
+{
+	int ret, mutex_unlock_status;
 
-			_mutexgear_completion_item_init(&wait_completion_item);
-			wait_completion_to_use = &wait_completion_item;
-			item_initialized = true;
+	if (__writer_class == MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL)
+	{
+		ret = _mutexgear_completion_queue_enqueue_back(&__rwlock->waiting_writes, __item, NULL);
+	}
+	else if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) == EOK)
+	{
+		rwlock_prioritywp_setitemclass(__item, __writer_class);
+
+		// The queue is kept ordered by the class descending and the item is inserted after the last one of its own class or higher.
+		// The readers only wait for the queue tail and are not affected by an insertion before it.
+		mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->waiting_writes), *before_item;
+		for (before_item = _mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->waiting_writes); 
+			before_item != end_item && rwlock_prioritywp_getitemclass(before_item) >= __writer_class; 
+			before_item = _mutexgear_completion_queue_unsafegetunsafenext(before_item))
+		{
 		}
 
-		bool tryreads_barrier_required;
-		rwlock_wrlock_increment_wrlock_waits(__rwlock, &tryreads_barrier_required);
-		wrwaits_incremented = true;
+		_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->waiting_writes, before_item, __item);
+		_mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->prioritywp_writers), 1);
 
-		if (tryreads_barrier_required)
-		{
-			if ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK)
-			{
-				break;
-			}
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
+	}
 
-			// It is more reasonable to signal the barrier within the lock, rather than after it,
-			// as releasing the lock may wake up a higher priority thread and delay the flag appearance for upcoming writes.
-			//
-			// NOTE: // Also, since the operation is serialized with a lock, it can be performed in an unsafe manner for performance sake.
-			rwlock_wrlock_unsafe_record_wrlock_waits_tryread_barrier_pass(__rwlock);
+	if (ret == EOK)
+	{
+		rwlock_stats_countwpclaim(__rwlock);
+	}
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
-		}
+	return ret;
+}
 
-		bool access_acquired = false;
+_MUTEXGEAR_PURE_INLINE
+void rwlock_prioritywp_finishitem(mutexgear_rwlock_t *__rwlock, mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	int item_completion_status;
+	MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_queueditem_safefinish(&__rwlock->waiting_writes, __item, __worker)) == EOK); // Well, the item must be removed at any cost!
 
-		mutexgear_completion_item_t *test_tail_item, *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
-		if ((_mutexgear_completion_queue_gettail(&test_tail_item, &__rwlock->basic_lock.acquired_reads), test_tail_item == tryread_queue_separator)
-			&& _mutexgear_completion_queue_getunsafepreceding(tryread_queue_separator) == _mutexgear_completion_queue_getrend(&__rwlock->basic_lock.acquired_reads))
+	// The class tags must not remain set for the item could be used for a read lock next
+	if (rwlock_prioritywp_getitemclass(__item) != MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL)
+	{
+		rwlock_prioritywp_setitemclass(__item, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL);
+		_mg_atomic_fetch_sub_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->prioritywp_writers), 1);
+	}
+}
+
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_prioritywp_isoutranked(mutexgear_rwlock_t *__rwlock, unsigned int __writer_class)
+{
+	bool result = false;
+	int mutex_unlock_status;
+
+	// The queue is not examined unless there are raised class writers waiting, so that the regular writers only pay for a counter read
+	if (__writer_class != MUTEXGEAR_RWLOCK_WRITERCLASS_MAX && _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->prioritywp_writers)) != 0)
+	{
+		// The head item has the highest class waiting. It may also be an item a former owner kept in the handoff mode and is about to remove -- 
+		// yielding to it just results in an extra attempt. A failure to lock is treated as if there were no higher class writers.
+		if (_mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes) == EOK)
 		{
-			if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->basic_lock.acquired_reads)) != EOK)
-			{
-				break;
-			}
+			mutexgear_completion_item_t *head_item = _mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->waiting_writes);
+			result = head_item != _mutexgear_completion_queue_getend(&__rwlock->waiting_writes) && rwlock_prioritywp_getitemclass(head_item) > __writer_class;
 
-			// Check via the "next" pointers as it is not atomic: atomic access is not needed while the queue is locked
-			if (_mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->basic_lock.acquired_reads) == tryread_queue_separator
-				&& _mutexgear_completion_queue_unsafegetunsafenext(tryread_queue_separator) == _mutexgear_completion_queue_getend(&__rwlock->basic_lock.acquired_reads))
-			{
-				access_acquired = true;
-			}
-			else
-			{
-				// NOTE: Going for registering into waiting_writes with the acquired_reads unlocked
-				// may result in a few extra reads passing into the object. But it is perfectly OK 
-				// as those can be considered as if they would had gained the access even before the 
-				// acquired_reads lock was acquired at all.
-				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
-			}
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
 		}
+	}
 
-		if (!access_acquired)
-		{
-			if (readers_till_wp >= 0)
-			{
-				_mutexgear_completion_item_prestart(wait_completion_to_use, __worker);
-				wait_initialized = true;
+	return result;
+}
 
-				if (readers_till_wp == 0)
-				{
-					if ((ret = _mutexgear_completion_queue_enqueue_back(&__rwlock->basic_lock.waiting_writes, wait_completion_to_use, NULL)) != EOK)
-					{
-						break;
-					}
 
-					wait_inserted = true;
-				}
-			}
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_handoff_isenabled(const mutexgear_rwlock_t *__rwlock)
+{
+	return (__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_HANDOFF) != 0;
+}
 
-			mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
-			// NOTE: The overhead in rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels() is actually
-			// so minor that it is unclear if it is worth making the two separate implementations. Let it be though.
-			if ((__rwlock->basic_lock.fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) == 0
-				? !rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(&__rwlock->basic_lock, tryread_queue_separator, __waiter, &readers_till_wp, wait_completion_to_use, &ret)
-				: !rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(&__rwlock->basic_lock, tryread_queue_separator, __waiter, &readers_till_wp, wait_completion_to_use, &ret))
-			{
-				wait_inserted = readers_till_wp == 0;
-				break;
-			}
+_MUTEXGEAR_PURE_INLINE
+void rwlock_handoff_retainitem(mutexgear_rwlock_t *__rwlock, mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	// The fields are only accessed by the write lock owner
+	MG_ASSERT(__rwlock->handoff_item == NULL);
 
-			if (readers_till_wp == 0)
-			{
-				MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_queueditem_safefinish(&__rwlock->basic_lock.waiting_writes, wait_completion_to_use, __worker)) == EOK); // Well, the item must be removed at any cost!
-				// wait_inserted = false;
-			}
-			else if (readers_till_wp > 0)
-			{
-				_mutexgear_completion_item_reinit(wait_completion_to_use);
-				// wait_initialized = false;
-			}
-		}
+	__rwlock->handoff_item = __item;
+	__rwlock->handoff_worker = __worker;
+}
 
-		if (item_initialized)
-		{
-			_mutexgear_completion_item_destroy(&wait_completion_item);
-		}
+_MUTEXGEAR_PURE_INLINE
+mutexgear_completion_item_t *rwlock_handoff_takeitem(mutexgear_rwlock_t *__rwlock, mutexgear_completion_worker_t **__out_worker)
+{
+	mutexgear_completion_item_t *retained_item = __rwlock->handoff_item;
 
-		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item));
+	if (retained_item != NULL)
+	{
+		*__out_worker = __rwlock->handoff_worker;
+		__rwlock->handoff_item = NULL;
+	}
 
-		success = true;
+	return retained_item;
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_handoff_releaseitem(mutexgear_rwlock_t *__rwlock, mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	rwlock_prioritywp_finishitem(__rwlock, __worker, __item);
+}
+
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_prioritywp_yieldaccess(mutexgear_rwlock_t *__rwlock)
+{
+	int mutex_unlock_status;
+
+	// The access is released the same way wrunlock does it, except that the sequence for optimistic reads has not been entered yet
+	mutexgear_completion_worker_t *handoff_worker;
+	mutexgear_completion_item_t *handoff_item = rwlock_handoff_takeitem(__rwlock, &handoff_worker);
+
+	MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+	if (handoff_item != NULL)
+	{
+		rwlock_handoff_releaseitem(__rwlock, handoff_worker, handoff_item);
 	}
-	while (false);
 
-	if (!success)
+	_mutexgear_thread_yield();
+}
+
+
+typedef struct _mutexgear_rwlock_executerequest
+{
+	struct _mutexgear_rwlock_executerequest *next_request;
+	mutexgear_rwlock_execute_fn_t execute_proc;
+	void                         *execute_context;
+	bool                         request_executed;
+
+} _mutexgear_rwlock_executerequest_t;
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_execute_submitrequest(mutexgear_rwlock_t *__rwlock, _mutexgear_rwlock_executerequest_t *__request)
+{
+	ptrdiff_t request_stack = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->execute_requests));
+
+	do
 	{
-		if (wrwaits_incremented)
-		{
-			if (wait_initialized)
-			{
-				if (wait_inserted)
-				{
-					MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_queueditem_safefinish(&__rwlock->basic_lock.waiting_writes, wait_completion_to_use, __worker)) == EOK); // No way to handle -- must succeed
-				}
+		__request->next_request = (_mutexgear_rwlock_executerequest_t *)request_stack;
+	}
+	while (!_mg_atomic_cas_release_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->execute_requests), &request_stack, (ptrdiff_t)__request));
+}
 
-				_mutexgear_completion_item_reinit(wait_completion_to_use);
-			}
+_MUTEXGEAR_PURE_INLINE
+_mutexgear_rwlock_executerequest_t *rwlock_execute_extractrequests(mutexgear_rwlock_t *__rwlock)
+{
+	ptrdiff_t request_stack = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->execute_requests));
 
-			rwlock_wrlock_decrement_wrlock_waits(__rwlock);
-		}
+	while (request_stack != 0 && !_mg_atomic_cas_acqrel_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->execute_requests), &request_stack, 0))
+	{
+	}
 
-		if (item_initialized)
-		{
-			_mutexgear_completion_item_destroy(&wait_completion_item);
-		}
+	// Reverse the stack to have the requests executed in the order of submission
+	_mutexgear_rwlock_executerequest_t *request_list = NULL, *current_request = (_mutexgear_rwlock_executerequest_t *)request_stack;
 
-		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item));
+	while (current_request != NULL)
+	{
+		_mutexgear_rwlock_executerequest_t *next_request = current_request->next_request;
+		current_request->next_request = request_list;
+		request_list = current_request;
+		current_request = next_request;
 	}
 
-	return success ? EOK : ret;
+	return request_list;
 }
 
-/*extern */
-int mutexgear_rwlock_wrlock(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+
+// The queued thread counters are only maintained on the blocking paths and are only read by mutexgear_rwlock_getstate()
+_MUTEXGEAR_PURE_INLINE
+void rwlock_state_enterqueue(ptrdiff_t *__queued_counter)
 {
-	return _mutexgear_rwlock_wrlock(0, __rwlock, __worker, __waiter, __item);
+	_mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(__queued_counter), 1);
 }
 
-/*extern */
-int mutexgear_rwlock_wrlock_cwp(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, int __readers_till_wp)
+_MUTEXGEAR_PURE_INLINE
+void rwlock_state_leavequeue(ptrdiff_t *__queued_counter)
 {
-	return _mutexgear_rwlock_wrlock(__readers_till_wp, __rwlock, __worker, __waiter, __item);
+	_mg_atomic_fetch_sub_relaxed_ptrdiff(_MG_PVA_PTRDIFF(__queued_counter), 1);
 }
 
-static 
-int _mutexgear_rwlock_wrlock(int __readers_till_wp, mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_optread_enterwrite(mutexgear_rwlock_t *__rwlock)
 {
-	bool success = false;
-	int ret, mutex_unlock_status, item_completion_status;
+	// The sequence is only modified by the write lock owner and does not need an atomic increment
+	ptrdiff_t write_sequence = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->write_sequence));
+	MG_ASSERT((write_sequence & 1) == 0);
 
-	int readers_till_wp = __readers_till_wp;
-	bool item_initialized = false, wait_initialized = false, wait_inserted = false;
+	_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->write_sequence), write_sequence + 1);
+	// The odd sequence must become visible before any modification made under the write lock
+	_mg_atomic_thread_fence_release();
 
-	mutexgear_completion_item_t wait_completion_item;
-	mutexgear_completion_item_t *wait_completion_to_use = __item;
+	// Every write lock acquisition passes here, so the write hold time is measured from this point
+	rwlock_stats_beginwrite(__rwlock);
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_optread_leavewrite(mutexgear_rwlock_t *__rwlock)
+{
+	rwlock_stats_endwrite(__rwlock);
+
+	ptrdiff_t write_sequence = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->write_sequence));
+	MG_ASSERT((write_sequence & 1) != 0);
+
+	_mg_atomic_store_release_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->write_sequence), write_sequence + 1);
+}
+
+
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_readerbias_isenabled(const mutexgear_rwlock_t *__rwlock)
+{
+	return (__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERBIAS) != 0;
+}
+
+_MUTEXGEAR_PURE_INLINE
+ptrdiff_t *rwlock_readerbias_getslot(const mutexgear_rwlock_t *__rwlock, const mutexgear_completion_item_t *__item)
+{
+	// The items are thread specific and the hash spreads the readers of an object over the table
+	uintptr_t slot_hash = ((uintptr_t)__rwlock ^ (uintptr_t)__item) * (uintptr_t)UINT64_C(0x9E3779B97F4A7C15);
+	return &g_rwlock_readerbias_slots[slot_hash >> (sizeof(uintptr_t) * CHAR_BIT - _MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT_BITS)];
+}
+
+static 
+bool rwlock_readerbias_tryrdlock(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
 
 	do
 	{
-		if (__item == NULL && readers_till_wp >= 0)
+		if (_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->readerbias_state)) == 0)
 		{
-			MG_STATIC_ASSERT(MUTEXGEAR_PROCESS_SHARED != 0);
+			break;
+		}
 
-			if ((__rwlock->fl_un.mode_flags & MUTEXGEAR_PROCESS_SHARED) != 0) // In case of shared mode, item parameter must not be NULL
-			{
-				ret = EINVAL;
-				break;
-			}
+		ptrdiff_t *slot = rwlock_readerbias_getslot(__rwlock, __item);
 
-			_mutexgear_completion_item_init(&wait_completion_item);
-			wait_completion_to_use = &wait_completion_item;
-			item_initialized = true;
+		ptrdiff_t slot_value = 0;
+		if (!_mg_atomic_cas_relaxed_ptrdiff(_MG_PVA_PTRDIFF(slot), &slot_value, (ptrdiff_t)__rwlock))
+		{
+			break;
 		}
 
-		bool access_acquired = false;
+		// Either the revoking writer sees the slot in its scan or the reader sees the bias revoked (the writer does the reverse with a fence as well)
+		_mg_atomic_thread_fence_seqcst();
 
-		if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
+		// The acquire pairs with the release by the reader that has re-enabled the bias after the last writer
+		if (_mg_atomic_load_acquire_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->readerbias_state)) == 0)
 		{
-			if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
-			{
-				break;
-			}
+			_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(slot), 0);
+			break;
+		}
 
-			if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
-			{
-				access_acquired = true;
-			}
-			else
-			{
-				// NOTE: Going for registering into waiting_writes with the acquired_reads unlocked
-				// may result in a few extra reads passing into the object. But it is perfectly OK 
-				// as those can be considered as if they would had gained the access even before the 
-				// acquired_reads lock was acquired at all.
-				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
-			}
-		}
+		_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_readerbiased, true);
 
-		if (!access_acquired)
-		{
-			if (readers_till_wp >= 0)
-			{
-				_mutexgear_completion_item_prestart(wait_completion_to_use, __worker);
-				wait_initialized = true;
+		success = true;
+	}
+	while (false);
 
-				if (readers_till_wp == 0)
-				{
-					if ((ret = _mutexgear_completion_queue_enqueue_back(&__rwlock->waiting_writes, wait_completion_to_use, NULL)) != EOK)
-					{
-						break;
-					}
+	return success;
+}
 
-					wait_inserted = true;
-				}
-			}
+_MUTEXGEAR_PURE_INLINE
+void rwlock_readerbias_rdunlock(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__item)
+{
+	_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_readerbiased, false);
 
-			// NOTE: The overhead in rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels() is actually
-			// so minor that it is unclear if it is worth making the two separate implementations. Let it be though.
-			if ((__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) == 0
-				? !rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(__rwlock, NULL, __waiter, &readers_till_wp, wait_completion_to_use, &ret)
-				: !rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(__rwlock, NULL, __waiter, &readers_till_wp, wait_completion_to_use, &ret))
-			{
-				wait_inserted = readers_till_wp == 0;
-				break;
-			}
+	ptrdiff_t *slot = rwlock_readerbias_getslot(__rwlock, __item);
+	MG_ASSERT(_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(slot)) == (ptrdiff_t)__rwlock);
 
-			if (readers_till_wp == 0)
-			{
-				MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_queueditem_safefinish(&__rwlock->waiting_writes, wait_completion_to_use, __worker)) == EOK); // Well, the item must be removed at any cost!
-				// wait_inserted = false;
-			}
-			else if (readers_till_wp > 0)
-			{
-				_mutexgear_completion_item_reinit(wait_completion_to_use);
-				// wait_initialized = false;
-			}
-		}
+	// The release makes the reads done under the lock complete before a revoking writer proceeds
+	_mg_atomic_store_release_ptrdiff(_MG_PVA_PTRDIFF(slot), 0);
+}
 
-		if (item_initialized)
+static 
+bool rwlock_readerbias_revoke(mutexgear_rwlock_t *__rwlock, bool __wait_readers)
+{
+	bool success = false;
+
+	do
+	{
+		// The bias state is only modified by the lock owners and is stable for the writer
+		if (_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->readerbias_state)) == 0)
 		{
-			_mutexgear_completion_item_destroy(&wait_completion_item);
+			success = true;
+			break;
 		}
 
-		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item));
+		uint64_t revocation_start;
+		bool clock_succeeded = _mutexgear_clock_getnanoseconds(&revocation_start) == EOK;
 
-		success = true;
-	}
-	while (false);
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->readerbias_state), 0);
+		_mg_atomic_thread_fence_seqcst();
 
-	if (!success)
-	{
-		if (wait_initialized)
+		bool readers_drained = true;
+
+		ptrdiff_t *const slots_end = g_rwlock_readerbias_slots + _MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT;
+		for (ptrdiff_t *current_slot = g_rwlock_readerbias_slots; current_slot != slots_end; ++current_slot)
 		{
-			if (wait_inserted)
+			while (_mg_atomic_load_acquire_ptrdiff(_MG_PCVA_PTRDIFF(current_slot)) == (ptrdiff_t)__rwlock)
 			{
-				MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_queueditem_safefinish(&__rwlock->waiting_writes, wait_completion_to_use, __worker)) == EOK); // No way to handle -- must succeed
+				if (!__wait_readers)
+				{
+					readers_drained = false;
+					break;
+				}
+
+				_mutexgear_thread_yield();
 			}
 
-			_mutexgear_completion_item_reinit(wait_completion_to_use);
+			if (!readers_drained)
+			{
+				break;
+			}
 		}
 
-		if (item_initialized)
+		// With a clock failure, the bias remains disabled
+		uint64_t revocation_end;
+		__rwlock->readerbias_inhibit_until = clock_succeeded && _mutexgear_clock_getnanoseconds(&revocation_end) == EOK
+			? revocation_end + (revocation_end - revocation_start) * _MUTEXGEAR_RWLOCK_READERBIAS_INHIBIT_MULTIPLIER
+			: _MUTEXGEAR_DEADLINE_INFINITE;
+
+		if (!readers_drained)
 		{
-			_mutexgear_completion_item_destroy(&wait_completion_item);
+			break;
 		}
 
-		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item));
+		success = true;
 	}
+	while (false);
 
-	return success ? EOK : ret;
+	return success;
 }
 
-static
-bool rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
-	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, mutexgear_completion_item_t *__wait_completion_item, int *__out_status)
+_MUTEXGEAR_PURE_INLINE
+void rwlock_readerbias_tryrestore(mutexgear_rwlock_t *__rwlock)
 {
-	bool success = false;
-	int ret, mutex_unlock_status;
+	// The bias is re-enabled by a reader that has acquired the lock in the regular way after the inhibition period has expired
+	uint64_t current_time;
+	if (_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->readerbias_state)) == 0
+		&& __rwlock->readerbias_inhibit_until != _MUTEXGEAR_DEADLINE_INFINITE
+		&& _mutexgear_clock_getnanoseconds(&current_time) == EOK && current_time >= __rwlock->readerbias_inhibit_until)
+	{
+		// The release lets the biased readers see the modifications of the last writer
+		_mg_atomic_store_release_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->readerbias_state), 1);
+	}
+}
 
-	bool push_locked = false;
+static 
+ptrdiff_t rwlock_readerbias_countreaders(const mutexgear_rwlock_t *__rwlock)
+{
+	ptrdiff_t reader_count = 0;
 
-	do
+	const ptrdiff_t *const slots_end = g_rwlock_readerbias_slots + _MUTEXGEAR_RWLOCK_READERBIAS_SLOTCOUNT;
+	for (const ptrdiff_t *current_slot = g_rwlock_readerbias_slots; current_slot != slots_end; ++current_slot)
 	{
-		if ((ret = _mutexgear_lock_acquire(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, 0))) != EOK)
-		{
-			break;
-		}
-		push_locked = true;
-
-		// The readers push lock is a likely blocking lock, so there is a reason to re-check the acquired reads.
-		// This could, actually, be done within the rwlock_wrlock_wait_all_reads_and_acquire_access() 
-		// but extra checking here unrolls the first pass of the loop without entering the nested function.
-		// 
-		// The code is going to lock acquired_reads anyway, so there is no reason to check for the queue to be empty unlocked.
-		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
+		if (_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(current_slot)) == (ptrdiff_t)__rwlock)
 		{
-			break;
+			++reader_count;
 		}
+	}
 
-		mutexgear_completion_item_t	*last_reader_item;
-		if (_mutexgear_completion_queue_gettail(&last_reader_item, &__rwlock->acquired_reads) // This is equivalent to emptiness check
-			&& (last_reader_item != __separator_item || _mutexgear_completion_queue_getpreceding(&last_reader_item, &__rwlock->acquired_reads, last_reader_item))
-			&& !rwlock_wrlock_wait_all_reads_and_acquire_access(__rwlock, __separator_item, __waiter, __var_readers_till_wp, __wait_completion_item, last_reader_item, &ret))
-		{
-			// The unlock for acquired_reads in the call above is not allowed to fail
+	return reader_count;
+}
 
-			// Also, _MUTEXGEAR_RWLOCK_EALLITEMSBUSY cannot be returned
-			MG_ASSERT(ret != _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY);
 
-			break;
-		}
+_MUTEXGEAR_PURE_INLINE
+unsigned int rwlock_express_getstripemask(const mutexgear_rwlock_t *__rwlock)
+{
+	return (__rwlock->fl_un.mode_flags >> _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_SHIFT) & _MUTEXGEAR_RWLOCK_MODE_EXPRESSSTRIPES_MASK;
+}
 
-		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, 0)) == EOK)); // Should succeed normally
-		// push_locked = false;
+_MUTEXGEAR_PURE_INLINE
+mutexgear_dlraitem_t *rwlock_express_getstripe(mutexgear_rwlock_t *__rwlock, unsigned int __stripe_index)
+{
+	return _mutexgear_dlraitem_getfromprevious(&_MUTEXGEAR_RWLOCK_ACCESS_EXPRESS_READS(__rwlock, __stripe_index));
+}
 
-		success = true;
-	}
-	while (false);
+_MUTEXGEAR_PURE_INLINE
+unsigned int rwlock_express_selectstripe(const mutexgear_rwlock_t *__rwlock, const mutexgear_completion_worker_t *__worker)
+{
+	unsigned int stripe_mask = rwlock_express_getstripemask(__rwlock), stripe_index = 0;
 
-	if (!success)
+	if (stripe_mask != 0)
 	{
-		if (push_locked)
-		{
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, 0))) == EOK); // Should succeed normally
-		}
+		// Select the stripe by the execution core to keep readers on different cores off each other's cache lines.
+		// The worker address is a per-thread fallback for the targets where the core number is not available.
+#if defined(_WIN32)
+		MG_DO_NOTHING(__worker);
+		stripe_index = (unsigned int)GetCurrentProcessorNumber() & stripe_mask;
+#elif defined(_MUTEXGEAR_HAVE_SCHED_GETCPU)
+		int current_cpu = sched_getcpu();
+		stripe_index = (unsigned int)(current_cpu >= 0 ? (size_t)current_cpu : _MUTEXGEAR_RWLOCK_MAKE_READER_PUSH_SELECTOR(__worker)) & stripe_mask;
+#else
+		stripe_index = (unsigned int)_MUTEXGEAR_RWLOCK_MAKE_READER_PUSH_SELECTOR(__worker) & stripe_mask;
+#endif
 	}
 
-	return success || (*__out_status = ret, false);
+	return stripe_index;
 }
 
-static
-bool rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
-	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, mutexgear_completion_item_t *__wait_completion_item, int *__out_status)
+
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_fastpath_isenabled(const mutexgear_rwlock_t *__rwlock)
 {
-	bool fault = false;
-	int ret, mutex_unlock_status;
+	return (__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_NOFASTPATH) == 0;
+}
 
-	const unsigned int lock_index_mask = (__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) >> _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT;
-	unsigned int starting_push_lock_index = (unsigned int)_MUTEXGEAR_RWLOCK_MAKE_READER_PUSH_SELECTOR(__waiter); // OK to truncate, the mask is smaller anyway
-	MG_STATIC_ASSERT(_MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK <= UINT_MAX);
+_MUTEXGEAR_PURE_INLINE
+ptrdiff_t rwlock_fastpath_encodeowner(const mutexgear_rwlock_t *__rwlock, const void *__owner_object, ptrdiff_t __owner_kind)
+{
+	MG_ASSERT(((uintptr_t)__owner_object & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK) == 0);
 
-	ptrdiff_t known_express_commits = 0;
-	unsigned int push_lock_index = starting_push_lock_index;
+	return ((const uint8_t *)__owner_object - (const uint8_t *)__rwlock) | __owner_kind;
+}
 
-	if ((ret = _mutexgear_lock_acquire(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask))) != EOK)
-	{
-		fault = true;
-	}
+_MUTEXGEAR_PURE_INLINE
+void *rwlock_fastpath_decodeowner(const mutexgear_rwlock_t *__rwlock, ptrdiff_t __fastpath_state)
+{
+	return (uint8_t *)__rwlock + (__fastpath_state & ~(ptrdiff_t)_MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK);
+}
 
-	if (!fault)
-	{
-		++push_lock_index;
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_fastpath_tryacquire(mutexgear_rwlock_t *__rwlock, const void *__owner_object, ptrdiff_t __owner_kind)
+{
+	ptrdiff_t fastpath_state = 0;
+	// The acquire-release order is used to also publish the owner object (the pre-started item) for the contending threads
+	return _mg_atomic_cas_acqrel_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), &fastpath_state, rwlock_fastpath_encodeowner(__rwlock, __owner_object, __owner_kind));
+}
 
-		known_express_commits = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits));
-	}
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_fastpath_tryrelease(mutexgear_rwlock_t *__rwlock, ptrdiff_t *__var_fastpath_state)
+{
+	return _mg_atomic_cas_release_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), __var_fastpath_state, 0);
+}
 
-	for (; !fault; fault = false)
-	{
-		// The readers push lock is a likely blocking lock, so there is a reason to re-check the acquired reads.
-		// This could, actually, be done within the rwlock_wrlock_wait_all_reads_and_acquire_access() 
-		// but extra checking here unrolls the first pass of the loop without entering the nested function.
-		// 
-		// The code is going to lock acquired_reads anyway, so there is no reason to check for the queue to be empty unlocked.
-		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
-		{
-			fault = true;
-			break;
-		}
+static bool rwlock_fastpath_attach_reader_into_acquired_reads(mutexgear_rwlock_t *__rwlock, ptrdiff_t *__var_fastpath_state, bool *__out_attached, int *__out_status);
+static bool rwlock_fastpath_wait_writer_handover(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, bool *__out_handed_over, int *__out_status);
 
-		mutexgear_completion_item_t	*last_reader_item;
-		if (!_mutexgear_completion_queue_gettail(&last_reader_item, &__rwlock->acquired_reads) // This is equivalent to emptiness check
-			|| (last_reader_item == __separator_item && !_mutexgear_completion_queue_getpreceding(&last_reader_item, &__rwlock->acquired_reads, last_reader_item)))
-		{
-			break;
-		}
+static 
+bool rwlock_fastpath_enter_slow(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_waiter_t *__waiter/*=NULL*/, mutexgear_completion_item_t *__item/*=NULL*/, uint64_t __lock_deadline, int *__out_status)
+{
+	bool fault = false;
+	int ret;
 
-		if (rwlock_wrlock_wait_all_reads_and_acquire_access(__rwlock, __separator_item, __waiter, __var_readers_till_wp, __wait_completion_item, last_reader_item, &ret))
+	ptrdiff_t fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
+
+	for (;;)
+	{
+		if ((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK) == 0)
 		{
-			break;
+			// The object is free or there are other threads within the queue based implementation -- just join them
+			if (_mg_atomic_cas_acqrel_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), &fastpath_state, fastpath_state + _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT))
+			{
+				break;
+			}
 		}
-		// The unlock for acquired_reads in the call above is not allowed to fail
-
-		if (ret != _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY)
+		else if (__waiter == NULL && (__item == NULL || (fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_WRITER) != 0)) // A try-lock (a try-read-lock passes its item to still attach a fast path reader)
 		{
+			ret = EBUSY;
 			fault = true;
 			break;
 		}
-
-		// Check if express_commits counter changed...
-		ptrdiff_t new_express_commits = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits));
-
-		// ...if not, proceed locking the next mutex
-		if (known_express_commits == new_express_commits)
+		else if ((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_WRITER) == 0)
 		{
-			if ((ret = _mutexgear_lock_acquire(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask))) != EOK)
+			// A fast path reader is to be converted into an ordinary one in acquired_reads
+			bool reader_attached;
+			if (!rwlock_fastpath_attach_reader_into_acquired_reads(__rwlock, &fastpath_state, &reader_attached, &ret))
 			{
 				fault = true;
 				break;
 			}
 
-			++push_lock_index;
+			if (reader_attached)
+			{
+				break;
+			}
 		}
-		// ...if changed, stay with the current locked mutex range and go for one more pass instead
-		else
+		else if (__lock_deadline != _MUTEXGEAR_DEADLINE_INFINITE)
 		{
-			known_express_commits = new_express_commits;
-		}
-	}
+			// The handover wait can't be withdrawn after the wait tag has been published. 
+			// A timed lock polls for the fast path writer to leave instead.
+			if (_mutexgear_deadline_isreached(__lock_deadline))
+			{
+				ret = ETIMEDOUT;
+				fault = true;
+				break;
+			}
 
-	if (!fault)
-	{
-		bool exit_the_loop;
-		for (exit_the_loop = false; !exit_the_loop; exit_the_loop = push_lock_index == starting_push_lock_index)
-		{
-			--push_lock_index;
+			_mutexgear_thread_yield();
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask))) == EOK); // Should succeed normally
+			fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
 		}
-	}
-
-	if (fault)
-	{
-		while (push_lock_index != starting_push_lock_index)
+		else
 		{
-			--push_lock_index;
+			// A fast path writer must release the object first -- it is going to count this thread in with the queue based implementation
+			bool writer_handed_over;
+			if (!rwlock_fastpath_wait_writer_handover(__rwlock, __waiter, __item, &writer_handed_over, &ret))
+			{
+				fault = true;
+				break;
+			}
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask))) == EOK); // Should succeed normally
+			if (writer_handed_over)
+			{
+				break;
+			}
+
+			fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
 		}
 	}
 
 	return !fault || (*__out_status = ret, false);
 }
 
-static
-bool rwlock_wrlock_wait_all_reads_and_acquire_access(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
-	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, mutexgear_completion_item_t *__wait_completion_item, 
-	mutexgear_completion_item_t *__last_reader_item, int *__out_status)
+_MUTEXGEAR_PURE_INLINE
+void rwlock_fastpath_leave_slow(mutexgear_rwlock_t *__rwlock)
+{
+	ptrdiff_t fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
+	MG_ASSERT((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK) == 0 && fastpath_state >= _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT); // A memory value corruption or an invalid memory modification otherwise
+
+	while (!_mg_atomic_cas_release_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), &fastpath_state, fastpath_state - _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT))
+	{
+		MG_ASSERT((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK) == 0 && fastpath_state >= _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT);
+	}
+}
+
+static 
+bool rwlock_fastpath_attach_reader_into_acquired_reads(mutexgear_rwlock_t *__rwlock, ptrdiff_t *__var_fastpath_state, bool *__out_attached, int *__out_status)
 {
 	bool fault = false;
 	int ret, mutex_unlock_status;
 
-	int readers_till_wp = *__var_readers_till_wp;
-
-	mutexgear_completion_item_t	*reader_item = __last_reader_item;
-	MG_ASSERT(reader_item != NULL);
-
-	// bool access_locked = true;
-
-	bool exit_the_loop;
-	for (exit_the_loop = false; !exit_the_loop;
-		// NOTE! It should be more favorable to start waiting from the tail of the queue where 
-		// there are the most recent (and, hence, potentially last to release the lock) readers.
-		// This way, the algorithm should exit with less number iterations.
-		exit_the_loop = !_mutexgear_completion_queue_gettail(&reader_item, &__rwlock->acquired_reads)
-		|| (reader_item == __separator_item && !_mutexgear_completion_queue_getpreceding(&reader_item, &__rwlock->acquired_reads, reader_item)))
+	do
 	{
-		if (!_mutexgear_completion_itemdata_modifyunsafetag(&reader_item->data, rdlock_itemtag_beingwaited, true)
-			&& !rwlock_wrlock_find_notmarked_reader_item(&reader_item, __rwlock, reader_item))
+		// With a fast path reader present, there are no other threads within the queue based implementation and acquired_reads is free
+		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
 		{
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK);
-
-			*__var_readers_till_wp = readers_till_wp;
-			ret = _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY;
 			fault = true;
 			break;
 		}
 
-		ret = _mutexgear_completion_queue_unlockandwait(&__rwlock->acquired_reads, reader_item, __waiter);
-		// access_locked = false; // The unlock in the call above is not allowed to fail
+		ptrdiff_t reader_state = *__var_fastpath_state;
+		// Count both the reader and the current thread in
+		bool reader_attached = _mg_atomic_cas_acqrel_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), __var_fastpath_state, 2 * _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT);
 
-		if (ret != EOK)
+		if (reader_attached)
 		{
-			fault = true;
-			break;
+			// The reader's rdunlock will fail on its fast path and will find the item in acquired_reads after the mutex is released
+			mutexgear_completion_item_t *reader_item = (mutexgear_completion_item_t *)rwlock_fastpath_decodeowner(__rwlock, reader_state);
+			_mutexgear_completion_queue_unsafeenqueue_back(&__rwlock->acquired_reads, reader_item);
 		}
 
-		if (readers_till_wp > 0 && --readers_till_wp == 0)
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+		*__out_attached = reader_attached;
+	}
+	while (false);
+
+	return !fault || (*__out_status = ret, false);
+}
+
+static 
+bool rwlock_fastpath_wait_writer_handover(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, bool *__out_handed_over, int *__out_status)
+{
+	bool fault = false;
+	int ret, mutex_unlock_status, wait_status;
+
+	bool item_initialized = false, wait_lock_acquired = false;
+
+	mutexgear_completion_item_t wait_completion_item;
+	mutexgear_completion_item_t *wait_completion_to_use = __item;
+
+	do
+	{
+		if (__item == NULL)
 		{
-			if ((ret = _mutexgear_completion_queue_enqueue_back(&__rwlock->waiting_writes, __wait_completion_item, NULL)) != EOK)
+			if ((__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_PSHARED) != 0) // In case of shared mode, item parameter must not be NULL
 			{
+				ret = EINVAL;
 				fault = true;
 				break;
 			}
 
-			*__var_readers_till_wp = 0;
+			_mutexgear_completion_item_init(&wait_completion_item);
+			wait_completion_to_use = &wait_completion_item;
+			item_initialized = true;
 		}
 
-		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
+		// Serialize the waiters as a worker only supports a single waiter at a time
+		if ((ret = _mutexgear_lock_acquire(&__rwlock->fastpath_wait_lock)) != EOK)
 		{
 			fault = true;
 			break;
 		}
-		// access_locked = true; -- no failure exits while the mutex is locked
+		wait_lock_acquired = true;
+
+		bool writer_handed_over = false;
+		ptrdiff_t fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
+
+		if ((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK) == _MUTEXGEAR_RWLOCK_FASTPATH_WRITER)
+		{
+			// With a fast path writer present, there are no other threads within the queue based implementation and waiting_writes is empty
+			if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) != EOK)
+			{
+				fault = true;
+				break;
+			}
+
+			if (_mg_atomic_cas_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), &fastpath_state, fastpath_state | _MUTEXGEAR_RWLOCK_FASTPATH_WAITED))
+			{
+				// The writer's wrunlock will fail on its fast path and will block on the waiting_writes mutex until the item is queued
+				mutexgear_completion_worker_t *writer_worker = (mutexgear_completion_worker_t *)rwlock_fastpath_decodeowner(__rwlock, fastpath_state);
+				_mutexgear_completion_item_prestart(wait_completion_to_use, writer_worker);
+				_mutexgear_completion_queue_unsafeenqueue_back(&__rwlock->waiting_writes, wait_completion_to_use);
+
+				// After the wait tag has been published there is no way to cancel the waiting -- the writer will count this thread in
+				uint64_t wait_start = rwlock_stats_beginwait();
+				rwlock_stats_countunlockandwait(__rwlock);
+				MG_CHECK(wait_status, (wait_status = _mutexgear_completion_queue_unlockandwait(&__rwlock->waiting_writes, wait_completion_to_use, __waiter)) == EOK); // No way to handle -- must succeed
+				rwlock_stats_endwait(__rwlock, wait_start);
+				MG_ASSERT(_mutexgear_completion_item_isasinit(wait_completion_to_use));
+
+				writer_handed_over = true;
+			}
+			else
+			{
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
+			}
+		}
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->fastpath_wait_lock)) == EOK); // Should succeed normally
+		wait_lock_acquired = false;
+
+		*__out_handed_over = writer_handed_over;
+	}
+	while (false);
+
+	if (wait_lock_acquired)
+	{
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->fastpath_wait_lock)) == EOK); // Should succeed normally
+	}
+
+	if (item_initialized)
+	{
+		_mutexgear_completion_item_destroy(&wait_completion_item);
 	}
 
 	return !fault || (*__out_status = ret, false);
 }
 
-_MUTEXGEAR_PURE_INLINE
-bool rwlock_wrlock_find_notmarked_reader_item(mutexgear_completion_item_t **__out_reader_item,
-	mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__reader_item)
+static 
+void rwlock_fastpath_handover_waited_writer(mutexgear_rwlock_t *__rwlock, ptrdiff_t __fastpath_state, ptrdiff_t __handover_state)
 {
-	bool success = false;
+	int mutex_lock_status, mutex_unlock_status;
 
-	mutexgear_completion_item_t *reader_item = __reader_item;
-	while (_mutexgear_completion_queue_getpreceding(&reader_item, &__rwlock->acquired_reads, reader_item))
+	MG_ASSERT((__fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK) == (_MUTEXGEAR_RWLOCK_FASTPATH_WRITER | _MUTEXGEAR_RWLOCK_FASTPATH_WAITED));
+
+	MG_CHECK(mutex_lock_status, (mutex_lock_status = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) == EOK); // No way to handle -- must succeed
+
+	mutexgear_completion_item_t *wait_item = _mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->waiting_writes);
+	MG_ASSERT(wait_item != _mutexgear_completion_queue_getend(&__rwlock->waiting_writes));
+
+	_mutexgear_completion_queueditem_unsafefinish__locked(wait_item);
+	// Hand the object over to the waiter with it counted as a thread within the queue based implementation
+	_mg_atomic_store_release_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), __handover_state);
+
+	MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
+
+	mutexgear_completion_worker_t *own_worker = (mutexgear_completion_worker_t *)rwlock_fastpath_decodeowner(__rwlock, __fastpath_state);
+	_mutexgear_completion_queueditem_unsafefinish__unlocked(&__rwlock->waiting_writes, wait_item, own_worker);
+}
+
+static 
+void rwlock_fastpath_wrunlock(mutexgear_rwlock_t *__rwlock, ptrdiff_t __fastpath_state)
+{
+	ptrdiff_t fastpath_state = __fastpath_state;
+
+	if (!rwlock_fastpath_tryrelease(__rwlock, &fastpath_state))
 	{
-		if (_mutexgear_completion_itemdata_modifyunsafetag(&reader_item->data, rdlock_itemtag_beingwaited, true))
+		// Only a waiter could have modified the state by adding the wait tag
+		MG_ASSERT(fastpath_state == (__fastpath_state | _MUTEXGEAR_RWLOCK_FASTPATH_WAITED));
+
+		rwlock_fastpath_handover_waited_writer(__rwlock, fastpath_state, _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT);
+	}
+}
+
+static 
+bool rwlock_fastpath_wrdowngrade(mutexgear_rwlock_t *__rwlock, ptrdiff_t __fastpath_state, 
+	mutexgear_completion_item_t *__item, int *__out_status)
+{
+	bool fault = false;
+	int ret, mutex_unlock_status;
+
+	do
+	{
+		ptrdiff_t fastpath_state = __fastpath_state;
+
+		// The acquire-release order is used to also publish the pre-started item for the contending threads
+		if (_mg_atomic_cas_acqrel_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), &fastpath_state, rwlock_fastpath_encodeowner(__rwlock, __item, _MUTEXGEAR_RWLOCK_FASTPATH_READER)))
 		{
-			success = true;
 			break;
 		}
+
+		// Only a waiter could have modified the state by adding the wait tag
+		MG_ASSERT(fastpath_state == (__fastpath_state | _MUTEXGEAR_RWLOCK_FASTPATH_WAITED));
+
+		// With a fast path writer present, there are no other threads within the queue based implementation and acquired_reads is free
+		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+
+		_mutexgear_completion_queue_unsafeenqueue_back(&__rwlock->acquired_reads, __item);
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+		// Count both the own reader and the waiter in
+		rwlock_fastpath_handover_waited_writer(__rwlock, fastpath_state, 2 * _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT);
 	}
+	while (false);
 
-	return success && (*__out_reader_item = reader_item, true);
+	return !fault || (*__out_status = ret, false);
 }
 
 
+static int _mutexgear_trdl_rwlock_upgradesafe_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/);
+static int _mutexgear_trdl_rwlock_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/);
+static int _mutexgear_rwlock_fastpath_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/);
+static int _mutexgear_rwlock_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/);
+static bool rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
+	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, mutexgear_completion_item_t *__wait_completion_item, int *__out_status);
+static bool rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
+	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, mutexgear_completion_item_t *__wait_completion_item, int *__out_status);
+static bool rwlock_wrlock_wait_all_reads_and_acquire_access(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
+	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, mutexgear_completion_item_t *__wait_completion_item, 
+	mutexgear_completion_item_t *__last_reader_item, int *__out_status);
+_MUTEXGEAR_PURE_INLINE bool rwlock_wrlock_find_notmarked_reader_item(mutexgear_completion_item_t **__out_reader_item,
+	mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__reader_item);
+_MUTEXGEAR_PURE_INLINE int rwlock_adaptivewp_enter(mutexgear_rwlock_t *__rwlock);
+_MUTEXGEAR_PURE_INLINE void rwlock_adaptivewp_leave(mutexgear_rwlock_t *__rwlock);
+_MUTEXGEAR_PURE_INLINE int rwlock_timedwp_makedeadline(uint64_t *__out_wp_deadline, uint64_t __nanoseconds_till_wp);
+_MUTEXGEAR_PURE_INLINE bool rwlock_timedwp_isdeadlinereached(uint64_t __wp_deadline);
+
+/*extern */
+int mutexgear_trdl_rwlock_wrlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+{
+	return _mutexgear_trdl_rwlock_upgradesafe_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+}
+
 /*extern */
-int mutexgear_trdl_rwlock_trywrlock(mutexgear_trdl_rwlock_t *__rwlock)
+int mutexgear_trdl_rwlock_wrlock_cwp(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, int __readers_till_wp)
 {
-	bool success = false;
-	int ret, mutex_unlock_status;
+	int ret;
+
+	if (__readers_till_wp != MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE)
+	{
+		ret = _mutexgear_trdl_rwlock_upgradesafe_wrlock(__readers_till_wp, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+	}
+	else
+	{
+		int adapted_readers_till_wp = rwlock_adaptivewp_enter(&__rwlock->basic_lock);
+		ret = _mutexgear_trdl_rwlock_upgradesafe_wrlock(adapted_readers_till_wp, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+		rwlock_adaptivewp_leave(&__rwlock->basic_lock);
+	}
 
-	bool wrwaits_incremented = false;
+	return ret;
+}
 
-	do
+/*extern */
+int mutexgear_trdl_rwlock_wrlock_twp(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, uint64_t __nanoseconds_till_wp)
+{
+	int ret;
+
+	if (__nanoseconds_till_wp == 0)
 	{
-		mutexgear_completion_item_t *test_tail_item, *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
-		if ((_mutexgear_completion_queue_gettail(&test_tail_item, &__rwlock->basic_lock.acquired_reads), test_tail_item != tryread_queue_separator)
-			|| _mutexgear_completion_queue_getunsafepreceding(tryread_queue_separator) != _mutexgear_completion_queue_getrend(&__rwlock->basic_lock.acquired_reads))
+		ret = _mutexgear_trdl_rwlock_upgradesafe_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+	}
+	else
+	{
+		uint64_t wp_deadline;
+
+		if ((ret = rwlock_timedwp_makedeadline(&wp_deadline, __nanoseconds_till_wp)) == EOK)
 		{
-			ret = EBUSY;
-			break;
+			ret = _mutexgear_trdl_rwlock_upgradesafe_wrlock(_MUTEXGEAR_RWLOCK_TIMEDWP_READERS_TILL_WP, wp_deadline, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
 		}
+	}
 
-		bool tryreads_barrier_required;
-		rwlock_wrlock_increment_wrlock_waits(__rwlock, &tryreads_barrier_required);
-		wrwaits_incremented = true;
+	return ret;
+}
 
-		if (tryreads_barrier_required)
-		{
-			// NOTE: Try-locking here would create a possibility for both of concurrent 
-			// tryrdlock and tryrwlock to return EBUSY on a free object. The tryrdlock 
-			// would abort seeing wrlock_waits being not zero after it had acquired tryread_queue_lock.
-			// The trywrlock would abort on the try-lock operation for the tryread_queue_lock would be here.
-			if ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK)
-			{
-				break;
-			}
+/*extern */
+int mutexgear_trdl_rwlock_wrlock_pri(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, int __writer_class)
+{
+	int ret;
+	unsigned int writer_class;
 
-			// It is more reasonable to signal the barrier within the lock, rather than after it,
-			// as releasing the lock may wake up a higher priority thread and delay the flag appearance for upcoming writes.
-			//
-			// NOTE: // Also, since the operation is serialized with a lock, it can be performed in an unsafe manner for performance sake.
-			rwlock_wrlock_unsafe_record_wrlock_waits_tryread_barrier_pass(__rwlock);
+	if ((ret = rwlock_prioritywp_decodeclass(&writer_class, __writer_class)) == EOK)
+	{
+		ret = _mutexgear_trdl_rwlock_upgradesafe_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, writer_class, __rwlock, __worker, __waiter, __item);
+	}
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
-		}
+	return ret;
+}
 
-		if ((_mutexgear_completion_queue_gettail(&test_tail_item, &__rwlock->basic_lock.acquired_reads), test_tail_item != tryread_queue_separator)
-			|| _mutexgear_completion_queue_getunsafepreceding(tryread_queue_separator) != _mutexgear_completion_queue_getrend(&__rwlock->basic_lock.acquired_reads))
-		{
-			ret = EBUSY;
-			break;
-		}
+/*extern */
+int mutexgear_trdl_rwlock_timedwrlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, const struct timespec *__abs_timeout)
+{
+	return _mutexgear_trdl_rwlock_upgradesafe_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _mutexgear_deadline_fromtimespec(__abs_timeout), MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+}
 
-		// NOTE: All other cases when the acquired_reads mutex can be busy 
-		// (namely, in mutexgear_rwlock_wrlock(), 
-		// rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(), 
-		// rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(), 
-		// rwlock_wrlock_wait_all_reads_and_acquire_access(), mutexgear_rwlock_rdlock(),
-		// rwlock_rdlock_wait_all_writes_and_acquire_access()) either indicate that there 
-		// already are other read locks or the thread owning the acquired_reads 
-		// is itself free to acquire the rwlock for read or write. The busy state while unlocking 
-		// in mutexgear_rwlock_rdunlock() may be considered as if the rwlock is still read-locked.
-		// So, EBUSY result here may be directly returned as the rwlock's try-lock status.
-		if ((ret = _mutexgear_completion_queue_trylock(NULL, &__rwlock->basic_lock.acquired_reads)) != EOK)
-		{
-			break;
-		}
+static 
+int _mutexgear_trdl_rwlock_upgradesafe_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
 
-		bool post_increment_lodempty_check_status = false;
+	bool upgrade_locked = false;
 
-		// Check via the "next" pointers as it is not atomic: atomic access is not needed while the queue is locked
-		if (_mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->basic_lock.acquired_reads) == tryread_queue_separator
-			&& _mutexgear_completion_queue_unsafegetunsafenext(tryread_queue_separator) == _mutexgear_completion_queue_getend(&__rwlock->basic_lock.acquired_reads))
+	do
+	{
+		if (rwlock_upgrade_isenabled(&__rwlock->basic_lock))
 		{
-			post_increment_lodempty_check_status = true;
+			if ((ret = _mutexgear_lock_timedacquire(&__rwlock->basic_lock.upgrade_lock, __lock_deadline)) != EOK)
+			{
+				break;
+			}
+			upgrade_locked = true;
 		}
-		else
+
+		while ((ret = _mutexgear_trdl_rwlock_wrlock(__readers_till_wp, __wp_deadline, __lock_deadline, __writer_class, __rwlock, __worker, __waiter, __item)) == EOK
+			&& rwlock_prioritywp_isoutranked(&__rwlock->basic_lock, __writer_class))
 		{
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+			// Let the higher class writer have the object first and start over
+			rwlock_wrlock_decrement_wrlock_waits(__rwlock);
+			rwlock_prioritywp_yieldaccess(&__rwlock->basic_lock);
 		}
 
-		if (!post_increment_lodempty_check_status)
+		if (ret != EOK)
 		{
-			ret = EBUSY;
 			break;
 		}
 
+		rwlock_optread_enterwrite(&__rwlock->basic_lock);
+
 		success = true;
 	}
 	while (false);
 
-	if (!success)
+	if (upgrade_locked)
 	{
-		if (wrwaits_incremented)
-		{
-			rwlock_wrlock_decrement_wrlock_waits(__rwlock);
-		}
+		// The write lock excludes the upgradable readers on its own after it has been acquired
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->basic_lock.upgrade_lock)) == EOK); // Should succeed normally
 	}
 
 	return success ? EOK : ret;
 }
 
-/*extern */
-int mutexgear_rwlock_trywrlock(mutexgear_rwlock_t *__rwlock)
+static 
+int _mutexgear_trdl_rwlock_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
 {
 	bool success = false;
 	int ret, mutex_unlock_status;
 
+	int readers_till_wp = __readers_till_wp;
+	bool item_initialized = false, wrwaits_incremented = false, write_queued = false, wait_initialized = false, wait_inserted = false;
+	uint64_t wait_start = 0;
+
+	mutexgear_completion_item_t wait_completion_item;
+	mutexgear_completion_item_t *wait_completion_to_use = __item;
+
 	do
 	{
-		bool access_acquired = false;
-
-		if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
+		if (__item == NULL && readers_till_wp >= 0)
 		{
-			// NOTE: All other cases when the acquired_reads mutex can be busy 
-			// (namely, in mutexgear_rwlock_wrlock(), 
-			// rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(), 
-			// rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(), 
-			// rwlock_wrlock_wait_all_reads_and_acquire_access(), mutexgear_rwlock_rdlock(),
-			// rwlock_rdlock_wait_all_writes_and_acquire_access()) either indicate that there 
-			// already are other read locks or the thread owning the acquired_reads 
-			// is itself free to acquire the rwlock for read or write. The busy state while unlocking 
-			// in mutexgear_rwlock_rdunlock() may be considered as if the rwlock is still read-locked.
-			// So, EBUSY result here may be directly returned as the rwlock's try-lock status.
-			if ((ret = _mutexgear_completion_queue_trylock(NULL, &__rwlock->acquired_reads)) != EOK)
+			MG_STATIC_ASSERT(MUTEXGEAR_PROCESS_SHARED != 0);
+
+			if ((__rwlock->basic_lock.fl_un.mode_flags & MUTEXGEAR_PROCESS_SHARED) != 0) // In case of shared mode, item parameter must not be NULL
 			{
+				ret = EINVAL;
 				break;
 			}
 
-			if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
+			_mutexgear_completion_item_init(&wait_completion_item);
+			wait_completion_to_use = &wait_completion_item;
+			item_initialized = true;
+		}
+
+		bool tryreads_barrier_required;
+		rwlock_wrlock_increment_wrlock_waits(__rwlock, &tryreads_barrier_required);
+		wrwaits_incremented = true;
+
+		if (tryreads_barrier_required)
+		{
+			if ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK)
 			{
-				access_acquired = true;
+				break;
 			}
-			else
+
+			// It is more reasonable to signal the barrier within the lock, rather than after it,
+			// as releasing the lock may wake up a higher priority thread and delay the flag appearance for upcoming writes.
+			//
+			// NOTE: // Also, since the operation is serialized with a lock, it can be performed in an unsafe manner for performance sake.
+			rwlock_wrlock_unsafe_record_wrlock_waits_tryread_barrier_pass(__rwlock);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
+		}
+
+		// See the comments in _mutexgear_rwlock_wrlock()
+		const bool handoff_retainable = __item != NULL && readers_till_wp >= 0 && rwlock_handoff_isenabled(&__rwlock->basic_lock);
+		const bool access_trylocked = handoff_retainable || __writer_class != MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL;
+
+		bool access_acquired = false;
+
+		mutexgear_completion_item_t *test_tail_item, *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+		if ((_mutexgear_completion_queue_gettail(&test_tail_item, &__rwlock->basic_lock.acquired_reads), test_tail_item == tryread_queue_separator)
+			&& _mutexgear_completion_queue_getunsafepreceding(tryread_queue_separator) == _mutexgear_completion_queue_getrend(&__rwlock->basic_lock.acquired_reads))
+		{
+			if ((ret = !access_trylocked ? rwlock_wrlock_lock_acquired_reads(&__rwlock->basic_lock) : _mutexgear_completion_queue_trylock(NULL, &__rwlock->basic_lock.acquired_reads)) == EOK)
 			{
-				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+				// Check via the "next" pointers as it is not atomic: atomic access is not needed while the queue is locked
+				if (_mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->basic_lock.acquired_reads) == tryread_queue_separator
+					&& _mutexgear_completion_queue_unsafegetunsafenext(tryread_queue_separator) == _mutexgear_completion_queue_getend(&__rwlock->basic_lock.acquired_reads))
+				{
+					access_acquired = true;
+				}
+				else
+				{
+					// NOTE: Going for registering into waiting_writes with the acquired_reads unlocked
+					// may result in a few extra reads passing into the object. But it is perfectly OK 
+					// as those can be considered as if they would had gained the access even before the 
+					// acquired_reads lock was acquired at all.
+					MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+				}
+			}
+			else if (!access_trylocked || ret != EBUSY)
+			{
+				break;
 			}
 		}
 
 		if (!access_acquired)
 		{
-			ret = EBUSY;
-			break;
+			// The writer is only counted as queued when it has to wait for the access (see mutexgear_rwlock_getstate())
+			rwlock_state_enterqueue(&__rwlock->basic_lock.queued_writes);
+			wait_start = rwlock_stats_beginwait();
+			write_queued = true;
+
+			if (readers_till_wp >= 0)
+			{
+				_mutexgear_completion_item_prestart(wait_completion_to_use, __worker);
+				wait_initialized = true;
+
+				if (readers_till_wp == 0)
+				{
+					if ((ret = rwlock_prioritywp_enqueueitem(&__rwlock->basic_lock, wait_completion_to_use, __writer_class)) != EOK)
+					{
+						break;
+					}
+
+					wait_inserted = true;
+				}
+			}
+
+			mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+			// NOTE: The overhead in rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels() is actually
+			// so minor that it is unclear if it is worth making the two separate implementations. Let it be though.
+			if ((__rwlock->basic_lock.fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) == 0
+				? !rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(&__rwlock->basic_lock, tryread_queue_separator, __waiter, &readers_till_wp, __wp_deadline, __lock_deadline, wait_completion_to_use, &ret)
+				: !rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(&__rwlock->basic_lock, tryread_queue_separator, __waiter, &readers_till_wp, __wp_deadline, __lock_deadline, wait_completion_to_use, &ret))
+			{
+				wait_inserted = readers_till_wp == 0;
+				break;
+			}
+
+			if (readers_till_wp == 0)
+			{
+				if (handoff_retainable)
+				{
+					// The item is kept in waiting_writes to hold the readers back until wrunlock
+					rwlock_handoff_retainitem(&__rwlock->basic_lock, __worker, __item);
+				}
+				else
+				{
+					rwlock_prioritywp_finishitem(&__rwlock->basic_lock, __worker, wait_completion_to_use);
+				}
+				// wait_inserted = false;
+			}
+			else if (readers_till_wp > 0)
+			{
+				_mutexgear_completion_item_reinit(wait_completion_to_use);
+				// wait_initialized = false;
+			}
+		}
+
+		if (item_initialized)
+		{
+			_mutexgear_completion_item_destroy(&wait_completion_item);
 		}
 
+		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item) || __item == __rwlock->basic_lock.handoff_item);
+
 		success = true;
 	}
 	while (false);
 
-	return success ? EOK : ret;
-}
+	if (write_queued)
+	{
+		rwlock_state_leavequeue(&__rwlock->basic_lock.queued_writes);
+		rwlock_stats_endwait(&__rwlock->basic_lock, wait_start);
+	}
 
+	if (!success)
+	{
+		if (wrwaits_incremented)
+		{
+			if (wait_initialized)
+			{
+				if (wait_inserted)
+				{
+					rwlock_prioritywp_finishitem(&__rwlock->basic_lock, __worker, wait_completion_to_use);
+				}
 
-/*extern */
-int mutexgear_trdl_rwlock_wrunlock(mutexgear_trdl_rwlock_t *__rwlock)
-{
-	bool success = false;
-	int ret;
+				_mutexgear_completion_item_reinit(wait_completion_to_use);
+			}
 
-	do
-	{
-		// NOTE: This counter decrement before the unlock may corrupt unrelated memory 
-		// if ___rwlock object is invalid. However, mutex unlock behavior if undefined for 
-		// an invalid argument anyway.
-		//
-		// Checking for the counter to be positive before the decrement is no salvation.
-		//
-		// Moving the decrement after the mutex unlock would allow an unwanted behavior
-		// when another thread at a higher priority would be unblocked due to the mutex 
-		// becoming free, then it would acquire/release the rwlock and might call it again 
-		// for tryrdlock while the object would have the wrlock_waits not decremented yet.
-		rwlock_wrlock_decrement_wrlock_waits(__rwlock);
+			rwlock_wrlock_decrement_wrlock_waits(__rwlock);
+		}
 
-		if ((ret = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) != EOK)
+		if (item_initialized)
 		{
-			break;
+			_mutexgear_completion_item_destroy(&wait_completion_item);
 		}
 
-		success = true;
+		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item));
 	}
-	while (false);
 
 	return success ? EOK : ret;
 }
 
 /*extern */
-int mutexgear_rwlock_wrunlock(mutexgear_rwlock_t *__rwlock)
+int mutexgear_rwlock_wrlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
 {
-	int ret = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads);
-	return ret;
+	return _mutexgear_rwlock_fastpath_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
 }
 
+/*extern */
+int mutexgear_rwlock_wrlock_cwp(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, int __readers_till_wp)
+{
+	int ret;
 
-static int _mutexgear_rwlock_rdlock(mutexgear_completion_item_t *__end_item, mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item);
-static bool rwlock_rdlock_wait_all_writes_and_acquire_access(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item,
-	mutexgear_completion_locktoken_t *__out_readers_lock/*=NULL*/, int *__out_status);
-static bool rwlock_rdlock_wait_write_wait_emptiness(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *last_write_wait,
-	/*bool *__out_waiting_writes_remain_locked, */int *__out_status);
-_MUTEXGEAR_PURE_INLINE mutexgear_dlraitem_t *rwlock_rdlock_link_express_queue_till_rend(mutexgear_dlraitem_t *queue_tail, mutexgear_dlraitem_t *queue_rend);
+	if (__readers_till_wp != MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE)
+	{
+		ret = _mutexgear_rwlock_fastpath_wrlock(__readers_till_wp, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+	}
+	else
+	{
+		int adapted_readers_till_wp = rwlock_adaptivewp_enter(__rwlock);
+		ret = _mutexgear_rwlock_fastpath_wrlock(adapted_readers_till_wp, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+		rwlock_adaptivewp_leave(__rwlock);
+	}
+
+	return ret;
+}
 
 /*extern */
-int mutexgear_trdl_rwlock_rdlock(mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+int mutexgear_rwlock_wrlock_twp(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, uint64_t __nanoseconds_till_wp)
 {
-	mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
-	return _mutexgear_rwlock_rdlock(tryread_queue_separator, &__rwlock->basic_lock, __worker, __waiter, __item);
+	int ret;
+
+	if (__nanoseconds_till_wp == 0)
+	{
+		ret = _mutexgear_rwlock_fastpath_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+	}
+	else
+	{
+		uint64_t wp_deadline;
+
+		if ((ret = rwlock_timedwp_makedeadline(&wp_deadline, __nanoseconds_till_wp)) == EOK)
+		{
+			ret = _mutexgear_rwlock_fastpath_wrlock(_MUTEXGEAR_RWLOCK_TIMEDWP_READERS_TILL_WP, wp_deadline, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+		}
+	}
+
+	return ret;
 }
 
 /*extern */
-int mutexgear_rwlock_rdlock(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+int mutexgear_rwlock_wrlock_pri(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, int __writer_class)
 {
-	mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
-	return _mutexgear_rwlock_rdlock(end_item, __rwlock, __worker, __waiter, __item);
+	int ret;
+	unsigned int writer_class;
+
+	if ((ret = rwlock_prioritywp_decodeclass(&writer_class, __writer_class)) == EOK)
+	{
+		ret = _mutexgear_rwlock_fastpath_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, writer_class, __rwlock, __worker, __waiter, __item);
+	}
+
+	return ret;
 }
 
-static
-int _mutexgear_rwlock_rdlock(mutexgear_completion_item_t *__end_item, mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+/*extern */
+int mutexgear_rwlock_timedwrlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/, const struct timespec *__abs_timeout)
 {
-	MG_ASSERT(!mutexgear_dlraitem_islinked(_mutexgear_completion_item_getworkitem(__item)));
+	return _mutexgear_rwlock_fastpath_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _mutexgear_deadline_fromtimespec(__abs_timeout), MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item);
+}
 
+static 
+int _mutexgear_rwlock_fastpath_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+{
 	bool success = false;
-	int ret, mutex_lock_status, mutex_unlock_status;
+	int ret, mutex_unlock_status;
 
-	bool read_work_started = false, access_locked = false;
+	bool upgrade_locked = false, slow_entered = false;
 
 	do
 	{
-		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		if (rwlock_fastpath_isenabled(__rwlock))
 		{
-			ret = EINVAL;
-			break;
+			// An uncontended fast path writer needs no upgrade_lock: an upgradable reader would keep the fastpath_state non-zero
+			if (rwlock_fastpath_tryacquire(__rwlock, __worker, _MUTEXGEAR_RWLOCK_FASTPATH_WRITER))
+			{
+				if (rwlock_readerbias_isenabled(__rwlock))
+				{
+					rwlock_readerbias_revoke(__rwlock, true);
+				}
+
+				rwlock_optread_enterwrite(__rwlock);
+
+				success = true;
+				break;
+			}
 		}
 
-		bool queued_as_express = false;
+		if (rwlock_upgrade_isenabled(__rwlock))
+		{
+			if ((ret = _mutexgear_lock_timedacquire(&__rwlock->upgrade_lock, __lock_deadline)) != EOK)
+			{
+				break;
+			}
+			upgrade_locked = true;
+		}
 
-		// Optimistically pre-start the item before entering locks
-		_mutexgear_completion_item_prestart(__item, __worker);
-		read_work_started = true;
+		if (rwlock_fastpath_isenabled(__rwlock))
+		{
+			if (!rwlock_fastpath_enter_slow(__rwlock, __waiter, __item, __lock_deadline, &ret))
+			{
+				break;
+			}
+			slow_entered = true;
+		}
 
-		mutexgear_completion_locktoken_t readers_lock_storage, *readers_lock_ptr = NULL;
-		MG_ASSERT((readers_lock_ptr = &readers_lock_storage, true));
+		while ((ret = _mutexgear_rwlock_wrlock(__readers_till_wp, __wp_deadline, __lock_deadline, __writer_class, __rwlock, __worker, __waiter, __item)) == EOK
+			&& rwlock_prioritywp_isoutranked(__rwlock, __writer_class))
+		{
+			// Let the higher class writer have the object first and start over (the count within the queue based implementation is retained)
+			rwlock_prioritywp_yieldaccess(__rwlock);
+		}
 
-		bool linked_into_express_queue = false;
+		if (ret != EOK)
+		{
+			break;
+		}
 
-		if (_mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+		// The readers published in the visible readers table are waited for after the write lock has been acquired regardless of the deadline
+		if (rwlock_readerbias_isenabled(__rwlock))
 		{
-			mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+			rwlock_readerbias_revoke(__rwlock, true);
+		}
 
-			// Set next self-linked to have an indicator that the item is in a single linked list yet
-			_mutexgear_dlraitem_setnext(item_work_item, item_work_item);
+		rwlock_optread_enterwrite(__rwlock);
 
-			mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
-			mutexgear_dlraitem_t *queued_express_last = mutexgear_dlraitem_getprevious(express_reads);
+		if (upgrade_locked)
+		{
+			// The write lock excludes the upgradable readers on its own after it has been acquired
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
+		}
 
-			linked_into_express_queue = true;
-			if ((((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
-				|| (_mutexgear_dlraitem_unsaferesettounlinked(item_work_item), linked_into_express_queue = false, false))
-				&& (_mutexgear_completion_queue_getunsafepreceding(__end_item) != _mutexgear_completion_queue_getrend(&__rwlock->acquired_reads)
-					|| (/*__end_item != _mutexgear_completion_queue_getrend(&__rwlock->acquired_reads) && */_mutexgear_completion_queue_getunsafepreceding(_mutexgear_completion_queue_getrend(&__rwlock->acquired_reads)) != __end_item)))
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (slow_entered)
+		{
+			rwlock_fastpath_leave_slow(__rwlock);
+		}
+
+		if (upgrade_locked)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
+		}
+	}
+
+	return success ? EOK : ret;
+}
+
+static 
+int _mutexgear_rwlock_wrlock(int __readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, unsigned int __writer_class, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	int readers_till_wp = __readers_till_wp;
+	bool item_initialized = false, write_queued = false, wait_initialized = false, wait_inserted = false;
+	uint64_t wait_start = 0;
+
+	mutexgear_completion_item_t wait_completion_item;
+	mutexgear_completion_item_t *wait_completion_to_use = __item;
+
+	do
+	{
+		if (__item == NULL && readers_till_wp >= 0)
+		{
+			MG_STATIC_ASSERT(MUTEXGEAR_PROCESS_SHARED != 0);
+
+			if ((__rwlock->fl_un.mode_flags & MUTEXGEAR_PROCESS_SHARED) != 0) // In case of shared mode, item parameter must not be NULL
 			{
-				queued_as_express = true;
+				ret = EINVAL;
+				break;
 			}
-			else
-			{
-				// NOTE:
-				// Execution must not bail out with an error if the work_item has been linked 
-				// into the express queue -- there is no way to remove the item from there.
-				// Even though the item might have not actually been linked (linking_into_express_queue_failed == true)
-				// returning error in one case and aborting the program in the other case is impractical. 
-				// Muteces do not fail on lock normally, provided they have been preallocated.
-				MG_CHECK(mutex_lock_status, (mutex_lock_status = _mutexgear_completion_queue_lock(readers_lock_ptr, &__rwlock->acquired_reads)) == EOK);
-				// access_locked = true;
 
-				if (linked_into_express_queue || _mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+			_mutexgear_completion_item_init(&wait_completion_item);
+			wait_completion_to_use = &wait_completion_item;
+			item_initialized = true;
+		}
+
+		// In the handoff mode, a writer that is able to keep its item in waiting_writes until wrunlock does not block 
+		// on the mutex of acquired_reads owned by another writer. It queues itself into waiting_writes instead 
+		// to keep the readers off the object until it is served.
+		const bool handoff_retainable = __item != NULL && readers_till_wp >= 0 && rwlock_handoff_isenabled(__rwlock);
+		// A raised class writer does not block on the mutex either as it must be visible in waiting_writes for the lower class writers to let it ahead.
+		const bool access_trylocked = handoff_retainable || __writer_class != MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL;
+
+		bool access_acquired = false;
+
+		if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
+		{
+			if ((ret = !access_trylocked ? rwlock_wrlock_lock_acquired_reads(__rwlock) : _mutexgear_completion_queue_trylock(NULL, &__rwlock->acquired_reads)) == EOK)
+			{
+				if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
 				{
-					access_locked = true;
+					access_acquired = true;
 				}
 				else
 				{
+					// NOTE: Going for registering into waiting_writes with the acquired_reads unlocked
+					// may result in a few extra reads passing into the object. But it is perfectly OK 
+					// as those can be considered as if they would had gained the access even before the 
+					// acquired_reads lock was acquired at all.
 					MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
-					// access_locked = false;
-					MG_ASSERT((readers_lock_storage = NULL, true));
 				}
 			}
+			else if (!access_trylocked || ret != EBUSY)
+			{
+				break;
+			}
 		}
 
-		if (!queued_as_express)
+		if (!access_acquired)
 		{
-			if (!access_locked)
+			// The writer is only counted as queued when it has to wait for the access (see mutexgear_rwlock_getstate())
+			rwlock_state_enterqueue(&__rwlock->queued_writes);
+			wait_start = rwlock_stats_beginwait();
+			write_queued = true;
+
+			if (readers_till_wp >= 0)
 			{
-				if (!rwlock_rdlock_wait_all_writes_and_acquire_access(__rwlock, __worker, __waiter, __item, readers_lock_ptr, &ret))
+				_mutexgear_completion_item_prestart(wait_completion_to_use, __worker);
+				wait_initialized = true;
+
+				if (readers_till_wp == 0)
 				{
-					break;
+					if ((ret = rwlock_prioritywp_enqueueitem(__rwlock, wait_completion_to_use, __writer_class)) != EOK)
+					{
+						break;
+					}
+
+					wait_inserted = true;
 				}
+			}
 
-				// access_locked = true;
+			// NOTE: The overhead in rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels() is actually
+			// so minor that it is unclear if it is worth making the two separate implementations. Let it be though.
+			if ((__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) == 0
+				? !rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(__rwlock, NULL, __waiter, &readers_till_wp, __wp_deadline, __lock_deadline, wait_completion_to_use, &ret)
+				: !rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(__rwlock, NULL, __waiter, &readers_till_wp, __wp_deadline, __lock_deadline, wait_completion_to_use, &ret))
+			{
+				wait_inserted = readers_till_wp == 0;
+				break;
 			}
 
-			mutexgear_dlraitem_t *first_express_read, *last_express_read;
-			bool got_express_reads = false;
+			if (readers_till_wp == 0)
+			{
+				if (handoff_retainable)
+				{
+					// The item is kept in waiting_writes to hold the readers back until wrunlock
+					rwlock_handoff_retainitem(__rwlock, __worker, __item);
+				}
+				else
+				{
+					rwlock_prioritywp_finishitem(__rwlock, __worker, wait_completion_to_use);
+				}
+				// wait_inserted = false;
+			}
+			else if (readers_till_wp > 0)
+			{
+				_mutexgear_completion_item_reinit(wait_completion_to_use);
+				// wait_initialized = false;
+			}
+		}
 
-			// Link own item first to give others a clue that the express queue can already be used...
-			// (even though this can potentially waste two memory writes compared to linking the item 
-			// together with the express queue in case if execution enters that branch)
-			if (!linked_into_express_queue)
+		if (item_initialized)
+		{
+			_mutexgear_completion_item_destroy(&wait_completion_item);
+		}
+
+		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item) || __item == __rwlock->handoff_item);
+
+		success = true;
+	}
+	while (false);
+
+	if (write_queued)
+	{
+		rwlock_state_leavequeue(&__rwlock->queued_writes);
+		rwlock_stats_endwait(__rwlock, wait_start);
+	}
+
+	if (!success)
+	{
+		if (wait_initialized)
+		{
+			if (wait_inserted)
 			{
-				// Increment the commit counter as soon as it is known that a commit will be performed 
-				// to make the beset effort preventing writers from merging within a single reader push lock.
-				_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), 1);
+				rwlock_prioritywp_finishitem(__rwlock, __worker, wait_completion_to_use);
+			}
 
-				_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->acquired_reads, __end_item, __item);
-				MG_ASSERT(readers_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
-				MG_DO_NOTHING(readers_lock_storage); // To suppress unused variable compiler warning
+			_mutexgear_completion_item_reinit(wait_completion_to_use);
+		}
+
+		if (item_initialized)
+		{
+			_mutexgear_completion_item_destroy(&wait_completion_item);
+		}
+
+		MG_ASSERT(__item == NULL || _mutexgear_completion_item_isasinit(__item));
+	}
+
+	return success ? EOK : ret;
+}
+
+static
+bool rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
+	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, mutexgear_completion_item_t *__wait_completion_item, int *__out_status)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool push_locked = false;
+
+	do
+	{
+		if ((ret = rwlock_wrlock_acquire_reader_push_lock(__rwlock, &_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, 0), __lock_deadline)) != EOK)
+		{
+			break;
+		}
+		push_locked = true;
+
+		// The readers push lock is a likely blocking lock, so there is a reason to re-check the acquired reads.
+		// This could, actually, be done within the rwlock_wrlock_wait_all_reads_and_acquire_access() 
+		// but extra checking here unrolls the first pass of the loop without entering the nested function.
+		// 
+		// The code is going to lock acquired_reads anyway, so there is no reason to check for the queue to be empty unlocked.
+		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
+		{
+			break;
+		}
+
+		mutexgear_completion_item_t	*last_reader_item;
+		if (_mutexgear_completion_queue_gettail(&last_reader_item, &__rwlock->acquired_reads) // This is equivalent to emptiness check
+			&& (last_reader_item != __separator_item || _mutexgear_completion_queue_getpreceding(&last_reader_item, &__rwlock->acquired_reads, last_reader_item))
+			&& !rwlock_wrlock_wait_all_reads_and_acquire_access(__rwlock, __separator_item, __waiter, __var_readers_till_wp, __wp_deadline, __lock_deadline, __wait_completion_item, last_reader_item, &ret))
+		{
+			// The unlock for acquired_reads in the call above is not allowed to fail
+
+			// Also, _MUTEXGEAR_RWLOCK_EALLITEMSBUSY cannot be returned
+			MG_ASSERT(ret != _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY);
+
+			break;
+		}
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, 0)) == EOK)); // Should succeed normally
+		// push_locked = false;
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (push_locked)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, 0))) == EOK); // Should succeed normally
+		}
+	}
+
+	return success || (*__out_status = ret, false);
+}
+
+static
+bool rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
+	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, mutexgear_completion_item_t *__wait_completion_item, int *__out_status)
+{
+	bool fault = false;
+	int ret, mutex_unlock_status;
+
+	const unsigned int lock_index_mask = (__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK) >> _MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_SHIFT;
+	unsigned int starting_push_lock_index = (unsigned int)_MUTEXGEAR_RWLOCK_MAKE_READER_PUSH_SELECTOR(__waiter); // OK to truncate, the mask is smaller anyway
+	MG_STATIC_ASSERT(_MUTEXGEAR_RWLOCK_MODE_READERPUSHLOCKS_MASK <= UINT_MAX);
+
+	ptrdiff_t known_express_commits = 0;
+	unsigned int push_lock_index = starting_push_lock_index;
+
+	if ((ret = rwlock_wrlock_acquire_reader_push_lock(__rwlock, &_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask), __lock_deadline)) != EOK)
+	{
+		fault = true;
+	}
+
+	if (!fault)
+	{
+		++push_lock_index;
+
+		known_express_commits = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits));
+	}
+
+	for (; !fault; fault = false)
+	{
+		// The readers push lock is a likely blocking lock, so there is a reason to re-check the acquired reads.
+		// This could, actually, be done within the rwlock_wrlock_wait_all_reads_and_acquire_access() 
+		// but extra checking here unrolls the first pass of the loop without entering the nested function.
+		// 
+		// The code is going to lock acquired_reads anyway, so there is no reason to check for the queue to be empty unlocked.
+		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+
+		mutexgear_completion_item_t	*last_reader_item;
+		if (!_mutexgear_completion_queue_gettail(&last_reader_item, &__rwlock->acquired_reads) // This is equivalent to emptiness check
+			|| (last_reader_item == __separator_item && !_mutexgear_completion_queue_getpreceding(&last_reader_item, &__rwlock->acquired_reads, last_reader_item)))
+		{
+			break;
+		}
+
+		if (rwlock_wrlock_wait_all_reads_and_acquire_access(__rwlock, __separator_item, __waiter, __var_readers_till_wp, __wp_deadline, __lock_deadline, __wait_completion_item, last_reader_item, &ret))
+		{
+			break;
+		}
+		// The unlock for acquired_reads in the call above is not allowed to fail
+
+		if (ret != _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY)
+		{
+			fault = true;
+			break;
+		}
+
+		// Check if express_commits counter changed...
+		ptrdiff_t new_express_commits = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits));
+
+		// ...if not, proceed locking the next mutex
+		if (known_express_commits == new_express_commits)
+		{
+			if ((ret = rwlock_wrlock_acquire_reader_push_lock(__rwlock, &_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask), __lock_deadline)) != EOK)
+			{
+				fault = true;
+				break;
+			}
+
+			++push_lock_index;
+		}
+		// ...if changed, stay with the current locked mutex range and go for one more pass instead
+		else
+		{
+			known_express_commits = new_express_commits;
+		}
+	}
+
+	if (!fault)
+	{
+		bool exit_the_loop;
+		for (exit_the_loop = false; !exit_the_loop; exit_the_loop = push_lock_index == starting_push_lock_index)
+		{
+			--push_lock_index;
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask))) == EOK); // Should succeed normally
+		}
+	}
+
+	if (fault)
+	{
+		while (push_lock_index != starting_push_lock_index)
+		{
+			--push_lock_index;
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&_MUTEXGEAR_RWLOCK_ACCESS_READER_PUSH_LOCK(__rwlock, push_lock_index & lock_index_mask))) == EOK); // Should succeed normally
+		}
+	}
+
+	return !fault || (*__out_status = ret, false);
+}
+
+static
+bool rwlock_wrlock_wait_all_reads_and_acquire_access(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__separator_item,
+	mutexgear_completion_waiter_t *__waiter, int *__var_readers_till_wp, uint64_t __wp_deadline, uint64_t __lock_deadline, mutexgear_completion_item_t *__wait_completion_item, 
+	mutexgear_completion_item_t *__last_reader_item, int *__out_status)
+{
+	bool fault = false;
+	int ret, mutex_unlock_status;
+
+	int readers_till_wp = *__var_readers_till_wp;
+
+	mutexgear_completion_item_t	*reader_item = __last_reader_item;
+	MG_ASSERT(reader_item != NULL);
+
+	// bool access_locked = true;
+
+	bool exit_the_loop;
+	for (exit_the_loop = false; !exit_the_loop;
+		// NOTE! It should be more favorable to start waiting from the tail of the queue where 
+		// there are the most recent (and, hence, potentially last to release the lock) readers.
+		// This way, the algorithm should exit with less number iterations.
+		exit_the_loop = !_mutexgear_completion_queue_gettail(&reader_item, &__rwlock->acquired_reads)
+		|| (reader_item == __separator_item && !_mutexgear_completion_queue_getpreceding(&reader_item, &__rwlock->acquired_reads, reader_item)))
+	{
+		if (!_mutexgear_completion_itemdata_modifyunsafetag(&reader_item->data, rdlock_itemtag_beingwaited, true)
+			&& !rwlock_wrlock_find_notmarked_reader_item(&reader_item, __rwlock, reader_item))
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK);
+
+			*__var_readers_till_wp = readers_till_wp;
+			ret = _MUTEXGEAR_ERRNO__RWLOCK_ALLITEMSBUSY;
+			fault = true;
+			break;
+		}
+
+		rwlock_stats_countunlockandwait(__rwlock);
+		ret = _mutexgear_completion_queue_unlockandtimedwait(&__rwlock->acquired_reads, reader_item, __waiter, __lock_deadline);
+		// access_locked = false; // The unlock in the call above is not allowed to fail
+
+		if (ret != EOK)
+		{
+			if (ret == ETIMEDOUT)
+			{
+				// The wait has been withdrawn with acquired_reads left locked -- unmark the item to let other writers wait for it
+				_mutexgear_completion_itemdata_setunsafetag(&reader_item->data, rdlock_itemtag_beingwaited, false);
+
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+			}
+
+			fault = true;
+			break;
+		}
+
+		if (readers_till_wp > 0 && (--readers_till_wp == 0 || rwlock_timedwp_isdeadlinereached(__wp_deadline)))
+		{
+			readers_till_wp = 0;
+
+			if ((ret = _mutexgear_completion_queue_enqueue_back(&__rwlock->waiting_writes, __wait_completion_item, NULL)) != EOK)
+			{
+				fault = true;
+				break;
+			}
+
+			rwlock_stats_countwpclaim(__rwlock);
+
+			*__var_readers_till_wp = 0;
+		}
+
+		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->acquired_reads)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+		// access_locked = true; -- no failure exits while the mutex is locked
+	}
+
+	return !fault || (*__out_status = ret, false);
+}
+
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_wrlock_find_notmarked_reader_item(mutexgear_completion_item_t **__out_reader_item,
+	mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__reader_item)
+{
+	bool success = false;
+
+	mutexgear_completion_item_t *reader_item = __reader_item;
+	while (_mutexgear_completion_queue_getpreceding(&reader_item, &__rwlock->acquired_reads, reader_item))
+	{
+		if (_mutexgear_completion_itemdata_modifyunsafetag(&reader_item->data, rdlock_itemtag_beingwaited, true))
+		{
+			success = true;
+			break;
+		}
+	}
+
+	return success && (*__out_reader_item = reader_item, true);
+}
+
+_MUTEXGEAR_PURE_INLINE
+int rwlock_adaptivewp_enter(mutexgear_rwlock_t *__rwlock)
+{
+	// Writers finding other writers waiting indicate a write intensive mix where the readers are going to be blocked behind the writers anyway
+	// and an early writer priority only adds more blocking readers. A lone writer among readers, on the other hand, should claim the priority soon
+	// to not be starved by the continuous reads. The thresholds are counted in reader lock releases and thus scale with the read release rate on their own.
+	// Even the biggest threshold is limited so that the writers can't be starved indefinitely.
+	static const int readers_till_wp_by_score[_MUTEXGEAR_RWLOCK_ADAPTIVEWP_SCORE_MAX >> _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SELECTOR_SHIFT] = { 0, 1, 2, 2, 4, 4, 8, 16, };
+
+	ptrdiff_t waiting_writers = _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->adaptivewp_writers), 1);
+
+	// Concurrent updates may occasionally lose a sample -- that is OK for a running average
+	ptrdiff_t score = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->adaptivewp_score));
+	ptrdiff_t new_score = score + ((waiting_writers != 0 ? _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SCORE_MAX : 0) - score) / ((ptrdiff_t)1 << _MUTEXGEAR_RWLOCK_ADAPTIVEWP_AVERAGING_SHIFT);
+	MG_ASSERT(new_score >= 0 && new_score < _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SCORE_MAX);
+
+	if (new_score != score)
+	{
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->adaptivewp_score), new_score);
+	}
+
+	return readers_till_wp_by_score[new_score >> _MUTEXGEAR_RWLOCK_ADAPTIVEWP_SELECTOR_SHIFT];
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_adaptivewp_leave(mutexgear_rwlock_t *__rwlock)
+{
+	_mg_atomic_fetch_sub_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->adaptivewp_writers), 1);
+}
+
+_MUTEXGEAR_PURE_INLINE
+int rwlock_timedwp_makedeadline(uint64_t *__out_wp_deadline, uint64_t __nanoseconds_till_wp)
+{
+	uint64_t current_time;
+	int ret = _mutexgear_clock_getnanoseconds(&current_time);
+
+	if (ret == EOK)
+	{
+		// Saturate the overflowing deadlines just below the "no deadline" value
+		*__out_wp_deadline = __nanoseconds_till_wp < _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE - current_time ? current_time + __nanoseconds_till_wp : _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE - 1;
+	}
+
+	return ret;
+}
+
+_MUTEXGEAR_PURE_INLINE
+bool rwlock_timedwp_isdeadlinereached(uint64_t __wp_deadline)
+{
+	uint64_t current_time;
+	// A clock failure is treated as the deadline having been reached to not let the writer be starved
+	return __wp_deadline != _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE && (_mutexgear_clock_getnanoseconds(&current_time) != EOK || current_time >= __wp_deadline);
+}
+
+
+/*extern */
+int mutexgear_trdl_rwlock_trywrlock(mutexgear_trdl_rwlock_t *__rwlock)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool upgrade_locked = false, wrwaits_incremented = false;
+
+	do
+	{
+		mutexgear_completion_item_t *test_tail_item, *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+		if ((_mutexgear_completion_queue_gettail(&test_tail_item, &__rwlock->basic_lock.acquired_reads), test_tail_item != tryread_queue_separator)
+			|| _mutexgear_completion_queue_getunsafepreceding(tryread_queue_separator) != _mutexgear_completion_queue_getrend(&__rwlock->basic_lock.acquired_reads))
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		// A busy upgrade_lock indicates either an upgradable reader or a competing writer
+		if (rwlock_upgrade_isenabled(&__rwlock->basic_lock))
+		{
+			if ((ret = _mutexgear_lock_tryacquire(&__rwlock->basic_lock.upgrade_lock)) != EOK)
+			{
+				break;
+			}
+			upgrade_locked = true;
+		}
+
+		bool tryreads_barrier_required;
+		rwlock_wrlock_increment_wrlock_waits(__rwlock, &tryreads_barrier_required);
+		wrwaits_incremented = true;
+
+		if (tryreads_barrier_required)
+		{
+			// NOTE: Try-locking here would create a possibility for both of concurrent 
+			// tryrdlock and tryrwlock to return EBUSY on a free object. The tryrdlock 
+			// would abort seeing wrlock_waits being not zero after it had acquired tryread_queue_lock.
+			// The trywrlock would abort on the try-lock operation for the tryread_queue_lock would be here.
+			if ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK)
+			{
+				break;
+			}
+
+			// It is more reasonable to signal the barrier within the lock, rather than after it,
+			// as releasing the lock may wake up a higher priority thread and delay the flag appearance for upcoming writes.
+			//
+			// NOTE: // Also, since the operation is serialized with a lock, it can be performed in an unsafe manner for performance sake.
+			rwlock_wrlock_unsafe_record_wrlock_waits_tryread_barrier_pass(__rwlock);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
+		}
+
+		if ((_mutexgear_completion_queue_gettail(&test_tail_item, &__rwlock->basic_lock.acquired_reads), test_tail_item != tryread_queue_separator)
+			|| _mutexgear_completion_queue_getunsafepreceding(tryread_queue_separator) != _mutexgear_completion_queue_getrend(&__rwlock->basic_lock.acquired_reads))
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		// NOTE: All other cases when the acquired_reads mutex can be busy 
+		// (namely, in mutexgear_rwlock_wrlock(), 
+		// rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(), 
+		// rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(), 
+		// rwlock_wrlock_wait_all_reads_and_acquire_access(), mutexgear_rwlock_rdlock(),
+		// rwlock_rdlock_wait_all_writes_and_acquire_access()) either indicate that there 
+		// already are other read locks or the thread owning the acquired_reads 
+		// is itself free to acquire the rwlock for read or write. The busy state while unlocking 
+		// in mutexgear_rwlock_rdunlock() may be considered as if the rwlock is still read-locked.
+		// So, EBUSY result here may be directly returned as the rwlock's try-lock status.
+		if ((ret = _mutexgear_completion_queue_trylock(NULL, &__rwlock->basic_lock.acquired_reads)) != EOK)
+		{
+			break;
+		}
+
+		bool post_increment_lodempty_check_status = false;
+
+		// Check via the "next" pointers as it is not atomic: atomic access is not needed while the queue is locked
+		if (_mutexgear_completion_queue_unsafegetunsafehead(&__rwlock->basic_lock.acquired_reads) == tryread_queue_separator
+			&& _mutexgear_completion_queue_unsafegetunsafenext(tryread_queue_separator) == _mutexgear_completion_queue_getend(&__rwlock->basic_lock.acquired_reads))
+		{
+			post_increment_lodempty_check_status = true;
+		}
+		else
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+		}
+
+		if (!post_increment_lodempty_check_status)
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		rwlock_optread_enterwrite(&__rwlock->basic_lock);
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (wrwaits_incremented)
+		{
+			rwlock_wrlock_decrement_wrlock_waits(__rwlock);
+		}
+	}
+
+	if (upgrade_locked)
+	{
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->basic_lock.upgrade_lock)) == EOK); // Should succeed normally
+	}
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_rwlock_trywrlock(mutexgear_rwlock_t *__rwlock)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool upgrade_locked = false, slow_entered = false;
+
+	do
+	{
+		// A busy upgrade_lock indicates either an upgradable reader or a competing writer
+		if (rwlock_upgrade_isenabled(__rwlock))
+		{
+			if ((ret = _mutexgear_lock_tryacquire(&__rwlock->upgrade_lock)) != EOK)
+			{
+				break;
+			}
+			upgrade_locked = true;
+		}
+
+		// A try-lock does not have a worker to be used with the fast path but it still needs to be counted in with the queue based implementation
+		if (rwlock_fastpath_isenabled(__rwlock))
+		{
+			if (!rwlock_fastpath_enter_slow(__rwlock, NULL, NULL, _MUTEXGEAR_DEADLINE_INFINITE, &ret))
+			{
+				break;
+			}
+			slow_entered = true;
+		}
+
+		bool access_acquired = false;
+
+		if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
+		{
+			// NOTE: All other cases when the acquired_reads mutex can be busy 
+			// (namely, in mutexgear_rwlock_wrlock(), 
+			// rwlock_wrlock_push_readers_waiting_to_acquire_access__single_channel(), 
+			// rwlock_wrlock_push_readers_waiting_to_acquire_access__multiple_channels(), 
+			// rwlock_wrlock_wait_all_reads_and_acquire_access(), mutexgear_rwlock_rdlock(),
+			// rwlock_rdlock_wait_all_writes_and_acquire_access()) either indicate that there 
+			// already are other read locks or the thread owning the acquired_reads 
+			// is itself free to acquire the rwlock for read or write. The busy state while unlocking 
+			// in mutexgear_rwlock_rdunlock() may be considered as if the rwlock is still read-locked.
+			// So, EBUSY result here may be directly returned as the rwlock's try-lock status.
+			if ((ret = _mutexgear_completion_queue_trylock(NULL, &__rwlock->acquired_reads)) != EOK)
+			{
+				break;
+			}
+
+			if (_mutexgear_completion_queue_lodisempty(&__rwlock->acquired_reads))
+			{
+				access_acquired = true;
+			}
+			else
+			{
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+			}
+		}
+
+		if (!access_acquired)
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		// A try-lock does not wait for the readers published in the visible readers table
+		if (rwlock_readerbias_isenabled(__rwlock) && !rwlock_readerbias_revoke(__rwlock, false))
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+			ret = EBUSY;
+			break;
+		}
+
+		rwlock_optread_enterwrite(__rwlock);
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (slow_entered)
+		{
+			rwlock_fastpath_leave_slow(__rwlock);
+		}
+	}
+
+	if (upgrade_locked)
+	{
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
+	}
+
+	return success ? EOK : ret;
+}
+
+
+/*extern */
+int mutexgear_trdl_rwlock_wrunlock(mutexgear_trdl_rwlock_t *__rwlock)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		// NOTE: This counter decrement before the unlock may corrupt unrelated memory 
+		// if ___rwlock object is invalid. However, mutex unlock behavior if undefined for 
+		// an invalid argument anyway.
+		//
+		// Checking for the counter to be positive before the decrement is no salvation.
+		//
+		// Moving the decrement after the mutex unlock would allow an unwanted behavior
+		// when another thread at a higher priority would be unblocked due to the mutex 
+		// becoming free, then it would acquire/release the rwlock and might call it again 
+		// for tryrdlock while the object would have the wrlock_waits not decremented yet.
+		rwlock_wrlock_decrement_wrlock_waits(__rwlock);
+
+		// The retained item must be taken before the unlock as the next writer is going to store its own one
+		mutexgear_completion_worker_t *handoff_worker;
+		mutexgear_completion_item_t *handoff_item = rwlock_handoff_takeitem(&__rwlock->basic_lock, &handoff_worker);
+
+		// The sequence must be updated before the unlock as the next writer is going to increment it again
+		rwlock_optread_leavewrite(&__rwlock->basic_lock);
+
+		if ((ret = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) != EOK)
+		{
+			rwlock_optread_enterwrite(&__rwlock->basic_lock);
+
+			if (handoff_item != NULL)
+			{
+				rwlock_handoff_retainitem(&__rwlock->basic_lock, handoff_worker, handoff_item);
+			}
+
+			break;
+		}
+
+		if (handoff_item != NULL)
+		{
+			// Removing the item after the unlock lets a queued writer acquire the object before the readers are awakened
+			rwlock_handoff_releaseitem(&__rwlock->basic_lock, handoff_worker, handoff_item);
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_rwlock_wrunlock(mutexgear_rwlock_t *__rwlock)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		// The sequence must be updated before the unlock as the next writer is going to increment it again
+		rwlock_optread_leavewrite(__rwlock);
+
+		bool fastpath_enabled = rwlock_fastpath_isenabled(__rwlock);
+
+		if (fastpath_enabled)
+		{
+			// Only the lock owner can be a fast path writer
+			ptrdiff_t fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
+
+			if ((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_WRITER) != 0)
+			{
+				rwlock_fastpath_wrunlock(__rwlock, fastpath_state);
+
+				success = true;
+				break;
+			}
+		}
+
+		// The retained item must be taken before the unlock as the next writer is going to store its own one
+		mutexgear_completion_worker_t *handoff_worker;
+		mutexgear_completion_item_t *handoff_item = rwlock_handoff_takeitem(__rwlock, &handoff_worker);
+
+		if ((ret = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) != EOK)
+		{
+			rwlock_optread_enterwrite(__rwlock);
+
+			if (handoff_item != NULL)
+			{
+				rwlock_handoff_retainitem(__rwlock, handoff_worker, handoff_item);
+			}
+
+			break;
+		}
+
+		if (handoff_item != NULL)
+		{
+			// Removing the item after the unlock lets a queued writer acquire the object before the readers are awakened
+			rwlock_handoff_releaseitem(__rwlock, handoff_worker, handoff_item);
+		}
+
+		if (fastpath_enabled)
+		{
+			rwlock_fastpath_leave_slow(__rwlock);
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+
+static void rwlock_multiple_sort(mutexgear_rwlock_t **__rwlocks, size_t __rwlock_count);
+static bool rwlock_multiple_tryround(mutexgear_rwlock_t *const *__rwlocks, size_t __rwlock_count, size_t __blocking_index,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, bool *__out_acquired, size_t *__out_busy_index, int *__out_status);
+static bool rwlock_multiple_lockordered(mutexgear_rwlock_t *const *__rwlocks, size_t __rwlock_count,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, int *__out_status);
+static void rwlock_multiple_release(mutexgear_rwlock_t *const *__rwlocks, size_t __blocking_index, size_t __tried_end_index);
+
+/*extern */
+int mutexgear_rwlock_wrlock_multiple(mutexgear_rwlock_t **__rwlocks, size_t __rwlock_count,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		rwlock_multiple_sort(__rwlocks, __rwlock_count);
+
+		// Acquiring an object twice would self-deadlock
+		size_t check_index;
+		for (check_index = 1; check_index < __rwlock_count && __rwlocks[check_index - 1] != __rwlocks[check_index]; ++check_index) {}
+
+		if (check_index < __rwlock_count)
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		bool locks_acquired = __rwlock_count == 0;
+		size_t blocking_index = 0;
+
+		for (unsigned int round_index = 0; !locks_acquired && round_index != MUTEXGEAR_RWLOCK_MULTIPLE_BACKOFF_ROUNDS; ++round_index)
+		{
+			if (round_index != 0)
+			{
+				// Let the owner of the busy object progress before blocking on it
+				_mutexgear_thread_yield();
+			}
+
+			if (!rwlock_multiple_tryround(__rwlocks, __rwlock_count, blocking_index, __worker, __waiter, &locks_acquired, &blocking_index, &ret))
+			{
+				break;
+			}
+		}
+
+		if (!locks_acquired)
+		{
+			if (ret != EBUSY)
+			{
+				break;
+			}
+
+			// Give up backing off and acquire all the objects in the address order
+			if (!rwlock_multiple_lockordered(__rwlocks, __rwlock_count, __worker, __waiter, &ret))
+			{
+				break;
+			}
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_rwlock_wrunlock_multiple(mutexgear_rwlock_t *const *__rwlocks, size_t __rwlock_count)
+{
+	int ret = EOK, unlock_status;
+
+	for (size_t rwlock_index = __rwlock_count; rwlock_index != 0; )
+	{
+		--rwlock_index;
+
+		if ((unlock_status = mutexgear_rwlock_wrunlock(__rwlocks[rwlock_index])) != EOK && ret == EOK)
+		{
+			ret = unlock_status;
+		}
+	}
+
+	return ret;
+}
+
+static 
+void rwlock_multiple_sort(mutexgear_rwlock_t **__rwlocks, size_t __rwlock_count)
+{
+	// The counts are expected to be small -- an insertion sort is sufficient
+	for (size_t sorted_count = 1; sorted_count < __rwlock_count; ++sorted_count)
+	{
+		mutexgear_rwlock_t *inserted_rwlock = __rwlocks[sorted_count];
+
+		size_t insert_index;
+		for (insert_index = sorted_count; insert_index != 0 && (uintptr_t)__rwlocks[insert_index - 1] > (uintptr_t)inserted_rwlock; --insert_index)
+		{
+			__rwlocks[insert_index] = __rwlocks[insert_index - 1];
+		}
+
+		__rwlocks[insert_index] = inserted_rwlock;
+	}
+}
+
+static 
+bool rwlock_multiple_tryround(mutexgear_rwlock_t *const *__rwlocks, size_t __rwlock_count, size_t __blocking_index,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, bool *__out_acquired, size_t *__out_busy_index, int *__out_status)
+{
+	bool fault = false;
+	int ret;
+
+	do
+	{
+		// No other locks are held while blocking
+		if ((ret = mutexgear_rwlock_wrlock(__rwlocks[__blocking_index], __worker, __waiter, NULL)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+
+		size_t tried_index;
+		for (tried_index = 0; tried_index != __rwlock_count; ++tried_index)
+		{
+			if (tried_index != __blocking_index && (ret = mutexgear_rwlock_trywrlock(__rwlocks[tried_index])) != EOK)
+			{
+				break;
+			}
+		}
+
+		if (tried_index == __rwlock_count)
+		{
+			*__out_acquired = true;
+			break;
+		}
+
+		rwlock_multiple_release(__rwlocks, __blocking_index, tried_index);
+
+		if (ret != EBUSY)
+		{
+			fault = true;
+			break;
+		}
+
+		// Report the round failure with EBUSY for the caller to be able to tell it from the lock failures
+		*__out_acquired = false;
+		*__out_busy_index = tried_index;
+		*__out_status = ret;
+	}
+	while (false);
+
+	return !fault || (*__out_status = ret, false);
+}
+
+static 
+bool rwlock_multiple_lockordered(mutexgear_rwlock_t *const *__rwlocks, size_t __rwlock_count,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, int *__out_status)
+{
+	bool fault = false;
+	int ret, unlock_status;
+
+	for (size_t locked_count = 0; locked_count != __rwlock_count; ++locked_count)
+	{
+		if ((ret = mutexgear_rwlock_wrlock(__rwlocks[locked_count], __worker, __waiter, NULL)) != EOK)
+		{
+			while (locked_count != 0)
+			{
+				--locked_count;
+				MG_CHECK(unlock_status, (unlock_status = mutexgear_rwlock_wrunlock(__rwlocks[locked_count])) == EOK); // Should succeed normally
+			}
+
+			fault = true;
+			break;
+		}
+	}
+
+	return !fault || (*__out_status = ret, false);
+}
+
+static 
+void rwlock_multiple_release(mutexgear_rwlock_t *const *__rwlocks, size_t __blocking_index, size_t __tried_end_index)
+{
+	int unlock_status;
+
+	for (size_t rwlock_index = __tried_end_index; rwlock_index != 0; )
+	{
+		--rwlock_index;
+
+		if (rwlock_index != __blocking_index)
+		{
+			MG_CHECK(unlock_status, (unlock_status = mutexgear_rwlock_wrunlock(__rwlocks[rwlock_index])) == EOK); // Should succeed normally
+		}
+	}
+
+	MG_CHECK(unlock_status, (unlock_status = mutexgear_rwlock_wrunlock(__rwlocks[__blocking_index])) == EOK); // Should succeed normally
+}
+
+
+
+static bool rwlock_coupled_checkparameters(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__item,
+	mutexgear_rwlock_t *__parent_rwlock, mutexgear_completion_item_t *__parent_item);
+static int rwlock_coupled_releaseparent(mutexgear_rwlock_t *__parent_rwlock, mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__parent_item);
+
+/*extern */
+int mutexgear_rwlock_rdlock_coupled(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item,
+	mutexgear_rwlock_t *__parent_rwlock, mutexgear_completion_item_t *__parent_item)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		if (!rwlock_coupled_checkparameters(__rwlock, __item, __parent_rwlock, __parent_item))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		if ((ret = mutexgear_rwlock_rdlock(__rwlock, __worker, __waiter, __item)) != EOK)
+		{
+			break;
+		}
+
+		if ((ret = rwlock_coupled_releaseparent(__parent_rwlock, __worker, __parent_item)) != EOK)
+		{
+			break;
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_rwlock_wrlock_coupled(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item,
+	mutexgear_rwlock_t *__parent_rwlock, mutexgear_completion_item_t *__parent_item)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		if (!rwlock_coupled_checkparameters(__rwlock, __item, __parent_rwlock, __parent_item))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		if ((ret = mutexgear_rwlock_wrlock(__rwlock, __worker, __waiter, __item)) != EOK)
+		{
+			break;
+		}
+
+		if ((ret = rwlock_coupled_releaseparent(__parent_rwlock, __worker, __parent_item)) != EOK)
+		{
+			break;
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+static 
+bool rwlock_coupled_checkparameters(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__item,
+	mutexgear_rwlock_t *__parent_rwlock, mutexgear_completion_item_t *__parent_item)
+{
+	// The parent item is linked into the parent object until the child is acquired and must not be reused for the child
+	return __parent_rwlock != NULL
+		? __parent_rwlock != __rwlock && (__parent_item == NULL || __parent_item != __item)
+		: __parent_item == NULL;
+}
+
+static 
+int rwlock_coupled_releaseparent(mutexgear_rwlock_t *__parent_rwlock, mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__parent_item)
+{
+	int ret;
+
+	if (__parent_rwlock == NULL)
+	{
+		ret = EOK;
+	}
+	else if (__parent_item != NULL)
+	{
+		ret = mutexgear_rwlock_rdunlock(__parent_rwlock, __worker, __parent_item);
+	}
+	else
+	{
+		ret = mutexgear_rwlock_wrunlock(__parent_rwlock);
+	}
+
+	return ret;
+}
+
+
+static int _mutexgear_rwlock_readerbias_rdlock(uint64_t __lock_deadline, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item);
+static int _mutexgear_rwlock_fastpath_rdlock(uint64_t __lock_deadline, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item);
+static int _mutexgear_rwlock_rdlock(uint64_t __lock_deadline, mutexgear_completion_item_t *__end_item, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item);
+static bool rwlock_rdlock_wait_all_writes_and_acquire_access(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item, uint64_t __lock_deadline,
+	mutexgear_completion_locktoken_t *__out_readers_lock/*=NULL*/, int *__out_status);
+static bool rwlock_rdlock_wait_write_wait_emptiness(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *last_write_wait, uint64_t __lock_deadline,
+	/*bool *__out_waiting_writes_remain_locked, */int *__out_status);
+_MUTEXGEAR_PURE_INLINE mutexgear_dlraitem_t *rwlock_rdlock_link_express_queue_till_rend(mutexgear_dlraitem_t *queue_tail, mutexgear_dlraitem_t *queue_rend);
+_MUTEXGEAR_PURE_INLINE void rwlock_rdlock_commit_previewed_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, unsigned int skipped_stripe_index);
+_MUTEXGEAR_PURE_INLINE void rwlock_express_commit_stripe(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, mutexgear_dlraitem_t *express_reads);
+
+/*extern */
+int mutexgear_trdl_rwlock_rdlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+	return _mutexgear_rwlock_rdlock(_MUTEXGEAR_DEADLINE_INFINITE, tryread_queue_separator, &__rwlock->basic_lock, __worker, __waiter, __item);
+}
+
+/*extern */
+int mutexgear_trdl_rwlock_timedrdlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item, const struct timespec *__abs_timeout)
+{
+	mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+	return _mutexgear_rwlock_rdlock(_mutexgear_deadline_fromtimespec(__abs_timeout), tryread_queue_separator, &__rwlock->basic_lock, __worker, __waiter, __item);
+}
+
+/*extern */
+int mutexgear_rwlock_rdlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	return _mutexgear_rwlock_readerbias_rdlock(_MUTEXGEAR_DEADLINE_INFINITE, __rwlock, __worker, __waiter, __item);
+}
+
+/*extern */
+int mutexgear_rwlock_timedrdlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item, const struct timespec *__abs_timeout)
+{
+	return _mutexgear_rwlock_readerbias_rdlock(_mutexgear_deadline_fromtimespec(__abs_timeout), __rwlock, __worker, __waiter, __item);
+}
+
+static 
+int _mutexgear_rwlock_readerbias_rdlock(uint64_t __lock_deadline, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		if (rwlock_readerbias_isenabled(__rwlock))
+		{
+			MG_ASSERT(!_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_readerbiased));
+
+			if (rwlock_readerbias_tryrdlock(__rwlock, __item))
+			{
+				rwlock_stats_countread(__rwlock, rwlock_statsread_fastpath);
+
+				success = true;
+				break;
+			}
+		}
+
+		if ((ret = _mutexgear_rwlock_fastpath_rdlock(__lock_deadline, __rwlock, __worker, __waiter, __item)) != EOK)
+		{
+			break;
+		}
+
+		if (rwlock_readerbias_isenabled(__rwlock))
+		{
+			rwlock_readerbias_tryrestore(__rwlock);
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+static 
+int _mutexgear_rwlock_fastpath_rdlock(uint64_t __lock_deadline, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret;
+
+	bool slow_entered = false;
+
+	do
+	{
+		if (rwlock_fastpath_isenabled(__rwlock))
+		{
+			MG_ASSERT(!mutexgear_dlraitem_islinked(_mutexgear_completion_item_getworkitem(__item)));
+
+			if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+			{
+				ret = EINVAL;
+				break;
+			}
+
+			// The item is pre-started so that a contending thread could add it into acquired_reads as is
+			_mutexgear_completion_item_prestart(__item, __worker);
+
+			if (rwlock_fastpath_tryacquire(__rwlock, __item, _MUTEXGEAR_RWLOCK_FASTPATH_READER))
+			{
+				rwlock_stats_countread(__rwlock, rwlock_statsread_fastpath);
+
+				success = true;
+				break;
+			}
+
+			if (!rwlock_fastpath_enter_slow(__rwlock, __waiter, __item, __lock_deadline, &ret))
+			{
+				_mutexgear_completion_item_reinit(__item);
+				break;
+			}
+			slow_entered = true;
+		}
+
+		mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
+		if ((ret = _mutexgear_rwlock_rdlock(__lock_deadline, end_item, __rwlock, __worker, __waiter, __item)) != EOK)
+		{
+			break;
+		}
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (slow_entered)
+		{
+			rwlock_fastpath_leave_slow(__rwlock);
+		}
+	}
+
+	return success ? EOK : ret;
+}
+
+static
+int _mutexgear_rwlock_rdlock(uint64_t __lock_deadline, mutexgear_completion_item_t *__end_item, mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	MG_ASSERT(!mutexgear_dlraitem_islinked(_mutexgear_completion_item_getworkitem(__item)));
+
+	bool success = false;
+	int ret, mutex_lock_status, mutex_unlock_status;
+
+	bool read_work_started = false, access_locked = false;
+
+	do
+	{
+		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		bool queued_as_express = false;
+
+		// Optimistically pre-start the item before entering locks
+		_mutexgear_completion_item_prestart(__item, __worker);
+		read_work_started = true;
+
+		mutexgear_completion_locktoken_t readers_lock_storage, *readers_lock_ptr = NULL;
+		MG_ASSERT((readers_lock_ptr = &readers_lock_storage, true));
+
+		bool linked_into_express_queue = false;
+		unsigned int express_stripe_index = 0;
+
+		if (_mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+		{
+			mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+
+			// Set next self-linked to have an indicator that the item is in a single linked list yet
+			_mutexgear_dlraitem_setnext(item_work_item, item_work_item);
+
+			express_stripe_index = rwlock_express_selectstripe(__rwlock, __worker);
+
+			mutexgear_dlraitem_t *const express_reads = rwlock_express_getstripe(__rwlock, express_stripe_index);
+			mutexgear_dlraitem_t *queued_express_last = mutexgear_dlraitem_getprevious(express_reads);
+
+			linked_into_express_queue = true;
+			if ((((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| ((_mutexgear_dlraitem_setunsafeprevious(item_work_item, queued_express_last), true) && _mutexgear_dlraitem_trysetprevious(express_reads, &queued_express_last, item_work_item))
+				|| (_mutexgear_dlraitem_unsaferesettounlinked(item_work_item), linked_into_express_queue = false, false))
+				&& (_mutexgear_completion_queue_getunsafepreceding(__end_item) != _mutexgear_completion_queue_getrend(&__rwlock->acquired_reads)
+					|| (/*__end_item != _mutexgear_completion_queue_getrend(&__rwlock->acquired_reads) && */_mutexgear_completion_queue_getunsafepreceding(_mutexgear_completion_queue_getrend(&__rwlock->acquired_reads)) != __end_item)))
+			{
+				queued_as_express = true;
+			}
+			else
+			{
+				// NOTE:
+				// Execution must not bail out with an error if the work_item has been linked 
+				// into the express queue -- there is no way to remove the item from there.
+				// Even though the item might have not actually been linked (linking_into_express_queue_failed == true)
+				// returning error in one case and aborting the program in the other case is impractical. 
+				// Muteces do not fail on lock normally, provided they have been preallocated.
+				// The reader is only counted as queued when it has to block on the mutex held by a writer (see mutexgear_rwlock_getstate()).
+				if ((mutex_lock_status = _mutexgear_completion_queue_trylock(readers_lock_ptr, &__rwlock->acquired_reads)) != EOK)
+				{
+					MG_ASSERT(mutex_lock_status == EBUSY);
+
+					rwlock_state_enterqueue(&__rwlock->queued_reads);
+					uint64_t wait_start = rwlock_stats_beginwait();
+					MG_CHECK(mutex_lock_status, (mutex_lock_status = _mutexgear_completion_queue_lock(readers_lock_ptr, &__rwlock->acquired_reads)) == EOK);
+					rwlock_stats_endwait(__rwlock, wait_start);
+					rwlock_state_leavequeue(&__rwlock->queued_reads);
+				}
+				// access_locked = true;
+
+				if (linked_into_express_queue || _mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+				{
+					access_locked = true;
+				}
+				else
+				{
+					MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+					// access_locked = false;
+					MG_ASSERT((readers_lock_storage = NULL, true));
+				}
+			}
+		}
+
+		if (!queued_as_express)
+		{
+			if (!access_locked)
+			{
+				rwlock_state_enterqueue(&__rwlock->queued_reads);
+				uint64_t wait_start = rwlock_stats_beginwait();
+				bool access_acquired = rwlock_rdlock_wait_all_writes_and_acquire_access(__rwlock, __worker, __waiter, __item, __lock_deadline, readers_lock_ptr, &ret);
+				rwlock_stats_endwait(__rwlock, wait_start);
+				rwlock_state_leavequeue(&__rwlock->queued_reads);
+
+				if (!access_acquired)
+				{
+					break;
+				}
+
+				// access_locked = true;
+			}
+
+			mutexgear_dlraitem_t *first_express_read, *last_express_read;
+			bool got_express_reads = false;
+
+			// Link own item first to give others a clue that the express queue can already be used...
+			// (even though this can potentially waste two memory writes compared to linking the item 
+			// together with the express queue in case if execution enters that branch)
+			if (!linked_into_express_queue)
+			{
+				// Increment the commit counter as soon as it is known that a commit will be performed 
+				// to make the beset effort preventing writers from merging within a single reader push lock.
+				_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), 1);
+
+				_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->acquired_reads, __end_item, __item);
+				MG_ASSERT(readers_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
+				MG_DO_NOTHING(readers_lock_storage); // To suppress unused variable compiler warning
+
+				// ... then inspect the express_reads (all the stripes)
+				rwlock_rdlock_commit_previewed_express_reads(__rwlock, __end_item, rwlock_express_getstripemask(__rwlock) + 1);
+			}
+			// ... else just inspect the express_reads
+			else
+			{
+				mutexgear_dlraitem_t *const express_reads = rwlock_express_getstripe(__rwlock, express_stripe_index);
+				mutexgear_dlraitem_t *express_tail_preview = mutexgear_dlraitem_getprevious(express_reads);
+
+				if (express_tail_preview != express_reads)
+				{
+					// Increment the commit counter as soon as it is known that a commit will be performed 
+					// to make the beset effort preventing writers from merging within a single reader push lock.
+					_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), 1);
+
+					mutexgear_dlraitem_t *tail_preview_prev = mutexgear_dlraitem_getprevious(express_tail_preview);
+					MG_ASSERT((_mutexgear_dlraitem_setunsafeprevious(express_tail_preview, express_tail_preview), true)); // To suppress an assertion check in _mutexgear_completion_queue_unsafequeue_before() on the item to be not linked
+
+					// Immediately link the first known item to give others a clue that the express queue can already be used...
+					mutexgear_completion_item_t *tail_preview_item = _mutexgear_completion_item_getfromworkitem(express_tail_preview);
+					_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->acquired_reads, __end_item, tail_preview_item);
+					MG_ASSERT(readers_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
+					MG_DO_NOTHING(readers_lock_storage); // To suppress unused variable compiler warning
+
+					last_express_read = _mutexgear_dlraitem_swapprevious(express_reads, express_reads);
+
+					if (last_express_read != express_tail_preview)
+					{
+						mutexgear_dlraitem_t *tail_preview_next = rwlock_rdlock_link_express_queue_till_rend(last_express_read, express_tail_preview);
+
+						if (tail_preview_prev != express_reads)
+						{
+							_mutexgear_dlraitem_setunsafeprevious(tail_preview_next, tail_preview_prev);
+							_mutexgear_dlraitem_setnext(tail_preview_prev, tail_preview_next);
+
+							first_express_read = rwlock_rdlock_link_express_queue_till_rend(tail_preview_prev, express_reads);
+						}
+						else
+						{
+							first_express_read = tail_preview_next;
+						}
+
+						got_express_reads = true;
+					}
+					else if (tail_preview_prev != express_reads)
+					{
+						last_express_read = tail_preview_prev;
+						first_express_read = rwlock_rdlock_link_express_queue_till_rend(tail_preview_prev, express_reads);
+
+						got_express_reads = true;
+					}
+				}
+
+				// ... and collect the other stripes, if any
+				if (rwlock_express_getstripemask(__rwlock) != 0)
+				{
+					rwlock_rdlock_commit_previewed_express_reads(__rwlock, __end_item, express_stripe_index);
+				}
+			}
+
+			if (got_express_reads)
+			{
+				MG_ASSERT((_mutexgear_dlraitem_setunsafeprevious(first_express_read, first_express_read), true)); // To suppress an assertion check in _mutexgear_completion_queue_unsafemultiqueue_before() on the first item to be not linked
+
+				mutexgear_completion_item_t *last_item = _mutexgear_completion_item_getfromworkitem(last_express_read), *first_item = _mutexgear_completion_item_getfromworkitem(first_express_read);
+				_mutexgear_completion_queue_unsafemultiqueue_before(&__rwlock->acquired_reads, __end_item, first_item, last_item);
+				MG_ASSERT(readers_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
+				MG_DO_NOTHING(readers_lock_storage); // To suppress unused variable compiler warning
+			}
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+			// access_locked = false;
+		}
+
+		rwlock_stats_countread(__rwlock, queued_as_express ? rwlock_statsread_express : rwlock_statsread_slow);
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (read_work_started)
+		{
+			MG_ASSERT(!access_locked);
+
+			_mutexgear_completion_item_reinit(__item);
+		}
+	}
+
+	return success ? EOK : ret;
+}
+
+static
+bool rwlock_rdlock_wait_all_writes_and_acquire_access(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item, uint64_t __lock_deadline,
+	mutexgear_completion_locktoken_t *__out_readers_lock/*=NULL*/, int *__out_status)
+{
+	bool fault = false;
+	int ret, mutex_unlock_status, item_completion_status;
+
+	mutexgear_completion_drainidx_t read_wait_drain_index;
+
+	bool /*access_locked, *//*waiting_reads_locked, */wait_inserted, waiting_writes_locked;
+
+	for (; ; )
+	{
+		/*access_locked = false, *//*waiting_reads_locked = false, */wait_inserted = false, waiting_writes_locked = false;
+
+		mutexgear_completion_locktoken_t waiting_reads_lock_storage, *waiting_reads_lock_ptr = NULL;
+		MG_ASSERT((waiting_reads_lock_ptr = &waiting_reads_lock_storage, true));
+
+		if ((ret = _mutexgear_completion_drainablequeue_lock(waiting_reads_lock_ptr, &__rwlock->waiting_reads)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+		// waiting_reads_locked = true;
+
+		// Get the status in advance as an element is going to be inserted into the queue
+		bool read_wait_queue_was_empty = _mutexgear_completion_drainablequeue_lodisempty(&__rwlock->waiting_reads);
+
+		// NOTE: Here the wait item is speculatively inserted into the waiting_reads list 
+		// even though it may not be necessary there if the waiting_writes list appears to be empty after the lock below.
+		// This is done to separate locked sections of waiting_reads and waiting_writes and remove dependency between them.
+		// On the other hand, consider the situation that the next conditional block is entered. There was already a check above 
+		// that the waiting_writes list was not empty. Since waiting_reads appears in the current function only 
+		// there are no interdependencies with other RWLock operations, and since the read_wait queue appeared empty
+		// (the conditional block is entered by assumption) the current thread was the first to acquire the waiting_reads lock above 
+		// and there was no contest for it. So the lock above was quick and the waiting_writes list can be assumed to remain not empty.
+		// The speculative insertion looks to be reasonable and is very likely to be confirmed to be necessary.
+		//
+		// _mutexgear_completion_item_prestart(__item, __worker); -- the item was alreaddy pre-started in the caller or at the end of the previous loop pass
+		//
+
+		_mutexgear_completion_drainablequeue_unsafeenqueue(&__rwlock->waiting_reads, __item, &read_wait_drain_index);
+		MG_ASSERT(waiting_reads_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
+		MG_DO_NOTHING(waiting_reads_lock_storage); // To suppress unused variable compiler warning
+		wait_inserted = true;
+
+		if (read_wait_queue_was_empty)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_drainablequeue_plainunlock(&__rwlock->waiting_reads)) == EOK); // Should succeed normally
+			// waiting_reads_locked = false;
+			MG_ASSERT((waiting_reads_lock_storage = NULL, true));
+
+			if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) != EOK)
+			{
+				fault = true;
+				break;
+			}
+			waiting_writes_locked = true;
+
+			mutexgear_completion_item_t	*last_write_wait;
+			if (_mutexgear_completion_queue_gettail(&last_write_wait, &__rwlock->waiting_writes)) // This is equivalent for the emptiness check but the code will make use of the item later
+			{
+				// bool waiting_writes_remain_locked;
+				if (!rwlock_rdlock_wait_write_wait_emptiness(__rwlock, __waiter, last_write_wait, __lock_deadline, /*&waiting_writes_remain_locked, */&ret))
+				{
+					// if (waiting_writes_remain_locked)
+					// {
+					// 	MG_CHECK(mutex_unlock_status, (mutex_unlock_status = mutexgear_completion_plain_unlock_queue(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
+					// }
+
+					// waiting_writes_locked = false;
+					fault = true;
+					break;
+				}
+
+			}
+			else
+			{
+				// Getting here means that the waiting writes have been all gone until the lock has been acquired. 
+				// Just release the locks and try again from the start.
+			}
+
+			// Release the write before unlocking the readers so that all the readers had equal chances and, also, there were no readers hitting the locked write waiter queue mutex
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
+			// waiting_writes_locked = false;
+			MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_drainablequeueditem_safefinish(&__rwlock->waiting_reads, __item, __worker, read_wait_drain_index, &__rwlock->read_wait_drain)) == EOK); // No way to handle -- must succeed
+			// wait_inserted = false;
+		}
+		else
+		{
+			mutexgear_completion_item_t *previous_wait = _mutexgear_completion_drainablequeue_unsafegetpreceding(__item);
+			MG_ASSERT(previous_wait != NULL);
+
+			rwlock_stats_countunlockandwait(__rwlock);
+			ret = _mutexgear_completion_drainablequeue_unlockandtimedwait(&__rwlock->waiting_reads, previous_wait, __waiter, __lock_deadline);
+			// waiting_reads_locked = false; // The unlock in the call above is not allowed to fail
+			MG_ASSERT((waiting_reads_lock_storage = NULL, true));
+
+			if (ret != EOK)
+			{
+				if (ret == ETIMEDOUT)
+				{
+					// The wait has been withdrawn with waiting_reads left locked
+					MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_drainablequeue_plainunlock(&__rwlock->waiting_reads)) == EOK); // Should succeed normally
+				}
+
+				fault = true;
+				break;
+			}
+
+			MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_drainablequeueditem_safefinish(&__rwlock->waiting_reads, __item, __worker, MUTEXGEAR_COMPLETION_INVALID_DRAINIDX, NULL)) == EOK);
+			// wait_inserted = false;
+		}
+
+		/*access_locked = false, *//*waiting_reads_locked = false, */wait_inserted = false, waiting_writes_locked = false;
+
+		// Optimistically pre-start the item before entering locked sections to be ready for return into the caller, or for the next loop pass
+		_mutexgear_completion_item_prestart(__item, __worker);
+
+		if ((ret = _mutexgear_completion_queue_lock(__out_readers_lock, &__rwlock->acquired_reads)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+		// access_locked = true;
+
+		if (_mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+		{
+			break;
+		}
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+		// access_locked = false;
+		MG_ASSERT(__out_readers_lock == NULL || (*__out_readers_lock = NULL, true));
+	}
+
+	if (fault)
+	{
+		if (wait_inserted)
+		{
+			if (waiting_writes_locked)
+			{
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
+			}
+
+			MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_drainablequeueditem_safefinish(&__rwlock->waiting_reads, __item, __worker, read_wait_drain_index, &__rwlock->read_wait_drain)) == EOK); // No way to handle -- must succeed
+			// _mutexgear_completion_item_prestart(__item, __worker); -- no need to keep the item pre-started with a failed exit
+		}
+	}
+
+	return !fault || (*__out_status = ret, false);
+}
+
+
+static
+bool rwlock_rdlock_wait_write_wait_emptiness(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *last_write_wait, uint64_t __lock_deadline,
+	/*bool *__out_waiting_writes_remain_locked, */int *__out_status)
+{
+	bool fault = false;
+	int ret;
+
+	// bool waiting_writes_unlocked = false;
+
+	mutexgear_completion_item_t	*write_wait = last_write_wait;
+	MG_ASSERT(write_wait != NULL);
+
+	bool exit_the_loop;
+	for (exit_the_loop = false; !exit_the_loop; exit_the_loop = !_mutexgear_completion_queue_gettail(&write_wait, &__rwlock->waiting_writes))
+	{
+		// NOTE: On ETIMEDOUT, waiting_writes is left locked -- the caller is going to unlock it as it does on success
+		rwlock_stats_countunlockandwait(__rwlock);
+		ret = _mutexgear_completion_queue_unlockandtimedwait(&__rwlock->waiting_writes, write_wait, __waiter, __lock_deadline);
+		// waiting_writes_unlocked = true; // The unlock in the call above is not allowed to fail
+
+		if (ret != EOK)
+		{
+			fault = true;
+			break;
+		}
+
+		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) != EOK)
+		{
+			fault = true;
+			break;
+		}
+		// waiting_writes_unlocked = false;
+	}
+
+	return !fault || (/**__out_waiting_writes_remain_locked = !waiting_writes_unlocked, */*__out_status = ret, false);
+}
+
+_MUTEXGEAR_PURE_INLINE
+mutexgear_dlraitem_t *rwlock_rdlock_link_express_queue_till_rend(mutexgear_dlraitem_t *queue_tail, mutexgear_dlraitem_t *queue_rend)
+{
+	MG_ASSERT(queue_tail != queue_rend);
+
+	mutexgear_dlraitem_t *first_element;
+
+	for (mutexgear_dlraitem_t *previous_element, *current_element = queue_tail; ; current_element = previous_element)
+	{
+		previous_element = mutexgear_dlraitem_getprevious(current_element);
+
+		if (previous_element == queue_rend)
+		{
+			first_element = current_element;
+			break;
+		}
+
+		_mutexgear_dlraitem_setnext(previous_element, current_element);
+	}
+
+	return first_element;
+}
+
+_MUTEXGEAR_PURE_INLINE
+void rwlock_rdlock_commit_previewed_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, unsigned int skipped_stripe_index)
+{
+	unsigned int stripe_index = 0, stripe_mask = rwlock_express_getstripemask(__rwlock);
+
+	do
+	{
+		if (stripe_index != skipped_stripe_index)
+		{
+			// A preview is OK here as the caller has not removed anything from acquired_reads
+			mutexgear_dlraitem_t *const express_reads = rwlock_express_getstripe(__rwlock, stripe_index);
+
+			if (mutexgear_dlraitem_getprevious(express_reads) != express_reads)
+			{
+				rwlock_express_commit_stripe(__rwlock, __end_item, express_reads);
+			}
+		}
+	}
+	while (stripe_index++ != stripe_mask);
+}
+
+
+/*extern */
+int mutexgear_trdl_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool access_locked = false, read_work_started = false/*, tryreads_locked = false*/;
+
+	do
+	{
+		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		if (!rwlock_wrlock_are_zero_wrlock_waits(__rwlock))
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		// Optimistically pre-tag and pre-start the item before entering locks
+		_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_trylocked, true);
+		_mutexgear_completion_item_prestart(__item, __worker);
+		read_work_started = true;
+
+		if ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK)
+		{
+			break;
+		}
+		// tryreads_locked = true;
+
+		if (rwlock_wrlock_are_zero_wrlock_waits(__rwlock))
+		{
+			// Enqueue the item back, after the tryread_queue_separator, as this is a "try-read" section protected with tryread_queue_lock mutex
+			_mutexgear_completion_queue_unsafeenqueue_back(&__rwlock->basic_lock.acquired_reads, __item);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
+			// tryreads_locked = false;
+
+			access_locked = true;
+		}
+		else
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
+			// tryreads_locked = false;
+		}
+
+		if (!access_locked)
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		rwlock_stats_countread(&__rwlock->basic_lock, rwlock_statsread_slow);
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (read_work_started)
+		{
+			// if (tryreads_locked)
+			// {
+			// 	MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
+			// }
+
+			_mutexgear_completion_item_reinit(__item);
+			_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_trylocked, false);
+		}
+
+		MG_ASSERT(!access_locked);
+	}
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_rwlock_tryrdlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool read_work_started = false, slow_entered = false;
+
+	do
+	{
+		MG_ASSERT(!mutexgear_dlraitem_islinked(_mutexgear_completion_item_getworkitem(__item)));
+
+		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		if (rwlock_readerbias_isenabled(__rwlock) && rwlock_readerbias_tryrdlock(__rwlock, __item))
+		{
+			rwlock_stats_countread(__rwlock, rwlock_statsread_fastpath);
+
+			success = true;
+			break;
+		}
+
+		// Obey the write lock priority
+		if (!_mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		// The item is pre-started so that a contending thread could add it into acquired_reads as is
+		_mutexgear_completion_item_prestart(__item, __worker);
+		read_work_started = true;
+
+		if (rwlock_fastpath_isenabled(__rwlock))
+		{
+			if (rwlock_fastpath_tryacquire(__rwlock, __item, _MUTEXGEAR_RWLOCK_FASTPATH_READER))
+			{
+				rwlock_stats_countread(__rwlock, rwlock_statsread_fastpath);
+
+				success = true;
+				break;
+			}
+
+			if (!rwlock_fastpath_enter_slow(__rwlock, NULL, __item, _MUTEXGEAR_DEADLINE_INFINITE, &ret))
+			{
+				break;
+			}
+			slow_entered = true;
+		}
+
+		// The express path is not used as the item can't be withdrawn from there if acquired_reads turns out to be empty.
+		// The mutex of acquired_reads is held by a write lock owner or, momentarily, by readers committing their reads.
+		if ((ret = _mutexgear_completion_queue_trylock(NULL, &__rwlock->acquired_reads)) != EOK)
+		{
+			break;
+		}
+
+		if (!_mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+			ret = EBUSY;
+			break;
+		}
+
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), 1);
+
+		mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
+		_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->acquired_reads, end_item, __item);
+		rwlock_rdlock_commit_previewed_express_reads(__rwlock, end_item, rwlock_express_getstripemask(__rwlock) + 1);
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+		rwlock_stats_countread(__rwlock, rwlock_statsread_slow);
+
+		if (rwlock_readerbias_isenabled(__rwlock))
+		{
+			rwlock_readerbias_tryrestore(__rwlock);
+		}
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (slow_entered)
+		{
+			rwlock_fastpath_leave_slow(__rwlock);
+		}
+
+		if (read_work_started)
+		{
+			_mutexgear_completion_item_reinit(__item);
+		}
+	}
+
+	return success ? EOK : ret;
+}
+
+
+static int _mutexgear_rwlock_rdunlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item);
+_MUTEXGEAR_PURE_INLINE void rwlock_rdunlock_committed_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item);
+_MUTEXGEAR_PURE_INLINE void rwlock_rdunlock_queued_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, 
+	mutexgear_dlraitem_t *item_work_item);
+_MUTEXGEAR_PURE_INLINE unsigned int rwlock_express_findstripe(mutexgear_rwlock_t *__rwlock, mutexgear_dlraitem_t *item_work_item);
+_MUTEXGEAR_PURE_INLINE void rwlock_express_commit_stripe_without_item(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, mutexgear_dlraitem_t *express_reads, 
+	mutexgear_dlraitem_t *item_work_item);
+
+/*extern */
+int mutexgear_trdl_rwlock_rdunlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool access_locked = false;
+
+	do
+	{
+		mutexgear_completion_locktoken_t reads_lock_storage, *reads_lock_ptr = NULL;
+		MG_ASSERT((reads_lock_ptr = &reads_lock_storage, true));
+
+		if ((ret = _mutexgear_completion_queue_lock(reads_lock_ptr, &__rwlock->basic_lock.acquired_reads)) != EOK)
+		{
+			break;
+		}
+		access_locked = true;
+
+		mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+
+		// Check if the item has already been linked into the acquired_reads
+		if (mutexgear_dlraitem_getnext(item_work_item) != item_work_item)
+		{
+			bool tryreads_locked = false;
+
+			if (_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_trylocked)
+				&& ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK || (tryreads_locked = true, false)))
+			{
+				break;
+			}
+
+			// The item must be finished before retrieving the express_reads 
+			// to not create a window when new express_reads items could be added 
+			// with acquired_reads looking not empty for them...
+			_mutexgear_completion_queueditem_unsafefinish__locked(__item);
+			MG_ASSERT(reads_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
+			MG_DO_NOTHING(reads_lock_storage); // To suppress unused variable compiler warning
+
+			if (tryreads_locked)
+			{
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
+			}
+
+			// ...and then it is safe to extract the queued express_reads 
+			mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+			rwlock_rdunlock_committed_commit_express_reads(&__rwlock->basic_lock, tryread_queue_separator);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+
+			_mutexgear_completion_queueditem_unsafefinish__unlocked(&__rwlock->basic_lock.acquired_reads, __item, __worker);
+
+			// Clear rdlock_itemtag_beingwaited tag that might have been set by waiting writes, as well as clear possible rdlock_itemtag_trylocked flag
+			_mutexgear_completion_itemdata_setallunsafetags(&__item->data, false);
+		}
+		else
+		{
+			// ...and then it is safe to extract the queued express_reads 
+			mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+			rwlock_rdunlock_queued_commit_express_reads(&__rwlock->basic_lock, tryread_queue_separator, item_work_item);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+
+			mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+			_mutexgear_dlraitem_unsaferesettounlinked(item_work_item);
+			// Just reinit the item since it did not get into a queue yet
+			_mutexgear_completion_item_reinit(__item);
+
+			// Just check the tag since it could not have been set by writes yet
+			MG_ASSERT(!_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_beingwaited));
+		}
+
+		success = true;
+	}
+	while (false);
+
+	if (!success)
+	{
+		if (access_locked)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+		}
+	}
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_rwlock_rdunlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		if (rwlock_readerbias_isenabled(__rwlock) && _mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_readerbiased))
+		{
+			rwlock_readerbias_rdunlock(__rwlock, __item);
+
+			success = true;
+			break;
+		}
+
+		bool fastpath_enabled = rwlock_fastpath_isenabled(__rwlock);
+
+		if (fastpath_enabled)
+		{
+			ptrdiff_t fastpath_state = rwlock_fastpath_encodeowner(__rwlock, __item, _MUTEXGEAR_RWLOCK_FASTPATH_READER);
+
+			if (rwlock_fastpath_tryrelease(__rwlock, &fastpath_state))
+			{
+				// The item has not been put into any queue
+				_mutexgear_completion_item_reinit(__item);
+
+				success = true;
+				break;
+			}
+		}
+
+		if ((ret = _mutexgear_rwlock_rdunlock(__rwlock, __worker, __item)) != EOK)
+		{
+			break;
+		}
+
+		if (fastpath_enabled)
+		{
+			rwlock_fastpath_leave_slow(__rwlock);
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+static 
+int _mutexgear_rwlock_rdunlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	do
+	{
+		mutexgear_completion_locktoken_t reads_lock_storage, *reads_lock_ptr = NULL;
+		MG_ASSERT((reads_lock_ptr = &reads_lock_storage, true));
+
+		if ((ret = _mutexgear_completion_queue_lock(reads_lock_ptr, &__rwlock->acquired_reads)) != EOK)
+		{
+			break;
+		}
+
+		mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+
+		// Check if the item has already been linked into the acquired_reads
+		if (mutexgear_dlraitem_getnext(item_work_item) != item_work_item)
+		{
+			// The item must be finished before retrieving the express_reads 
+			// to not create a window when new express_reads items could be added 
+			// with acquired_reads looking not empty for them...
+			_mutexgear_completion_queueditem_unsafefinish__locked(__item);
+			MG_ASSERT(reads_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
+			MG_DO_NOTHING(reads_lock_storage); // To suppress unused variable compiler warning
+
+			// ...and then it is safe to extract the queued express_reads 
+			mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
+			rwlock_rdunlock_committed_commit_express_reads(__rwlock, end_item);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+			_mutexgear_completion_queueditem_unsafefinish__unlocked(&__rwlock->acquired_reads, __item, __worker);
+
+			// Clear the tag that might have been set by waiting writes
+			_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_beingwaited, false);
+		}
+		else
+		{
+			// ...and then it is safe to extract the queued express_reads 
+			mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
+			rwlock_rdunlock_queued_commit_express_reads(__rwlock, end_item, item_work_item);
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
+			mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+			_mutexgear_dlraitem_unsaferesettounlinked(item_work_item);
+			// Just reinit the item since it did not get into a queue yet
+			_mutexgear_completion_item_reinit(__item);
+
+			// Just check the tag since it could not have been set by writes yet
+			MG_ASSERT(!_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_beingwaited));
+		}
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+static int _mutexgear_rwlock_optread_begin(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_optread_t *__out_read_sequence);
+static int _mutexgear_rwlock_optread_validate(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_optread_t __read_sequence);
+
+/*extern */
+int mutexgear_trdl_rwlock_optread_begin(mutexgear_trdl_rwlock_t *__rwlock, mutexgear_rwlock_optread_t *__out_read_sequence)
+{
+	return _mutexgear_rwlock_optread_begin(&__rwlock->basic_lock, __out_read_sequence);
+}
+
+/*extern */
+int mutexgear_rwlock_optread_begin(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_optread_t *__out_read_sequence)
+{
+	return _mutexgear_rwlock_optread_begin(__rwlock, __out_read_sequence);
+}
+
+static 
+int _mutexgear_rwlock_optread_begin(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_optread_t *__out_read_sequence)
+{
+	bool success = false;
+	int ret;
+
+	do
+	{
+		// The acquire pairs with the sequence release by the last writer to make its modifications visible to the data reads that follow
+		ptrdiff_t write_sequence = _mg_atomic_load_acquire_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->write_sequence));
+
+		if ((write_sequence & 1) != 0)
+		{
+			ret = EBUSY;
+			break;
+		}
+
+		*__out_read_sequence = write_sequence;
+
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_trdl_rwlock_optread_validate(mutexgear_trdl_rwlock_t *__rwlock, mutexgear_rwlock_optread_t __read_sequence)
+{
+	return _mutexgear_rwlock_optread_validate(&__rwlock->basic_lock, __read_sequence);
+}
+
+/*extern */
+int mutexgear_rwlock_optread_validate(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_optread_t __read_sequence)
+{
+	return _mutexgear_rwlock_optread_validate(__rwlock, __read_sequence);
+}
+
+static 
+int _mutexgear_rwlock_optread_validate(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_optread_t __read_sequence)
+{
+	// The fence keeps the preceding data reads from being reordered after the sequence re-check
+	_mg_atomic_thread_fence_acquire();
+
+	ptrdiff_t write_sequence = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->write_sequence));
+	return write_sequence == __read_sequence ? EOK : EAGAIN;
+}
+
+
+static void _mutexgear_rwlock_getstate(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_state_t *__out_state);
+
+/*extern */
+int mutexgear_trdl_rwlock_getstate(mutexgear_trdl_rwlock_t *__rwlock, mutexgear_rwlock_state_t *__out_state)
+{
+	_mutexgear_rwlock_getstate(&__rwlock->basic_lock, __out_state);
+
+	return EOK;
+}
+
+/*extern */
+int mutexgear_rwlock_getstate(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_state_t *__out_state)
+{
+	_mutexgear_rwlock_getstate(__rwlock, __out_state);
+
+	return EOK;
+}
+
+static 
+void _mutexgear_rwlock_getstate(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_state_t *__out_state)
+{
+	// NOTE: No locks are acquired and the fields are sampled one by one with relaxed loads. 
+	// Therefore, the values may be inconsistent among each other and are only suitable for diagnostics and heuristics.
+	ptrdiff_t queued_writes = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->queued_writes));
+	ptrdiff_t queued_reads = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->queued_reads));
+	bool write_locked = (_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->write_sequence)) & 1) != 0;
+
+	ptrdiff_t active_reads = 0;
+
+	if (rwlock_fastpath_isenabled(__rwlock))
+	{
+		ptrdiff_t fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
+		ptrdiff_t fastpath_kind = fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_KIND_MASK;
+
+		if (fastpath_kind == _MUTEXGEAR_RWLOCK_FASTPATH_READER)
+		{
+			active_reads = 1;
+		}
+		else if (fastpath_kind == 0)
+		{
+			// The threads counted within the queue based implementation, other than the queued ones and the write lock owner, are the read lock owners
+			active_reads = fastpath_state / _MUTEXGEAR_RWLOCK_FASTPATH_SLOWUNIT - queued_writes - queued_reads - (write_locked ? 1 : 0);
+			active_reads = active_reads > 0 ? active_reads : 0;
+		}
+	}
+
+	if (rwlock_readerbias_isenabled(__rwlock))
+	{
+		active_reads += rwlock_readerbias_countreaders(__rwlock);
+	}
+
+	__out_state->active_readers = (size_t)active_reads;
+	__out_state->queued_writers = queued_writes > 0 ? (size_t)queued_writes : 0;
+	__out_state->queued_readers = queued_reads > 0 ? (size_t)queued_reads : 0;
+	__out_state->write_locked = write_locked;
+}
+
+
+static int _mutexgear_rwlock_getstats(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_stats_t *__out_stats);
+
+/*extern */
+int mutexgear_trdl_rwlock_getstats(mutexgear_trdl_rwlock_t *__rwlock, mutexgear_rwlock_stats_t *__out_stats)
+{
+	return _mutexgear_rwlock_getstats(&__rwlock->basic_lock, __out_stats);
+}
+
+/*extern */
+int mutexgear_rwlock_getstats(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_stats_t *__out_stats)
+{
+	return _mutexgear_rwlock_getstats(__rwlock, __out_stats);
+}
+
+static 
+int _mutexgear_rwlock_getstats(mutexgear_rwlock_t *__rwlock, mutexgear_rwlock_stats_t *__out_stats)
+{
+#if defined(_MUTEXGEAR_WITH_STATS)
+	// NOTE: The counters are sampled one by one with relaxed loads the same way as the state is in _mutexgear_rwlock_getstate()
+	__out_stats->fastpath_reads = _mutexgear_stats_getvalue(&__rwlock->stats.fastpath_reads);
+	__out_stats->express_reads = _mutexgear_stats_getvalue(&__rwlock->stats.express_reads);
+	__out_stats->slow_reads = _mutexgear_stats_getvalue(&__rwlock->stats.slow_reads);
+	__out_stats->writes = _mutexgear_stats_getvalue(&__rwlock->stats.writes);
+	__out_stats->writer_priority_claims = _mutexgear_stats_getvalue(&__rwlock->stats.writer_priority_claims);
+	__out_stats->reader_push_lock_waits = _mutexgear_stats_getvalue(&__rwlock->stats.reader_push_lock_waits);
+	__out_stats->unlockandwaits = _mutexgear_stats_getvalue(&__rwlock->stats.unlockandwaits);
+	__out_stats->total_wait_ns = _mutexgear_stats_getvalue(&__rwlock->stats.total_wait_ns);
+	__out_stats->max_wait_ns = _mutexgear_stats_getvalue(&__rwlock->stats.max_wait_ns);
+	__out_stats->total_hold_ns = _mutexgear_stats_getvalue(&__rwlock->stats.total_hold_ns);
+	__out_stats->max_hold_ns = _mutexgear_stats_getvalue(&__rwlock->stats.max_hold_ns);
+
+	return EOK;
+#else
+	MG_DO_NOTHING(__rwlock);
+	MG_DO_NOTHING(__out_stats);
+
+	return ENOSYS;
+#endif
+}
+
+
+/*extern */
+int mutexgear_trdl_rwlock_wrdowngrade(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	do
+	{
+		// A retained item (possibly, the same one as __item) is released first as the object is going to be open for the readers
+		mutexgear_completion_worker_t *handoff_worker;
+		mutexgear_completion_item_t *handoff_item = rwlock_handoff_takeitem(&__rwlock->basic_lock, &handoff_worker);
+
+		if (handoff_item != NULL)
+		{
+			rwlock_handoff_releaseitem(&__rwlock->basic_lock, handoff_worker, handoff_item);
+		}
+
+		MG_ASSERT(!mutexgear_dlraitem_islinked(_mutexgear_completion_item_getworkitem(__item)));
+
+		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		// Increment the commit counter as soon as it is known that a commit will be performed 
+		// to make the beset effort preventing writers from merging within a single reader push lock.
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->basic_lock.express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->basic_lock.express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->basic_lock.express_commits), 1);
+
+		// The write lock owns the mutex of acquired_reads and the queue is only holding the separator item
+		mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
+		_mutexgear_completion_item_prestart(__item, __worker);
+		_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->basic_lock.acquired_reads, tryread_queue_separator, __item);
+
+		// Admit the readers that have managed to queue themselves as express ones together with the own item
+		rwlock_rdunlock_committed_commit_express_reads(&__rwlock->basic_lock, tryread_queue_separator);
 
-				// ... then inspect the express_reads
-				mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
-				mutexgear_dlraitem_t *express_tail_preview = mutexgear_dlraitem_getprevious(express_reads);
+		// See the comment in mutexgear_trdl_rwlock_wrunlock() on the decrement order
+		rwlock_wrlock_decrement_wrlock_waits(__rwlock);
 
-				if (express_tail_preview != express_reads)
-				{
-					last_express_read = _mutexgear_dlraitem_swapprevious(express_reads, express_reads);
-					first_express_read = rwlock_rdlock_link_express_queue_till_rend(last_express_read, express_reads);
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
 
-					got_express_reads = true;
-				}
-			}
-			// ... else just inspect the express_reads
-			else
-			{
-				mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
-				mutexgear_dlraitem_t *express_tail_preview = mutexgear_dlraitem_getprevious(express_reads);
+		success = true;
+	}
+	while (false);
 
-				if (express_tail_preview != express_reads)
-				{
-					// Increment the commit counter as soon as it is known that a commit will be performed 
-					// to make the beset effort preventing writers from merging within a single reader push lock.
-					_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), 1);
+	if (success)
+	{
+		// The sequence can be updated after the downgrade as the own read lock keeps other writers out
+		rwlock_optread_leavewrite(&__rwlock->basic_lock);
+	}
 
-					mutexgear_dlraitem_t *tail_preview_prev = mutexgear_dlraitem_getprevious(express_tail_preview);
-					MG_ASSERT((_mutexgear_dlraitem_setunsafeprevious(express_tail_preview, express_tail_preview), true)); // To suppress an assertion check in _mutexgear_completion_queue_unsafequeue_before() on the item to be not linked
+	return success ? EOK : ret;
+}
 
-					// Immediately link the first known item to give others a clue that the express queue can already be used...
-					mutexgear_completion_item_t *tail_preview_item = _mutexgear_completion_item_getfromworkitem(express_tail_preview);
-					_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->acquired_reads, __end_item, tail_preview_item);
-					MG_ASSERT(readers_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
-					MG_DO_NOTHING(readers_lock_storage); // To suppress unused variable compiler warning
+/*extern */
+int mutexgear_rwlock_wrdowngrade(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
 
-					last_express_read = _mutexgear_dlraitem_swapprevious(express_reads, express_reads);
+	do
+	{
+		// A retained item (possibly, the same one as __item) is released first as the object is going to be open for the readers.
+		// A fast path writer never has one.
+		mutexgear_completion_worker_t *handoff_worker;
+		mutexgear_completion_item_t *handoff_item = rwlock_handoff_takeitem(__rwlock, &handoff_worker);
 
-					if (last_express_read != express_tail_preview)
-					{
-						mutexgear_dlraitem_t *tail_preview_next = rwlock_rdlock_link_express_queue_till_rend(last_express_read, express_tail_preview);
+		if (handoff_item != NULL)
+		{
+			rwlock_handoff_releaseitem(__rwlock, handoff_worker, handoff_item);
+		}
 
-						if (tail_preview_prev != express_reads)
-						{
-							_mutexgear_dlraitem_setunsafeprevious(tail_preview_next, tail_preview_prev);
-							_mutexgear_dlraitem_setnext(tail_preview_prev, tail_preview_next);
+		MG_ASSERT(!mutexgear_dlraitem_islinked(_mutexgear_completion_item_getworkitem(__item)));
 
-							first_express_read = rwlock_rdlock_link_express_queue_till_rend(tail_preview_prev, express_reads);
-						}
-						else
-						{
-							first_express_read = tail_preview_next;
-						}
+		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		{
+			ret = EINVAL;
+			break;
+		}
 
-						got_express_reads = true;
-					}
-					else if (tail_preview_prev != express_reads)
-					{
-						last_express_read = tail_preview_prev;
-						first_express_read = rwlock_rdlock_link_express_queue_till_rend(tail_preview_prev, express_reads);
+		// The item is pre-started so that it could either become a fast path reader or be queued into acquired_reads as is
+		_mutexgear_completion_item_prestart(__item, __worker);
 
-						got_express_reads = true;
-					}
-				}
-			}
+		if (rwlock_fastpath_isenabled(__rwlock))
+		{
+			// Only the lock owner can be a fast path writer
+			ptrdiff_t fastpath_state = _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->fastpath_state));
 
-			if (got_express_reads)
+			if ((fastpath_state & _MUTEXGEAR_RWLOCK_FASTPATH_WRITER) != 0)
 			{
-				MG_ASSERT((_mutexgear_dlraitem_setunsafeprevious(first_express_read, first_express_read), true)); // To suppress an assertion check in _mutexgear_completion_queue_unsafemultiqueue_before() on the first item to be not linked
+				if (!rwlock_fastpath_wrdowngrade(__rwlock, fastpath_state, __item, &ret))
+				{
+					_mutexgear_completion_item_reinit(__item);
+					break;
+				}
 
-				mutexgear_completion_item_t *last_item = _mutexgear_completion_item_getfromworkitem(last_express_read), *first_item = _mutexgear_completion_item_getfromworkitem(first_express_read);
-				_mutexgear_completion_queue_unsafemultiqueue_before(&__rwlock->acquired_reads, __end_item, first_item, last_item);
-				MG_ASSERT(readers_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
-				MG_DO_NOTHING(readers_lock_storage); // To suppress unused variable compiler warning
+				success = true;
+				break;
 			}
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
-			// access_locked = false;
+			// The thread's count within the queue based implementation is retained for the read lock
 		}
 
+		// Increment the commit counter as soon as it is known that a commit will be performed 
+		// to make the beset effort preventing writers from merging within a single reader push lock.
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(&__rwlock->express_commits)) + 1); // _mg_atomic_fetch_add_relaxed_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->express_commits), 1);
+
+		// The write lock owns the mutex of acquired_reads and the queue is empty
+		mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
+		_mutexgear_completion_queue_unsafeenqueue_before(&__rwlock->acquired_reads, end_item, __item);
+
+		// Admit the readers that have managed to queue themselves as express ones together with the own item
+		rwlock_rdunlock_committed_commit_express_reads(__rwlock, end_item);
+
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+
 		success = true;
 	}
 	while (false);
 
-	if (!success)
+	if (success)
 	{
-		if (read_work_started)
-		{
-			MG_ASSERT(!access_locked);
-
-			_mutexgear_completion_item_reinit(__item);
-		}
+		// The sequence can be updated after the downgrade as the own read lock keeps other writers out
+		rwlock_optread_leavewrite(__rwlock);
 	}
 
 	return success ? EOK : ret;
 }
 
 static
-bool rwlock_rdlock_wait_all_writes_and_acquire_access(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item,
-	mutexgear_completion_locktoken_t *__out_readers_lock/*=NULL*/, int *__out_status)
+void rwlock_execute_runrequests(mutexgear_rwlock_t *__rwlock)
 {
-	bool fault = false;
-	int ret, mutex_unlock_status, item_completion_status;
+	// The requests submitted while the previous ones are being executed are taken as well to let them share the write lock
+	_mutexgear_rwlock_executerequest_t *request_list;
 
-	mutexgear_completion_drainidx_t read_wait_drain_index;
+	while ((request_list = rwlock_execute_extractrequests(__rwlock)) != NULL)
+	{
+		do
+		{
+			_mutexgear_rwlock_executerequest_t *current_request = request_list;
+			request_list = current_request->next_request;
 
-	bool /*access_locked, *//*waiting_reads_locked, */wait_inserted, waiting_writes_locked;
+			current_request->execute_proc(current_request->execute_context);
+			// The owner is blocked on execute_lock and will find the flag after this thread releases the lock
+			current_request->request_executed = true;
+		}
+		while (request_list != NULL);
+	}
+}
 
-	for (; ; )
+static
+void rwlock_execute_withdrawrequest(mutexgear_rwlock_t *__rwlock, _mutexgear_rwlock_executerequest_t *__request)
+{
+	// With execute_lock held, no other thread can extract the requests and the own one must still be there
+	_mutexgear_rwlock_executerequest_t *request_list = rwlock_execute_extractrequests(__rwlock);
+	MG_ASSERT(request_list != NULL);
+
+	while (request_list != NULL)
 	{
-		/*access_locked = false, *//*waiting_reads_locked = false, */wait_inserted = false, waiting_writes_locked = false;
+		_mutexgear_rwlock_executerequest_t *current_request = request_list;
+		request_list = current_request->next_request;
 
-		mutexgear_completion_locktoken_t waiting_reads_lock_storage, *waiting_reads_lock_ptr = NULL;
-		MG_ASSERT((waiting_reads_lock_ptr = &waiting_reads_lock_storage, true));
+		if (current_request != __request)
+		{
+			rwlock_execute_submitrequest(__rwlock, current_request);
+		}
+	}
+}
 
-		if ((ret = _mutexgear_completion_drainablequeue_lock(waiting_reads_lock_ptr, &__rwlock->waiting_reads)) != EOK)
+static 
+int _mutexgear_rwlock_wrexecute(mutexgear_rwlock_t *__rwlock, mutexgear_trdl_rwlock_t *__trdl_rwlock/*=NULL*/,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/,
+	mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context)
+{
+	bool success = false;
+	int ret, mutex_lock_status, mutex_unlock_status, wrunlock_status;
+
+	_mutexgear_rwlock_executerequest_t execute_request;
+
+	do
+	{
+		if ((__rwlock->fl_un.mode_flags & _MUTEXGEAR_RWLOCK_MODE_PSHARED) != 0) // The request procedures are not accessible in other processes
 		{
-			fault = true;
+			ret = EINVAL;
 			break;
 		}
-		// waiting_reads_locked = true;
-
-		// Get the status in advance as an element is going to be inserted into the queue
-		bool read_wait_queue_was_empty = _mutexgear_completion_drainablequeue_lodisempty(&__rwlock->waiting_reads);
 
-		// NOTE: Here the wait item is speculatively inserted into the waiting_reads list 
-		// even though it may not be necessary there if the waiting_writes list appears to be empty after the lock below.
-		// This is done to separate locked sections of waiting_reads and waiting_writes and remove dependency between them.
-		// On the other hand, consider the situation that the next conditional block is entered. There was already a check above 
-		// that the waiting_writes list was not empty. Since waiting_reads appears in the current function only 
-		// there are no interdependencies with other RWLock operations, and since the read_wait queue appeared empty
-		// (the conditional block is entered by assumption) the current thread was the first to acquire the waiting_reads lock above 
-		// and there was no contest for it. So the lock above was quick and the waiting_writes list can be assumed to remain not empty.
-		// The speculative insertion looks to be reasonable and is very likely to be confirmed to be necessary.
-		//
-		// _mutexgear_completion_item_prestart(__item, __worker); -- the item was alreaddy pre-started in the caller or at the end of the previous loop pass
-		//
+		execute_request.execute_proc = __execute_proc;
+		execute_request.execute_context = __execute_context;
+		execute_request.request_executed = false;
+		rwlock_execute_submitrequest(__rwlock, &execute_request);
 
-		_mutexgear_completion_drainablequeue_unsafeenqueue(&__rwlock->waiting_reads, __item, &read_wait_drain_index);
-		MG_ASSERT(waiting_reads_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
-		MG_DO_NOTHING(waiting_reads_lock_storage); // To suppress unused variable compiler warning
-		wait_inserted = true;
+		// After the submission, the request can only be abandoned after it has been executed or withdrawn
+		MG_CHECK(mutex_lock_status, (mutex_lock_status = _mutexgear_lock_acquire(&__rwlock->execute_lock)) == EOK); // No way to handle -- must succeed
 
-		if (read_wait_queue_was_empty)
+		// If the request has not been executed by the preceding lock owner, the thread is to execute all the pending requests itself
+		if (!execute_request.request_executed)
 		{
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_drainablequeue_plainunlock(&__rwlock->waiting_reads)) == EOK); // Should succeed normally
-			// waiting_reads_locked = false;
-			MG_ASSERT((waiting_reads_lock_storage = NULL, true));
-
-			if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) != EOK)
+			if ((ret = __trdl_rwlock == NULL
+				? mutexgear_rwlock_wrlock(__rwlock, __worker, __waiter, __item)
+				: mutexgear_trdl_rwlock_wrlock(__trdl_rwlock, __worker, __waiter, __item)) != EOK)
 			{
-				fault = true;
+				// Leave the other requests to the threads that submitted them
+				rwlock_execute_withdrawrequest(__rwlock, &execute_request);
+
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->execute_lock)) == EOK); // Should succeed normally
 				break;
 			}
-			waiting_writes_locked = true;
 
-			mutexgear_completion_item_t	*last_write_wait;
-			if (_mutexgear_completion_queue_gettail(&last_write_wait, &__rwlock->waiting_writes)) // This is equivalent for the emptiness check but the code will make use of the item later
-			{
-				// bool waiting_writes_remain_locked;
-				if (!rwlock_rdlock_wait_write_wait_emptiness(__rwlock, __waiter, last_write_wait, /*&waiting_writes_remain_locked, */&ret))
-				{
-					// if (waiting_writes_remain_locked)
-					// {
-					// 	MG_CHECK(mutex_unlock_status, (mutex_unlock_status = mutexgear_completion_plain_unlock_queue(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
-					// }
+			rwlock_execute_runrequests(__rwlock);
+			MG_ASSERT(execute_request.request_executed);
 
-					// waiting_writes_locked = false;
-					fault = true;
-					break;
-				}
+			MG_CHECK(wrunlock_status, (wrunlock_status = __trdl_rwlock == NULL
+				? mutexgear_rwlock_wrunlock(__rwlock)
+				: mutexgear_trdl_rwlock_wrunlock(__trdl_rwlock)) == EOK); // Should succeed normally
+		}
 
-			}
-			else
-			{
-				// Getting here means that the waiting writes have been all gone until the lock has been acquired. 
-				// Just release the locks and try again from the start.
-			}
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->execute_lock)) == EOK); // Should succeed normally
 
-			// Release the write before unlocking the readers so that all the readers had equal chances and, also, there were no readers hitting the locked write waiter queue mutex
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
-			// waiting_writes_locked = false;
-			MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_drainablequeueditem_safefinish(&__rwlock->waiting_reads, __item, __worker, read_wait_drain_index, &__rwlock->read_wait_drain)) == EOK); // No way to handle -- must succeed
-			// wait_inserted = false;
+		success = true;
+	}
+	while (false);
+
+	return success ? EOK : ret;
+}
+
+/*extern */
+int mutexgear_trdl_rwlock_wrexecute(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/,
+	mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context)
+{
+	return _mutexgear_rwlock_wrexecute(&__rwlock->basic_lock, __rwlock, __worker, __waiter, __item, __execute_proc, __execute_context);
+}
+
+/*extern */
+int mutexgear_rwlock_wrexecute(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item/*=NULL*/,
+	mutexgear_rwlock_execute_fn_t __execute_proc, void *__execute_context)
+{
+	return _mutexgear_rwlock_wrexecute(__rwlock, NULL, __worker, __waiter, __item, __execute_proc, __execute_context);
+}
+
+
+/*extern */
+int mutexgear_trdl_rwlock_uprdlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
+
+	bool upgrade_locked = false;
+
+	do
+	{
+		if (!rwlock_upgrade_isenabled(&__rwlock->basic_lock))
+		{
+			ret = EINVAL;
+			break;
 		}
-		else
+
+		if ((ret = _mutexgear_lock_acquire(&__rwlock->basic_lock.upgrade_lock)) != EOK)
 		{
-			mutexgear_completion_item_t *previous_wait = _mutexgear_completion_drainablequeue_unsafegetpreceding(__item);
-			MG_ASSERT(previous_wait != NULL);
+			break;
+		}
+		upgrade_locked = true;
 
-			ret = _mutexgear_completion_drainablequeue_unlockandwait(&__rwlock->waiting_reads, previous_wait, __waiter);
-			// waiting_reads_locked = false; // The unlock in the call above is not allowed to fail
-			MG_ASSERT((waiting_reads_lock_storage = NULL, true));
+		if ((ret = mutexgear_trdl_rwlock_rdlock(__rwlock, __worker, __waiter, __item)) != EOK)
+		{
+			break;
+		}
 
-			if (ret != EOK)
-			{
-				fault = true;
-				break;
-			}
+		success = true;
+	}
+	while (false);
 
-			MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_drainablequeueditem_safefinish(&__rwlock->waiting_reads, __item, __worker, MUTEXGEAR_COMPLETION_INVALID_DRAINIDX, NULL)) == EOK);
-			// wait_inserted = false;
+	if (!success)
+	{
+		if (upgrade_locked)
+		{
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->basic_lock.upgrade_lock)) == EOK); // Should succeed normally
 		}
+	}
 
-		/*access_locked = false, *//*waiting_reads_locked = false, */wait_inserted = false, waiting_writes_locked = false;
+	return success ? EOK : ret;
+}
 
-		// Optimistically pre-start the item before entering locked sections to be ready for return into the caller, or for the next loop pass
-		_mutexgear_completion_item_prestart(__item, __worker);
+/*extern */
+int mutexgear_rwlock_uprdlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
+{
+	bool success = false;
+	int ret, mutex_unlock_status;
 
-		if ((ret = _mutexgear_completion_queue_lock(__out_readers_lock, &__rwlock->acquired_reads)) != EOK)
+	bool upgrade_locked = false;
+
+	do
+	{
+		if (!rwlock_upgrade_isenabled(__rwlock))
+		{
+			ret = EINVAL;
+			break;
+		}
+
+		if ((ret = _mutexgear_lock_acquire(&__rwlock->upgrade_lock)) != EOK)
 		{
-			fault = true;
 			break;
 		}
-		// access_locked = true;
+		upgrade_locked = true;
 
-		if (_mutexgear_completion_queue_lodisempty(&__rwlock->waiting_writes))
+		// The upgradable readers are never published in the visible readers table
+		if ((ret = _mutexgear_rwlock_fastpath_rdlock(_MUTEXGEAR_DEADLINE_INFINITE, __rwlock, __worker, __waiter, __item)) != EOK)
 		{
 			break;
 		}
 
-		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
-		// access_locked = false;
-		MG_ASSERT(__out_readers_lock == NULL || (*__out_readers_lock = NULL, true));
+		success = true;
 	}
+	while (false);
 
-	if (fault)
+	if (!success)
 	{
-		if (wait_inserted)
+		if (upgrade_locked)
 		{
-			if (waiting_writes_locked)
-			{
-				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->waiting_writes)) == EOK); // Should succeed normally
-			}
-
-			MG_CHECK(item_completion_status, (item_completion_status = _mutexgear_completion_drainablequeueditem_safefinish(&__rwlock->waiting_reads, __item, __worker, read_wait_drain_index, &__rwlock->read_wait_drain)) == EOK); // No way to handle -- must succeed
-			// _mutexgear_completion_item_prestart(__item, __worker); -- no need to keep the item pre-started with a failed exit
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
 		}
 	}
 
-	return !fault || (*__out_status = ret, false);
+	return success ? EOK : ret;
 }
 
-
-static
-bool rwlock_rdlock_wait_write_wait_emptiness(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *last_write_wait,
-	/*bool *__out_waiting_writes_remain_locked, */int *__out_status)
+/*extern */
+int mutexgear_trdl_rwlock_uprdunlock(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
 {
-	bool fault = false;
-	int ret;
-
-	// bool waiting_writes_unlocked = false;
-
-	mutexgear_completion_item_t	*write_wait = last_write_wait;
-	MG_ASSERT(write_wait != NULL);
+	bool success = false;
+	int ret, mutex_unlock_status;
 
-	bool exit_the_loop;
-	for (exit_the_loop = false; !exit_the_loop; exit_the_loop = !_mutexgear_completion_queue_gettail(&write_wait, &__rwlock->waiting_writes))
+	do
 	{
-		ret = _mutexgear_completion_queue_unlockandwait(&__rwlock->waiting_writes, write_wait, __waiter);
-		// waiting_writes_unlocked = true; // The unlock in the call above is not allowed to fail
-
-		if (ret != EOK)
+		if ((ret = mutexgear_trdl_rwlock_rdunlock(__rwlock, __worker, __item)) != EOK)
 		{
-			fault = true;
 			break;
 		}
 
-		if ((ret = _mutexgear_completion_queue_lock(NULL, &__rwlock->waiting_writes)) != EOK)
-		{
-			fault = true;
-			break;
-		}
-		// waiting_writes_unlocked = false;
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->basic_lock.upgrade_lock)) == EOK); // Should succeed normally
+
+		success = true;
 	}
+	while (false);
 
-	return !fault || (/**__out_waiting_writes_remain_locked = !waiting_writes_unlocked, */*__out_status = ret, false);
+	return success ? EOK : ret;
 }
 
-_MUTEXGEAR_PURE_INLINE
-mutexgear_dlraitem_t *rwlock_rdlock_link_express_queue_till_rend(mutexgear_dlraitem_t *queue_tail, mutexgear_dlraitem_t *queue_rend)
+/*extern */
+int mutexgear_rwlock_uprdunlock(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
 {
-	MG_ASSERT(queue_tail != queue_rend);
-
-	mutexgear_dlraitem_t *first_element;
+	bool success = false;
+	int ret, mutex_unlock_status;
 
-	for (mutexgear_dlraitem_t *previous_element, *current_element = queue_tail; ; current_element = previous_element)
+	do
 	{
-		previous_element = mutexgear_dlraitem_getprevious(current_element);
-
-		if (previous_element == queue_rend)
+		if ((ret = mutexgear_rwlock_rdunlock(__rwlock, __worker, __item)) != EOK)
 		{
-			first_element = current_element;
 			break;
 		}
 
-		_mutexgear_dlraitem_setnext(previous_element, current_element);
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
+
+		success = true;
 	}
+	while (false);
 
-	return first_element;
+	return success ? EOK : ret;
 }
 
-
 /*extern */
-int mutexgear_trdl_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+int mutexgear_trdl_rwlock_rdupgrade(mutexgear_trdl_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
 {
 	bool success = false;
 	int ret, mutex_unlock_status;
 
-	bool access_locked = false, read_work_started = false/*, tryreads_locked = false*/;
+	bool read_released = false;
 
 	do
 	{
-		if (_mutexgear_completion_itemdata_getanytags(&__item->data))
+		if (!rwlock_upgrade_isenabled(&__rwlock->basic_lock))
 		{
 			ret = EINVAL;
 			break;
 		}
 
-		if (!rwlock_wrlock_are_zero_wrlock_waits(__rwlock))
+		if ((ret = mutexgear_trdl_rwlock_rdunlock(__rwlock, __worker, __item)) != EOK)
 		{
-			ret = EBUSY;
 			break;
 		}
+		read_released = true;
 
-		// Optimistically pre-tag and pre-start the item before entering locks
-		_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_trylocked, true);
-		_mutexgear_completion_item_prestart(__item, __worker);
-		read_work_started = true;
-
-		if ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK)
+		// With upgrade_lock owned, no other writer can be ahead, and the item is reused to wait for the remaining readers
+		if ((ret = _mutexgear_trdl_rwlock_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item)) != EOK)
 		{
 			break;
 		}
-		// tryreads_locked = true;
-
-		if (rwlock_wrlock_are_zero_wrlock_waits(__rwlock))
-		{
-			// Enqueue the item back, after the tryread_queue_separator, as this is a "try-read" section protected with tryread_queue_lock mutex
-			_mutexgear_completion_queue_unsafeenqueue_back(&__rwlock->basic_lock.acquired_reads, __item);
-
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
-			// tryreads_locked = false;
 
-			access_locked = true;
-		}
-		else
-		{
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
-			// tryreads_locked = false;
-		}
+		rwlock_optread_enterwrite(&__rwlock->basic_lock);
 
-		if (!access_locked)
-		{
-			ret = EBUSY;
-			break;
-		}
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->basic_lock.upgrade_lock)) == EOK); // Should succeed normally
 
 		success = true;
 	}
@@ -1936,100 +5187,78 @@ int mutexgear_trdl_rwlock_tryrdlock(mutexgear_trdl_rwlock_t *__rwlock,
 
 	if (!success)
 	{
-		if (read_work_started)
+		if (read_released)
 		{
-			// if (tryreads_locked)
-			// {
-			// 	MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
-			// }
-
-			_mutexgear_completion_item_reinit(__item);
-			_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_trylocked, false);
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->basic_lock.upgrade_lock)) == EOK); // Should succeed normally
 		}
-
-		MG_ASSERT(!access_locked);
 	}
 
 	return success ? EOK : ret;
 }
 
-
-_MUTEXGEAR_PURE_INLINE void rwlock_rdunlock_committed_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item);
-_MUTEXGEAR_PURE_INLINE void rwlock_rdunlock_queued_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, 
-	mutexgear_dlraitem_t *item_work_item);
-
 /*extern */
-int mutexgear_trdl_rwlock_rdunlock(mutexgear_trdl_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+int mutexgear_rwlock_rdupgrade(mutexgear_rwlock_t *__rwlock,
+	mutexgear_completion_worker_t *__worker, mutexgear_completion_waiter_t *__waiter, mutexgear_completion_item_t *__item)
 {
 	bool success = false;
 	int ret, mutex_unlock_status;
 
-	bool access_locked = false;
+	bool fastpath_enabled = rwlock_fastpath_isenabled(__rwlock), read_released = false;
 
 	do
 	{
-		mutexgear_completion_locktoken_t reads_lock_storage, *reads_lock_ptr = NULL;
-		MG_ASSERT((reads_lock_ptr = &reads_lock_storage, true));
-
-		if ((ret = _mutexgear_completion_queue_lock(reads_lock_ptr, &__rwlock->basic_lock.acquired_reads)) != EOK)
+		if (!rwlock_upgrade_isenabled(__rwlock))
 		{
+			ret = EINVAL;
 			break;
 		}
-		access_locked = true;
-
-		mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
 
-		// Check if the item has already been linked into the acquired_reads
-		if (mutexgear_dlraitem_getnext(item_work_item) != item_work_item)
+		if (fastpath_enabled)
 		{
-			bool tryreads_locked = false;
+			ptrdiff_t fastpath_state = rwlock_fastpath_encodeowner(__rwlock, __item, _MUTEXGEAR_RWLOCK_FASTPATH_READER);
 
-			if (_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_trylocked)
-				&& ((ret = _mutexgear_lock_acquire(&__rwlock->tryread_queue_lock)) != EOK || (tryreads_locked = true, false)))
+			// A fast path reader is the only lock owner -- it can become a fast path writer at once.
+			// If a contending thread has moved the reader into acquired_reads, the CAS fails and the queue based promotion follows.
+			if (_mg_atomic_cas_acqrel_ptrdiff(_MG_PVA_PTRDIFF(&__rwlock->fastpath_state), &fastpath_state, rwlock_fastpath_encodeowner(__rwlock, __worker, _MUTEXGEAR_RWLOCK_FASTPATH_WRITER)))
 			{
-				break;
-			}
-
-			// The item must be finished before retrieving the express_reads 
-			// to not create a window when new express_reads items could be added 
-			// with acquired_reads looking not empty for them...
-			_mutexgear_completion_queueditem_unsafefinish__locked(__item);
-			MG_ASSERT(reads_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
-			MG_DO_NOTHING(reads_lock_storage); // To suppress unused variable compiler warning
+				// The item has not been put into any queue
+				_mutexgear_completion_item_reinit(__item);
 
-			if (tryreads_locked)
-			{
-				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->tryread_queue_lock)) == EOK); // Should succeed normally
-			}
+				if (rwlock_readerbias_isenabled(__rwlock))
+				{
+					rwlock_readerbias_revoke(__rwlock, true);
+				}
 
-			// ...and then it is safe to extract the queued express_reads 
-			mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
-			rwlock_rdunlock_committed_commit_express_reads(&__rwlock->basic_lock, tryread_queue_separator);
+				rwlock_optread_enterwrite(__rwlock);
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+				MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
 
-			_mutexgear_completion_queueditem_unsafefinish__unlocked(&__rwlock->basic_lock.acquired_reads, __item, __worker);
+				success = true;
+				break;
+			}
+		}
 
-			// Clear rdlock_itemtag_beingwaited tag that might have been set by waiting writes, as well as clear possible rdlock_itemtag_trylocked flag
-			_mutexgear_completion_itemdata_setallunsafetags(&__item->data, false);
+		// The thread's count within the queue based implementation is retained for the write lock
+		if ((ret = _mutexgear_rwlock_rdunlock(__rwlock, __worker, __item)) != EOK)
+		{
+			break;
 		}
-		else
+		read_released = true;
+
+		// With upgrade_lock owned, no other writer can be ahead, and the item is reused to wait for the remaining readers
+		if ((ret = _mutexgear_rwlock_wrlock(0, _MUTEXGEAR_RWLOCK_WPDEADLINE_NONE, _MUTEXGEAR_DEADLINE_INFINITE, MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL, __rwlock, __worker, __waiter, __item)) != EOK)
 		{
-			// ...and then it is safe to extract the queued express_reads 
-			mutexgear_completion_item_t *tryread_queue_separator = _mutexgear_rtdl_rwlock_getseparator(__rwlock);
-			rwlock_rdunlock_queued_commit_express_reads(&__rwlock->basic_lock, tryread_queue_separator, item_work_item);
+			break;
+		}
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+		if (rwlock_readerbias_isenabled(__rwlock))
+		{
+			rwlock_readerbias_revoke(__rwlock, true);
+		}
 
-			mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
-			_mutexgear_dlraitem_unsaferesettounlinked(item_work_item);
-			// Just reinit the item since it did not get into a queue yet
-			_mutexgear_completion_item_reinit(__item);
+		rwlock_optread_enterwrite(__rwlock);
 
-			// Just check the tag since it could not have been set by writes yet
-			MG_ASSERT(!_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_beingwaited));
-		}
+		MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
 
 		success = true;
 	}
@@ -2037,83 +5266,83 @@ int mutexgear_trdl_rwlock_rdunlock(mutexgear_trdl_rwlock_t *__rwlock,
 
 	if (!success)
 	{
-		if (access_locked)
+		if (read_released)
 		{
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->basic_lock.acquired_reads)) == EOK); // Should succeed normally
+			if (fastpath_enabled)
+			{
+				rwlock_fastpath_leave_slow(__rwlock);
+			}
+
+			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_lock_release(&__rwlock->upgrade_lock)) == EOK); // Should succeed normally
 		}
 	}
 
 	return success ? EOK : ret;
 }
 
-/*extern */
-int mutexgear_rwlock_rdunlock(mutexgear_rwlock_t *__rwlock,
-	mutexgear_completion_worker_t *__worker, mutexgear_completion_item_t *__item)
+_MUTEXGEAR_PURE_INLINE 
+void rwlock_rdunlock_committed_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item)
 {
-	bool success = false;
-	int ret, mutex_unlock_status;
+	unsigned int stripe_index = 0, stripe_mask = rwlock_express_getstripemask(__rwlock);
 
 	do
 	{
-		mutexgear_completion_locktoken_t reads_lock_storage, *reads_lock_ptr = NULL;
-		MG_ASSERT((reads_lock_ptr = &reads_lock_storage, true));
+		mutexgear_dlraitem_t *const express_reads = rwlock_express_getstripe(__rwlock, stripe_index);
+		rwlock_express_commit_stripe(__rwlock, __end_item, express_reads);
+	}
+	while (stripe_index++ != stripe_mask);
+}
 
-		if ((ret = _mutexgear_completion_queue_lock(reads_lock_ptr, &__rwlock->acquired_reads)) != EOK)
-		{
-			break;
-		}
+_MUTEXGEAR_PURE_INLINE
+void rwlock_rdunlock_queued_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, 
+	mutexgear_dlraitem_t *item_work_item)
+{
+	unsigned int stripe_index = 0, stripe_mask = rwlock_express_getstripemask(__rwlock);
+	unsigned int item_stripe_index = stripe_mask != 0 ? rwlock_express_findstripe(__rwlock, item_work_item) : 0;
 
-		mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
+	do
+	{
+		mutexgear_dlraitem_t *const express_reads = rwlock_express_getstripe(__rwlock, stripe_index);
 
-		// Check if the item has already been linked into the acquired_reads
-		if (mutexgear_dlraitem_getnext(item_work_item) != item_work_item)
+		if (stripe_index != item_stripe_index)
 		{
-			// The item must be finished before retrieving the express_reads 
-			// to not create a window when new express_reads items could be added 
-			// with acquired_reads looking not empty for them...
-			_mutexgear_completion_queueditem_unsafefinish__locked(__item);
-			MG_ASSERT(reads_lock_storage == MUTEXGEAR_COMPLETION_ACQUIRED_LOCKTOKEN);
-			MG_DO_NOTHING(reads_lock_storage); // To suppress unused variable compiler warning
-
-			// ...and then it is safe to extract the queued express_reads 
-			mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
-			rwlock_rdunlock_committed_commit_express_reads(__rwlock, end_item);
-
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
-
-			_mutexgear_completion_queueditem_unsafefinish__unlocked(&__rwlock->acquired_reads, __item, __worker);
-
-			// Clear the tag that might have been set by waiting writes
-			_mutexgear_completion_itemdata_setunsafetag(&__item->data, rdlock_itemtag_beingwaited, false);
+			rwlock_express_commit_stripe(__rwlock, __end_item, express_reads);
 		}
 		else
 		{
-			// ...and then it is safe to extract the queued express_reads 
-			mutexgear_completion_item_t *end_item = _mutexgear_completion_queue_getend(&__rwlock->acquired_reads);
-			rwlock_rdunlock_queued_commit_express_reads(__rwlock, end_item, item_work_item);
+			rwlock_express_commit_stripe_without_item(__rwlock, __end_item, express_reads, item_work_item);
+		}
+	}
+	while (stripe_index++ != stripe_mask);
+}
 
-			MG_CHECK(mutex_unlock_status, (mutex_unlock_status = _mutexgear_completion_queue_plainunlock(&__rwlock->acquired_reads)) == EOK); // Should succeed normally
+_MUTEXGEAR_PURE_INLINE
+unsigned int rwlock_express_findstripe(mutexgear_rwlock_t *__rwlock, mutexgear_dlraitem_t *item_work_item)
+{
+	unsigned int stripe_index = 0, stripe_mask = rwlock_express_getstripemask(__rwlock);
 
-			mutexgear_dlraitem_t *item_work_item = _mutexgear_completion_item_getworkitem(__item);
-			_mutexgear_dlraitem_unsaferesettounlinked(item_work_item);
-			// Just reinit the item since it did not get into a queue yet
-			_mutexgear_completion_item_reinit(__item);
+	// With the mutex of acquired_reads owned, nobody can extract the lists, and new items can only be added at the tails.
+	// So, the chain from a tail down to the __item is stable.
+	for (; stripe_index != stripe_mask; ++stripe_index)
+	{
+		mutexgear_dlraitem_t *const express_reads = rwlock_express_getstripe(__rwlock, stripe_index);
 
-			// Just check the tag since it could not have been set by writes yet
-			MG_ASSERT(!_mutexgear_completion_itemdata_gettag(&__item->data, rdlock_itemtag_beingwaited));
-		}
+		mutexgear_dlraitem_t *current_element;
+		for (current_element = mutexgear_dlraitem_getprevious(express_reads); current_element != express_reads && current_element != item_work_item; current_element = mutexgear_dlraitem_getprevious(current_element)) {}
 
-		success = true;
+		if (current_element == item_work_item)
+		{
+			break;
+		}
 	}
-	while (false);
 
-	return success ? EOK : ret;
+	// If not found in the others, the item is in the last stripe
+	return stripe_index;
 }
 
 _MUTEXGEAR_PURE_INLINE 
-void rwlock_rdunlock_committed_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item)
+void rwlock_express_commit_stripe(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, mutexgear_dlraitem_t *express_reads)
 {
-	mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
 	// WARNING!
 	// No relaxed previewing can be performed here as it has no protection against reordering 
 	// before the __item removal from the queue above. And that creates a data race with the express_reads scheduling 
@@ -2136,12 +5365,11 @@ void rwlock_rdunlock_committed_commit_express_reads(mutexgear_rwlock_t *__rwlock
 }
 
 _MUTEXGEAR_PURE_INLINE
-void rwlock_rdunlock_queued_commit_express_reads(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, 
+void rwlock_express_commit_stripe_without_item(mutexgear_rwlock_t *__rwlock, mutexgear_completion_item_t *__end_item, mutexgear_dlraitem_t *express_reads, 
 	mutexgear_dlraitem_t *item_work_item)
 {
 	bool got_express_reads = false;
 
-	mutexgear_dlraitem_t *const express_reads = _mutexgear_dlraitem_getfromprevious(&__rwlock->express_reads);
 	mutexgear_dlraitem_t *first_express_read, *last_express_read = _mutexgear_dlraitem_swapprevious(express_reads, express_reads);
 	MG_FAKE_INITIALIZE(first_express_read, 0);
 
@@ -50,6 +50,10 @@
 //////////////////////////////////////////////////////////////////////////
 // Lock Function Definitions
 
+// The deadline value (in nanoseconds of _mutexgear_clock_getnanoseconds()) that never expires
+#define _MUTEXGEAR_DEADLINE_INFINITE	UINT64_MAX
+
+
 #ifdef _WIN32
 
 // #ifndef _WIN32_WINNT
@@ -61,12 +65,19 @@
 
 #define _MUTEXGEAR_ERRNO__PSHARED_MISSING		ENOSYS
 #define _MUTEXGEAR_ERRNO__PRIOCEILING_MISSING	ENOSYS
+#define _MUTEXGEAR_ERRNO__ADAPTIVESPIN_MISSING	ENOSYS
+
+// The spin count for the critical sections with the adaptive spin enabled (the value the system heap manager uses for its locks).
+// The spinning is bounded by the count and the system ends it early if the owner is not running at the moment.
+#ifndef _MUTEXGEAR_LOCK_ADAPTIVESPIN_COUNT
+#define _MUTEXGEAR_LOCK_ADAPTIVESPIN_COUNT		4000
+#endif
 
 
 _MUTEXGEAR_PURE_INLINE
 int _mutexgear_lockattr_init(_MUTEXGEAR_LOCKATTR_T *__attr)
 {
-	MG_DO_NOTHING(__attr);
+	*__attr = false; // The attribute stores the adaptive spin setting
 
 	return EOK;
 }
@@ -136,12 +147,33 @@ int _mutexgear_lockattr_setprotocol(_MUTEXGEAR_LOCKATTR_T *__attr, int __protoco
 }
 
 
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_lockattr_getadaptivespin(const _MUTEXGEAR_LOCKATTR_T *__attr, int *__out_spin_enabled)
+{
+	*__out_spin_enabled = *__attr;
+	return EOK;
+}
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_lockattr_setadaptivespin(_MUTEXGEAR_LOCKATTR_T *__attr, int __spin_enabled)
+{
+	*__attr = __spin_enabled != 0;
+	return EOK;
+}
+
+
 _MUTEXGEAR_PURE_INLINE
 int _mutexgear_lock_init(_MUTEXGEAR_LOCK_T *__lock, const _MUTEXGEAR_LOCKATTR_T *__attr)
 {
-	MG_DO_NOTHING(__attr);
+	if (__attr != NULL && *__attr)
+	{
+		InitializeCriticalSectionAndSpinCount(__lock, _MUTEXGEAR_LOCK_ADAPTIVESPIN_COUNT);
+	}
+	else
+	{
+		InitializeCriticalSection(__lock);
+	}
 
-	InitializeCriticalSection(__lock);
 	return EOK;
 }
 
@@ -173,6 +205,126 @@ int _mutexgear_lock_release(_MUTEXGEAR_LOCK_T *__lock)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Clock Function Definitions
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_clock_getnanoseconds(uint64_t *__out_timepoint)
+{
+	LARGE_INTEGER counter_value, counter_frequency;
+	QueryPerformanceFrequency(&counter_frequency); // Can't fail on Windows XP and later
+	QueryPerformanceCounter(&counter_value);
+
+	uint64_t whole_seconds = (uint64_t)(counter_value.QuadPart / counter_frequency.QuadPart), second_remainder = (uint64_t)(counter_value.QuadPart % counter_frequency.QuadPart);
+	*__out_timepoint = whole_seconds * 1000000000 + second_remainder * 1000000000 / (uint64_t)counter_frequency.QuadPart;
+	return EOK;
+}
+
+
+_MUTEXGEAR_PURE_INLINE
+void _mutexgear_thread_yield()
+{
+	SwitchToThread();
+}
+
+// Maps the calling thread's priority onto the ranks from zero (normal and lower priorities) to __max_rank (the time critical priority)
+_MUTEXGEAR_PURE_INLINE
+unsigned int _mutexgear_thread_getschedulingrank(unsigned int __max_rank)
+{
+	int thread_priority = GetThreadPriority(GetCurrentThread());
+
+	return thread_priority == THREAD_PRIORITY_ERROR_RETURN || thread_priority <= THREAD_PRIORITY_NORMAL ? 0U
+		: thread_priority >= THREAD_PRIORITY_TIME_CRITICAL ? __max_rank
+		: (unsigned int)(thread_priority - THREAD_PRIORITY_NORMAL) < __max_rank ? (unsigned int)(thread_priority - THREAD_PRIORITY_NORMAL) : __max_rank;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Thread Specific Storage Function Definitions
+
+#define _MUTEXGEAR_ONCE_T			INIT_ONCE
+#define _MUTEXGEAR_ONCE_INITIALIZER	INIT_ONCE_STATIC_INIT
+
+#define _MUTEXGEAR_TSSKEY_T			DWORD
+// The destructor is invoked on thread exits for the keys having non-NULL values
+#define _MUTEXGEAR_TSSKEY_DESTRUCTOR(name, value_param) VOID NTAPI name(PVOID value_param)
+
+
+_MUTEXGEAR_PURE_INLINE
+BOOL CALLBACK _mutexgear_once_routinethunk(PINIT_ONCE __once, PVOID __routine, PVOID *__out_context)
+{
+	MG_DO_NOTHING(__once);
+	MG_DO_NOTHING(__out_context);
+
+	((void (*)(void))__routine)();
+	return TRUE;
+}
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_once_execute(_MUTEXGEAR_ONCE_T *__once, void (*__routine)(void))
+{
+	return InitOnceExecuteOnce(__once, &_mutexgear_once_routinethunk, (PVOID)__routine, NULL) != FALSE ? EOK : EINVAL;
+}
+
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_tsskey_create(_MUTEXGEAR_TSSKEY_T *__out_key, PFLS_CALLBACK_FUNCTION __destructor)
+{
+	DWORD key_value = FlsAlloc(__destructor);
+	return key_value != FLS_OUT_OF_INDEXES ? (*__out_key = key_value, EOK) : EAGAIN;
+}
+
+_MUTEXGEAR_PURE_INLINE
+void *_mutexgear_tsskey_getvalue(_MUTEXGEAR_TSSKEY_T __key)
+{
+	return FlsGetValue(__key);
+}
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_tsskey_setvalue(_MUTEXGEAR_TSSKEY_T __key, void *__value)
+{
+	return FlsSetValue(__key, __value) != FALSE ? EOK : ENOMEM;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Timed Lock Function Definitions
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_lock_timedacquire(_MUTEXGEAR_LOCK_T *__lock, uint64_t __deadline)
+{
+	int ret;
+
+	if (__deadline == _MUTEXGEAR_DEADLINE_INFINITE)
+	{
+		ret = _mutexgear_lock_acquire(__lock);
+	}
+	else
+	{
+		// The critical sections do not support timed waits. Poll the lock yielding the processor in between.
+		uint64_t current_time;
+
+		while ((ret = _mutexgear_lock_tryacquire(__lock)) == EBUSY)
+		{
+			if ((ret = _mutexgear_clock_getnanoseconds(&current_time)) != EOK)
+			{
+				break;
+			}
+
+			if (current_time >= __deadline)
+			{
+				ret = ETIMEDOUT;
+				break;
+			}
+
+			_mutexgear_thread_yield();
+		}
+	}
+
+	return ret;
+}
+
+
 #else // #ifndef _WIN32
 
 
@@ -183,6 +335,19 @@ int _mutexgear_lock_release(_MUTEXGEAR_LOCK_T *__lock)
 
 #define _MUTEXGEAR_ERRNO__PSHARED_MISSING		ENOSYS
 #define _MUTEXGEAR_ERRNO__PRIOCEILING_MISSING	ENOSYS
+#define _MUTEXGEAR_ERRNO__ADAPTIVESPIN_MISSING	ENOSYS
+#define _MUTEXGEAR_ERRNO__CLOCK_MISSING			ENOSYS
+
+// The adaptive mutex type spins for a bounded number of iterations before blocking in the kernel and tunes the bound 
+// from the spin counts that were needed for the recent acquisitions (the type is only exposed with _GNU_SOURCE).
+#if defined(PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP)
+#define _MUTEXGEAR_HAVE_PTHREAD_MUTEX_ADAPTIVE_NP
+#endif
+
+// The clock lock is only declared with _GNU_SOURCE in glibc. The units built without it fall back to the timed lock.
+#if defined(_MUTEXGEAR_HAVE_PTHREAD_MUTEX_CLOCKLOCK) && defined(_MUTEXGEAR_HAVE_CLOCK_GETTIME) && defined(_GNU_SOURCE)
+#define _MUTEXGEAR_USE_PTHREAD_MUTEX_CLOCKLOCK
+#endif
 
 
 _MUTEXGEAR_PURE_INLINE
@@ -327,6 +492,37 @@ int _mutexgear_lockattr_setprotocol(_MUTEXGEAR_LOCKATTR_T *__attr, int __protoco
 }
 
 
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_lockattr_getadaptivespin(const _MUTEXGEAR_LOCKATTR_T *__attr, int *__out_spin_enabled)
+{
+#if defined(_MUTEXGEAR_HAVE_PTHREAD_MUTEX_ADAPTIVE_NP)
+	int ret, type_value;
+	if ((ret = pthread_mutexattr_gettype(__attr, &type_value)) == EOK)
+	{
+		*__out_spin_enabled = type_value == PTHREAD_MUTEX_ADAPTIVE_NP;
+	}
+	return ret;
+#else
+	MG_DO_NOTHING(__attr);
+
+	*__out_spin_enabled = 0;
+	return EOK;
+#endif
+}
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_lockattr_setadaptivespin(_MUTEXGEAR_LOCKATTR_T *__attr, int __spin_enabled)
+{
+#if defined(_MUTEXGEAR_HAVE_PTHREAD_MUTEX_ADAPTIVE_NP)
+	return pthread_mutexattr_settype(__attr, __spin_enabled != 0 ? PTHREAD_MUTEX_ADAPTIVE_NP : PTHREAD_MUTEX_DEFAULT);
+#else
+	MG_DO_NOTHING(__attr);
+
+	return __spin_enabled != 0 ? _MUTEXGEAR_ERRNO__ADAPTIVESPIN_MISSING : EOK;
+#endif
+}
+
+
 _MUTEXGEAR_PURE_INLINE
 int _mutexgear_lock_init(_MUTEXGEAR_LOCK_T *__lock, const _MUTEXGEAR_LOCKATTR_T *__attr)
 {
@@ -358,8 +554,273 @@ int _mutexgear_lock_release(_MUTEXGEAR_LOCK_T *__lock)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Clock Function Definitions
+
+#if defined(_MUTEXGEAR_HAVE_CLOCK_GETTIME)
+#include <time.h>
+#elif defined(_MUTEXGEAR_HAVE_GETTIMEOFDAY)
+#include <sys/time.h>
+#endif
+#include <sched.h>
+
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_clock_getnanoseconds(uint64_t *__out_timepoint)
+{
+#if defined(_MUTEXGEAR_HAVE_CLOCK_GETTIME)
+	struct timespec clock_time;
+	return clock_gettime(CLOCK_MONOTONIC, &clock_time) == 0 ? (*__out_timepoint = (uint64_t)clock_time.tv_sec * 1000000000 + (uint64_t)clock_time.tv_nsec, EOK) : errno;
+#elif defined(_MUTEXGEAR_HAVE_GETTIMEOFDAY)
+	// NOTE: The time of day is not monotonic. It is only used as the last resort where the monotonic clock is not available.
+	struct timeval day_time;
+	return gettimeofday(&day_time, NULL) == 0 ? (*__out_timepoint = (uint64_t)day_time.tv_sec * 1000000000 + (uint64_t)day_time.tv_usec * 1000, EOK) : errno;
+#else
+	MG_DO_NOTHING(__out_timepoint);
+	return _MUTEXGEAR_ERRNO__CLOCK_MISSING;
+#endif
+}
+
+
+_MUTEXGEAR_PURE_INLINE
+void _mutexgear_thread_yield()
+{
+	sched_yield();
+}
+
+// Maps the calling thread's priority onto the ranks from zero (the time sharing policies) to __max_rank (the top of the real time policy priority range)
+_MUTEXGEAR_PURE_INLINE
+unsigned int _mutexgear_thread_getschedulingrank(unsigned int __max_rank)
+{
+	unsigned int rank = 0;
+
+	int thread_policy;
+	struct sched_param thread_param;
+
+	if (__max_rank != 0 && pthread_getschedparam(pthread_self(), &thread_policy, &thread_param) == 0
+		&& (thread_policy == SCHED_FIFO || thread_policy == SCHED_RR))
+	{
+		int min_priority = sched_get_priority_min(thread_policy), max_priority = sched_get_priority_max(thread_policy);
+
+		// The real time threads get the ranks starting from one with the priority range split evenly among them
+		rank = min_priority >= 0 && max_priority > min_priority && thread_param.sched_priority >= min_priority
+			? 1U + (unsigned int)((unsigned long)(thread_param.sched_priority - min_priority) * (__max_rank - 1U) / (unsigned long)(max_priority - min_priority))
+			: 1U;
+		rank = rank < __max_rank ? rank : __max_rank;
+	}
+
+	return rank;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Thread Specific Storage Function Definitions
+
+#define _MUTEXGEAR_ONCE_T			pthread_once_t
+#define _MUTEXGEAR_ONCE_INITIALIZER	PTHREAD_ONCE_INIT
+
+#define _MUTEXGEAR_TSSKEY_T			pthread_key_t
+// The destructor is invoked on thread exits for the keys having non-NULL values
+#define _MUTEXGEAR_TSSKEY_DESTRUCTOR(name, value_param) void name(void *value_param)
+
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_once_execute(_MUTEXGEAR_ONCE_T *__once, void (*__routine)(void))
+{
+	return pthread_once(__once, __routine);
+}
+
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_tsskey_create(_MUTEXGEAR_TSSKEY_T *__out_key, void (*__destructor)(void *))
+{
+	return pthread_key_create(__out_key, __destructor);
+}
+
+_MUTEXGEAR_PURE_INLINE
+void *_mutexgear_tsskey_getvalue(_MUTEXGEAR_TSSKEY_T __key)
+{
+	return pthread_getspecific(__key);
+}
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_tsskey_setvalue(_MUTEXGEAR_TSSKEY_T __key, void *__value)
+{
+	return pthread_setspecific(__key, __value);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Timed Lock Function Definitions
+
+_MUTEXGEAR_PURE_INLINE
+int _mutexgear_lock_timedacquire(_MUTEXGEAR_LOCK_T *__lock, uint64_t __deadline)
+{
+	int ret;
+
+	if (__deadline == _MUTEXGEAR_DEADLINE_INFINITE)
+	{
+		ret = _mutexgear_lock_acquire(__lock);
+	}
+	else
+	{
+#if defined(_MUTEXGEAR_USE_PTHREAD_MUTEX_CLOCKLOCK)
+		struct timespec deadline_time;
+		deadline_time.tv_sec = (time_t)(__deadline / 1000000000);
+		deadline_time.tv_nsec = (long)(__deadline % 1000000000);
+
+		ret = pthread_mutex_clocklock(__lock, CLOCK_MONOTONIC, &deadline_time);
+#else
+		uint64_t current_time;
+
+		if ((ret = _mutexgear_lock_tryacquire(__lock)) == EBUSY)
+		{
+#if defined(_MUTEXGEAR_HAVE_PTHREAD_MUTEX_TIMEDLOCK) && defined(_MUTEXGEAR_HAVE_CLOCK_GETTIME)
+			struct timespec realtime_time, deadline_time;
+			uint64_t realtime_deadline;
+
+			do
+			{
+				// The timed lock only accepts the real time deadline. Rebase the monotonic deadline onto the real time clock.
+				if ((ret = _mutexgear_clock_getnanoseconds(&current_time)) != EOK)
+				{
+					break;
+				}
+
+				if (current_time >= __deadline)
+				{
+					ret = ETIMEDOUT;
+					break;
+				}
+
+				if (clock_gettime(CLOCK_REALTIME, &realtime_time) != 0)
+				{
+					ret = errno;
+					break;
+				}
+
+				realtime_deadline = (uint64_t)realtime_time.tv_sec * 1000000000 + (uint64_t)realtime_time.tv_nsec + (__deadline - current_time);
+				deadline_time.tv_sec = (time_t)(realtime_deadline / 1000000000);
+				deadline_time.tv_nsec = (long)(realtime_deadline % 1000000000);
+
+				ret = pthread_mutex_timedlock(__lock, &deadline_time);
+			}
+			while (false);
+#else
+			// Poll the lock yielding the processor in between.
+			do
+			{
+				if ((ret = _mutexgear_clock_getnanoseconds(&current_time)) != EOK)
+				{
+					break;
+				}
+
+				if (current_time >= __deadline)
+				{
+					ret = ETIMEDOUT;
+					break;
+				}
+
+				_mutexgear_thread_yield();
+			}
+			while ((ret = _mutexgear_lock_tryacquire(__lock)) == EBUSY);
+#endif
+		}
+#endif
+	}
+
+	return ret;
+}
+
+
 #endif // #ifndef _WIN32
 
 
+//////////////////////////////////////////////////////////////////////////
+// Deadline Conversion Function Definitions
+
+#include <time.h>
+
+
+// The public deadlines are CLOCK_MONOTONIC timespec values (std::chrono::steady_clock based ones on Windows)
+_MUTEXGEAR_PURE_INLINE
+uint64_t _mutexgear_deadline_fromtimespec(const struct timespec *__abs_timeout)
+{
+	uint64_t ret;
+
+	if (__abs_timeout->tv_sec < 0)
+	{
+		ret = 0;
+	}
+	else if ((uint64_t)__abs_timeout->tv_sec >= _MUTEXGEAR_DEADLINE_INFINITE / 1000000000)
+	{
+		ret = _MUTEXGEAR_DEADLINE_INFINITE - 1;
+	}
+	else
+	{
+		ret = (uint64_t)__abs_timeout->tv_sec * 1000000000 
+			+ (__abs_timeout->tv_nsec <= 0 ? 0 : __abs_timeout->tv_nsec < 1000000000 ? (uint64_t)__abs_timeout->tv_nsec : 999999999);
+	}
+
+	return ret;
+}
+
+_MUTEXGEAR_PURE_INLINE
+bool _mutexgear_deadline_isreached(uint64_t __deadline)
+{
+	uint64_t current_time;
+	// Consider the deadline reached if the clock fails
+	return __deadline != _MUTEXGEAR_DEADLINE_INFINITE && (_mutexgear_clock_getnanoseconds(&current_time) != EOK || current_time >= __deadline);
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////
+// Statistics Function Definitions
+
+#if defined(_MUTEXGEAR_WITH_STATS)
+
+// The statistics counters are updated with relaxed loads and stores rather than with interlocked operations
+// to keep the instrumentation cheap. A concurrent update may occasionally be lost.
+_MUTEXGEAR_PURE_INLINE
+void _mutexgear_stats_increment(ptrdiff_t *__counter)
+{
+	_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(__counter), _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(__counter)) + 1);
+}
+
+_MUTEXGEAR_PURE_INLINE
+uint64_t _mutexgear_stats_gettime()
+{
+	uint64_t current_time;
+	// A failed clock just makes the interval counted as zero
+	return _mutexgear_clock_getnanoseconds(&current_time) == EOK ? current_time : 0;
+}
+
+// Adds the time elapsed since __start_time to the total and raises the maximum if the interval exceeds it
+_MUTEXGEAR_PURE_INLINE
+void _mutexgear_stats_addtime(ptrdiff_t *__total_counter, ptrdiff_t *__max_counter, uint64_t __start_time)
+{
+	uint64_t current_time = _mutexgear_stats_gettime();
+	uint64_t elapsed_time = current_time > __start_time ? current_time - __start_time : 0;
+	ptrdiff_t interval_value = elapsed_time < (uint64_t)PTRDIFF_MAX ? (ptrdiff_t)elapsed_time : PTRDIFF_MAX;
+
+	// The total is allowed to wrap around
+	_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(__total_counter), (ptrdiff_t)((size_t)_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(__total_counter)) + (size_t)interval_value));
+
+	if (interval_value > _mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(__max_counter)))
+	{
+		_mg_atomic_store_relaxed_ptrdiff(_MG_PVA_PTRDIFF(__max_counter), interval_value);
+	}
+}
+
+_MUTEXGEAR_PURE_INLINE
+uint64_t _mutexgear_stats_getvalue(const ptrdiff_t *__counter)
+{
+	return (uint64_t)(size_t)_mg_atomic_load_relaxed_ptrdiff(_MG_PCVA_PTRDIFF(__counter));
+}
+
+
+#endif // #if defined(_MUTEXGEAR_WITH_STATS)
+
 #endif // #ifndef __MUTEXGEAR_MG_UTILITY_H_INCLUDED
 
@@ -63,6 +63,7 @@ static int _mutexgear_wheel_disengaged(mutexgear_wheel_t *__wheel);
 
 static int _mutexgear_wheel_gripon(mutexgear_wheel_t *__wheel);
 static int _mutexgear_wheel_turn(mutexgear_wheel_t *__wheel);
+static int _mutexgear_wheel_timedturn(mutexgear_wheel_t *__wheel, uint64_t __deadline);
 static int _mutexgear_wheel_release(mutexgear_wheel_t *__wheel);
 
 
@@ -466,7 +467,14 @@ int _mutexgear_wheel_gripon(mutexgear_wheel_t *__wheel)
 /*static */
 int _mutexgear_wheel_turn(mutexgear_wheel_t *__wheel)
 {
-	// NOTE: This matches the mutexgear_wheel_advanced() but operates with client_side_index rather than the wheel_side_index
+	return _mutexgear_wheel_timedturn(__wheel, _MUTEXGEAR_DEADLINE_INFINITE);
+}
+
+/*static */
+int _mutexgear_wheel_timedturn(mutexgear_wheel_t *__wheel, uint64_t __deadline)
+{
+	// NOTE: This matches the mutexgear_wheel_advanced() but operates with client_side_index rather than the wheel_side_index.
+	// With a finite deadline, the turn may fail with ETIMEDOUT leaving the wheel gripped at the original position.
 	int ret;
 
 	bool fault = false;
@@ -491,7 +499,7 @@ int _mutexgear_wheel_turn(mutexgear_wheel_t *__wheel)
 		int client_side_index = __wheel->client_side_index;
 		int next_index = client_side_index != MUTEXGEAR_WHEEL_NUMELEMENTS - 1 ? client_side_index + 1 : 0;
 
-		if ((ret = _mutexgear_lock_acquire(__wheel->muteces + next_index)) == EOK)
+		if ((ret = _mutexgear_lock_timedacquire(__wheel->muteces + next_index, __deadline)) == EOK)
 		{
 			if ((ret = _mutexgear_lock_release(__wheel->muteces + client_side_index)) == EOK)
 			{
@@ -87,6 +87,7 @@
 
 #if _MGTEST_ANY_SHARED_MUTEX_AVAILABLE
 #include <shared_mutex>
+#include <mutex>
 #endif
 
 
@@ -105,6 +106,7 @@
 #endif
 
 #include <atomic>
+#include <memory>
 #include <utility>
 
 
@@ -132,10 +134,13 @@ enum ERWLOCKFINETEST
 
 	LFT_SYSTEM = LFT__MIN,
 	LFT_MUTEXGEAR,
+	LFT_MUTEXGEAR_NO_FASTPATH,
 	LFT_MUTEXGEAR_MINIMAL_TO_WP,
 	LFT_MUTEXGEAR_AVERAGE_TO_WP,
 	LFT_MUTEXGEAR_SUBSTANTIAL_TO_WP,
 	LFT_MUTEXGEAR_INFINITE_TO_WP,
+	LFT_MUTEXGEAR_ADAPTIVE_TO_WP,
+	LFT_MUTEXGEAR_TIMED_TO_WP,
 
 	LFT__MAX,
 };
@@ -195,10 +200,13 @@ static const char *const g_aszTestedObjectKindFileNameSuffixes[] =
 {
 	"Sys", // 	LFT_SYSTEM = LFT__MIN,
 	"MG", // LFT_MUTEXGEAR,
+	"MG-!FP", // LFT_MUTEXGEAR_NO_FASTPATH,
 	"MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_MINIMAL_READERS_TILL_WP) "WP", // LFT_MUTEXGEAR_MINIMAL_TO_WP,
 	"MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_AVERAGE_READERS_TILL_WP) "WP", // LFT_MUTEXGEAR_AVERAGE_TO_WP,
 	"MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_SUBSTANTIAL_READERS_TILL_WP) "WP", // LFT_MUTEXGEAR_SUBSTANTIAL_TO_WP,
 	"MG-!WP", // LFT_MUTEXGEAR_INFINITE_TO_WP,
+	"MG-AWP", // LFT_MUTEXGEAR_ADAPTIVE_TO_WP,
+	"MG-TWP", // LFT_MUTEXGEAR_TIMED_TO_WP,
 };
 MG_STATIC_ASSERT(ARRAY_SIZE(g_aszTestedObjectKindFileNameSuffixes) == LFT__MAX);
 
@@ -303,6 +311,11 @@ private:
 enum
 {
 	LIOPT_MULTIPLE_WRITE_CHANNELS		= 0x01,
+	LIOPT_NO_FASTPATH					= 0x02,
+	LIOPT_WIDE_WRITE_CHANNELS			= 0x04,
+	LIOPT_MAXIMAL_WRITE_CHANNELS		= 0x08,
+
+	LIOPT__WRITE_CHANNELS_MASK			= LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_WIDE_WRITE_CHANNELS | LIOPT_MAXIMAL_WRITE_CHANNELS,
 
 	LIOPT__CUSTOM_WP_MASK				= 0xF0,
 	LIOPT_IMMEDIATE_WP					= 0x00,
@@ -310,10 +323,36 @@ enum
 	LIOPT_AVERAGE_READERS_TILL_WP		= 0x20,
 	LIOPT_SUBSTANTIAL_READERS_TILL_WP	= 0x30,
 	LIOPT_NO_WP							= 0x40,
+	LIOPT_ADAPTIVE_WP					= 0x50,
+	LIOPT_TIMED_WP						= 0x60,
+
+	LIOPT_DOWNGRADE_WRITES				= 0x100,
+	LIOPT_UPGRADE_WRITES				= 0x200,
+	LIOPT_STRIPED_READS					= 0x400,
+	LIOPT_ADAPTIVE_SPIN					= 0x800,
+	LIOPT_TIMED_LOCKS					= 0x1000,
+	LIOPT_WRITE_HANDOFF					= 0x2000,
+	LIOPT_COMBINED_WRITES				= 0x4000,
+	LIOPT_OPTIMISTIC_READS				= 0x8000,
+	LIOPT_READER_BIAS					= 0x10000,
+	LIOPT_LIGHT_TRYREADS				= 0x20000, // Try-read on the basic objects
+	LIOPT_MULTIPLE_WRITE_LOCKS			= 0x40000, // Write-lock a companion object together with the tested one
+	LIOPT_COUPLED_LOCKS					= 0x80000, // Lock the companion object as a parent and then couple to the tested one
+	LIOPT_NESTED_READS					= 0x100000, // Read-lock the tested object within a read lock of the companion one with the same worker
+	LIOPT_THREAD_CONTEXT				= 0x200000, // Lock with the library maintained thread context objects instead of the thread's own ones
+	LIOPT_TASK_HELPERS					= 0x400000, // Create the helper objects for every lock as a short-lived task would do
+	LIOPT_STANDARD_INTERFACE			= 0x800000, // Lock via the std::shared_mutex compatible adapter
+	LIOPT_WRITER_CLASSES				= 0x1000000, // Write-lock with the writer classes distributed among the threads (the custom WP options are not applied)
 };
 
 #define ENCODE_CUSTOM_WP_OPT(Value) (Value)
 #define DECODE_CUSTOM_WP_OPT(Flags) ((Flags) & LIOPT__CUSTOM_WP_MASK)
+#define DECODE_WRITE_CHANNELS_OPT(Flags) ((Flags) & LIOPT__WRITE_CHANNELS_MASK)
+
+enum
+{
+	UPGRADE_SELECTION_BIT = 0x80, // The random data bit to choose upgradable read + upgrade instead of a plain write lock with LIOPT_UPGRADE_WRITES
+};
 
 
 template<ERWLOCKFINETEST tftFineTest>
@@ -333,6 +372,13 @@ public:
 	enum { test_object = LTO_MUTEXGEAR, custom_wp_opt = LIOPT_IMMEDIATE_WP, };
 };
 
+template<>
+class CRWLockFineTestTraits<LFT_MUTEXGEAR_NO_FASTPATH>
+{
+public:
+	enum { test_object = LTO_MUTEXGEAR, custom_wp_opt = LIOPT_IMMEDIATE_WP, fastpath_opt = LIOPT_NO_FASTPATH, };
+};
+
 template<>
 class CRWLockFineTestTraits<LFT_MUTEXGEAR_MINIMAL_TO_WP>
 {
@@ -361,6 +407,20 @@ public:
 	enum { test_object = LTO_MUTEXGEAR, custom_wp_opt = LIOPT_NO_WP, };
 };
 
+template<>
+class CRWLockFineTestTraits<LFT_MUTEXGEAR_ADAPTIVE_TO_WP>
+{
+public:
+	enum { test_object = LTO_MUTEXGEAR, custom_wp_opt = LIOPT_ADAPTIVE_WP, };
+};
+
+template<>
+class CRWLockFineTestTraits<LFT_MUTEXGEAR_TIMED_TO_WP>
+{
+public:
+	enum { test_object = LTO_MUTEXGEAR, custom_wp_opt = LIOPT_TIMED_WP, };
+};
+
 
 template<unsigned int tuiImplementationOptions>
 class CImplementationOptionsTraits;
@@ -380,6 +440,20 @@ public:
 	enum { write_channels = MGTEST_RWLOCK_WRITE_CHANNELS, };
 };
 
+template<>
+class CImplementationOptionsTraits<LIOPT_WIDE_WRITE_CHANNELS>
+{
+public:
+	enum { write_channels = MGTEST_RWLOCK_WIDE_WRITE_CHANNELS, };
+};
+
+template<>
+class CImplementationOptionsTraits<LIOPT_MAXIMAL_WRITE_CHANNELS>
+{
+public:
+	enum { write_channels = MGTEST_RWLOCK_MAXIMAL_WRITE_CHANNELS, };
+};
+
 template<>
 class CImplementationOptionsTraits<LIOPT_MINIMAL_READERS_TILL_WP>
 {
@@ -408,6 +482,20 @@ public:
 	enum { readers_till_wp = MGTEST_RWLOCK_INFINITE_READERS_TILL_WP, };
 };
 
+template<>
+class CImplementationOptionsTraits<LIOPT_ADAPTIVE_WP>
+{
+public:
+	enum { readers_till_wp = MGTEST_RWLOCK_ADAPTIVE_READERS_TILL_WP, };
+};
+
+template<>
+class CImplementationOptionsTraits<LIOPT_TIMED_WP>
+{
+public:
+	enum { readers_till_wp = MGTEST_RWLOCK_TIMED_READERS_TILL_WP, };
+};
+
 
 template<unsigned int tuiImplementationOptions, ERWLOCKTESTTRYREADSUPPORT trsTryReadSupport, ERWLOCKLOCKTESTLANGUAGE ttlTestLanguage>
 class CTryReadAdapter;
@@ -420,7 +508,13 @@ public:
 
 	static int TryReadLock(rwlock_type *pwlLockInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_item_t *pciLockCompletionItem)
 	{
-		return EBUSY;
+		int iLockResult;
+#if MGTEST_RWLOCK_TEST_TRYRDLOCK
+		iLockResult = (tuiImplementationOptions & LIOPT_LIGHT_TRYREADS) != 0 ? mutexgear_rwlock_tryrdlock(pwlLockInstance, pcwLockWorker, pciLockCompletionItem) : EBUSY;
+#else /// !MGTEST_RWLOCK_TEST_TRYRDLOCK
+		iLockResult = EBUSY;
+#endif // !MGTEST_RWLOCK_TEST_TRYRDLOCK
+		return iLockResult;
 	}
 };
 
@@ -443,17 +537,141 @@ public:
 };
 
 
+template<ERWLOCKTESTTRYREADSUPPORT trsTryReadSupport, ERWLOCKLOCKTESTLANGUAGE ttlTestLanguage>
+class CMultipleWriteAdapter;
+
+template<>
+class CMultipleWriteAdapter<TRS_NO_TRYREAD_SUPPORT, LTL_C>
+{
+public:
+	static int WriteLock(mutexgear_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlCompanionInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_waiter_t *pcwLockWaiter)
+	{
+		mutexgear_rwlock_t *apwlLockInstances[] = { pwlLockInstance, pwlCompanionInstance };
+		return mutexgear_rwlock_wrlock_multiple(apwlLockInstances, sizeof(apwlLockInstances) / sizeof(apwlLockInstances[0]), pcwLockWorker, pcwLockWaiter);
+	}
+
+	static int WriteUnlock(mutexgear_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlCompanionInstance)
+	{
+		mutexgear_rwlock_t *const apwlLockInstances[] = { pwlLockInstance, pwlCompanionInstance };
+		return mutexgear_rwlock_wrunlock_multiple(apwlLockInstances, sizeof(apwlLockInstances) / sizeof(apwlLockInstances[0]));
+	}
+};
+
+template<>
+class CMultipleWriteAdapter<TRS_WITH_TRYREAD_SUPPORT, LTL_C>
+{
+public:
+	// The try-read objects have no multiple lock function -- it is emulated with the objects locked in a fixed order
+	static int WriteLock(mutexgear_trdl_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlCompanionInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_waiter_t *pcwLockWaiter)
+	{
+		int iLockResult, iUnlockResult;
+
+		if ((iLockResult = mutexgear_rwlock_wrlock(pwlLockInstance, pcwLockWorker, pcwLockWaiter, NULL)) == EOK
+			&& (iLockResult = mutexgear_rwlock_wrlock(pwlCompanionInstance, pcwLockWorker, pcwLockWaiter, NULL)) != EOK)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_wrunlock(pwlLockInstance)) == EOK);
+		}
+
+		return iLockResult;
+	}
+
+	static int WriteUnlock(mutexgear_trdl_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlCompanionInstance)
+	{
+		int iUnlockResult;
+		MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_wrunlock(pwlCompanionInstance)) == EOK);
+		return mutexgear_rwlock_wrunlock(pwlLockInstance);
+	}
+};
+
+
+template<ERWLOCKTESTTRYREADSUPPORT trsTryReadSupport, ERWLOCKLOCKTESTLANGUAGE ttlTestLanguage>
+class CCoupledLockAdapter;
+
+template<>
+class CCoupledLockAdapter<TRS_NO_TRYREAD_SUPPORT, LTL_C>
+{
+public:
+	static int ReadLock(mutexgear_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlParentInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_waiter_t *pcwLockWaiter, 
+		mutexgear_completion_item_t *pciLockCompletionItem, mutexgear_completion_item_t *pciParentCompletionItem)
+	{
+		int iLockResult, iUnlockResult;
+
+		if ((iLockResult = mutexgear_rwlock_rdlock(pwlParentInstance, pcwLockWorker, pcwLockWaiter, pciParentCompletionItem)) == EOK
+			&& (iLockResult = mutexgear_rwlock_rdlock_coupled(pwlLockInstance, pcwLockWorker, pcwLockWaiter, pciLockCompletionItem, pwlParentInstance, pciParentCompletionItem)) != EOK)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_rdunlock(pwlParentInstance, pcwLockWorker, pciParentCompletionItem)) == EOK);
+		}
+
+		return iLockResult;
+	}
+
+	static int WriteLock(mutexgear_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlParentInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_waiter_t *pcwLockWaiter, 
+		mutexgear_completion_item_t *pciLockCompletionItem, mutexgear_completion_item_t *pciParentCompletionItem)
+	{
+		int iLockResult, iUnlockResult;
+
+		if ((iLockResult = mutexgear_rwlock_wrlock(pwlParentInstance, pcwLockWorker, pcwLockWaiter, pciParentCompletionItem)) == EOK
+			&& (iLockResult = mutexgear_rwlock_wrlock_coupled(pwlLockInstance, pcwLockWorker, pcwLockWaiter, pciLockCompletionItem, pwlParentInstance, NULL)) != EOK)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_wrunlock(pwlParentInstance)) == EOK);
+		}
+
+		return iLockResult;
+	}
+};
+
+template<>
+class CCoupledLockAdapter<TRS_WITH_TRYREAD_SUPPORT, LTL_C>
+{
+public:
+	// The try-read objects have no coupled locks -- they are emulated with the parent released before the object is locked
+	static int ReadLock(mutexgear_trdl_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlParentInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_waiter_t *pcwLockWaiter, 
+		mutexgear_completion_item_t *pciLockCompletionItem, mutexgear_completion_item_t *pciParentCompletionItem)
+	{
+		int iLockResult;
+
+		if ((iLockResult = mutexgear_rwlock_rdlock(pwlParentInstance, pcwLockWorker, pcwLockWaiter, pciParentCompletionItem)) == EOK
+			&& (iLockResult = mutexgear_rwlock_rdunlock(pwlParentInstance, pcwLockWorker, pciParentCompletionItem)) == EOK)
+		{
+			iLockResult = mutexgear_rwlock_rdlock(pwlLockInstance, pcwLockWorker, pcwLockWaiter, pciLockCompletionItem);
+		}
+
+		return iLockResult;
+	}
+
+	static int WriteLock(mutexgear_trdl_rwlock_t *pwlLockInstance, mutexgear_rwlock_t *pwlParentInstance, mutexgear_completion_worker_t *pcwLockWorker, mutexgear_completion_waiter_t *pcwLockWaiter, 
+		mutexgear_completion_item_t *pciLockCompletionItem, mutexgear_completion_item_t *pciParentCompletionItem)
+	{
+		int iLockResult;
+
+		if ((iLockResult = mutexgear_rwlock_wrlock(pwlParentInstance, pcwLockWorker, pcwLockWaiter, pciParentCompletionItem)) == EOK
+			&& (iLockResult = mutexgear_rwlock_wrunlock(pwlParentInstance)) == EOK)
+		{
+			iLockResult = mutexgear_rwlock_wrlock(pwlLockInstance, pcwLockWorker, pcwLockWaiter, pciLockCompletionItem);
+		}
+
+		return iLockResult;
+	}
+};
+
+
 #if _MGTEST_HAVE_CXX11
 
 template<unsigned int tuiImplementationOptions>
 class CTryReadAdapter<tuiImplementationOptions, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>
 {
 public:
-	typedef mg::wp_shared_mutex<CImplementationOptionsTraits<tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_CHANNELS>::write_channels> rwlock_type;
+	typedef mg::wp_shared_mutex<CImplementationOptionsTraits<DECODE_WRITE_CHANNELS_OPT(tuiImplementationOptions)>::write_channels> rwlock_type;
 
 	static bool TryReadLock(rwlock_type &wlLockInstance, typename rwlock_type::helper_bourgeois_type &hbLockBourgeois)
 	{
-		return false;
+		bool bLockResult;
+#if MGTEST_RWLOCK_TEST_TRYRDLOCK
+		bLockResult = (tuiImplementationOptions & LIOPT_LIGHT_TRYREADS) != 0 && wlLockInstance.try_lock_shared(hbLockBourgeois);
+#else /// !MGTEST_RWLOCK_TEST_TRYRDLOCK
+		bLockResult = false;
+#endif // !MGTEST_RWLOCK_TEST_TRYRDLOCK
+		return bLockResult;
 	}
 };
 
@@ -461,7 +679,7 @@ template<unsigned int tuiImplementationOptions>
 class CTryReadAdapter<tuiImplementationOptions, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>
 {
 public:
-	typedef mg::trdl::wp_shared_mutex<CImplementationOptionsTraits<tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_CHANNELS>::write_channels> rwlock_type;
+	typedef mg::trdl::wp_shared_mutex<CImplementationOptionsTraits<DECODE_WRITE_CHANNELS_OPT(tuiImplementationOptions)>::write_channels> rwlock_type;
 
 	static bool TryReadLock(rwlock_type &wlLockInstance, typename rwlock_type::helper_bourgeois_type &hbLockBourgeois)
 	{
@@ -476,9 +694,173 @@ public:
 };
 
 
+template<>
+class CMultipleWriteAdapter<TRS_NO_TRYREAD_SUPPORT, LTL_CPP>
+{
+public:
+	template<class TRWLock, class TCompanionRWLock, class TBourgeois, class TWaiter>
+	static void WriteLock(TRWLock &wlLockInstance, TCompanionRWLock &wlCompanionInstance, TBourgeois &hbLockBourgeois, TWaiter &hwLockWaiter)
+	{
+		mg::lock_all(hbLockBourgeois, hwLockWaiter, wlLockInstance, wlCompanionInstance);
+	}
+
+	template<class TRWLock, class TCompanionRWLock>
+	static void WriteUnlock(TRWLock &wlLockInstance, TCompanionRWLock &wlCompanionInstance)
+	{
+		mg::unlock_all(wlLockInstance, wlCompanionInstance);
+	}
+};
+
+template<>
+class CMultipleWriteAdapter<TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>
+{
+public:
+	// The try-read objects have no multiple lock function -- it is emulated with the objects locked in a fixed order
+	template<class TRWLock, class TCompanionRWLock, class TBourgeois, class TWaiter>
+	static void WriteLock(TRWLock &wlLockInstance, TCompanionRWLock &wlCompanionInstance, TBourgeois &hbLockBourgeois, TWaiter &hwLockWaiter)
+	{
+		wlLockInstance.lock(hbLockBourgeois, hwLockWaiter);
+		wlCompanionInstance.lock(hbLockBourgeois, hwLockWaiter);
+	}
+
+	template<class TRWLock, class TCompanionRWLock>
+	static void WriteUnlock(TRWLock &wlLockInstance, TCompanionRWLock &wlCompanionInstance)
+	{
+		wlCompanionInstance.unlock();
+		wlLockInstance.unlock();
+	}
+};
+
+
+template<>
+class CCoupledLockAdapter<TRS_NO_TRYREAD_SUPPORT, LTL_CPP>
+{
+public:
+	template<class TRWLock, class TParentRWLock, class TExtraObjects>
+	static void ReadLock(TRWLock &wlLockInstance, TParentRWLock &wlParentInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		eoRefExtraObjects.m_ciCouplingIterator.advance_shared(wlParentInstance);
+		eoRefExtraObjects.m_ciCouplingIterator.advance_shared(wlLockInstance);
+	}
+
+	template<class TRWLock, class TParentRWLock, class TExtraObjects>
+	static void WriteLock(TRWLock &wlLockInstance, TParentRWLock &wlParentInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		eoRefExtraObjects.m_ciCouplingIterator.advance(wlParentInstance);
+		eoRefExtraObjects.m_ciCouplingIterator.advance(wlLockInstance);
+	}
+
+	template<class TRWLock, class TExtraObjects>
+	static void ReadUnlock(TRWLock &wlLockInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		eoRefExtraObjects.m_ciCouplingIterator.release();
+	}
+
+	template<class TRWLock, class TExtraObjects>
+	static void WriteUnlock(TRWLock &wlLockInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		eoRefExtraObjects.m_ciCouplingIterator.release();
+	}
+};
+
+template<>
+class CCoupledLockAdapter<TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>
+{
+public:
+	// The try-read objects have no coupled locks -- they are emulated with the parent released before the object is locked
+	template<class TRWLock, class TParentRWLock, class TExtraObjects>
+	static void ReadLock(TRWLock &wlLockInstance, TParentRWLock &wlParentInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		wlParentInstance.lock_shared(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
+		wlParentInstance.unlock_shared(eoRefExtraObjects.m_hbLockBourgeois);
+		wlLockInstance.lock_shared(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
+	}
+
+	template<class TRWLock, class TParentRWLock, class TExtraObjects>
+	static void WriteLock(TRWLock &wlLockInstance, TParentRWLock &wlParentInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		wlParentInstance.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
+		wlParentInstance.unlock();
+		wlLockInstance.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
+	}
+
+	template<class TRWLock, class TExtraObjects>
+	static void ReadUnlock(TRWLock &wlLockInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		wlLockInstance.unlock_shared(eoRefExtraObjects.m_hbLockBourgeois);
+	}
+
+	template<class TRWLock, class TExtraObjects>
+	static void WriteUnlock(TRWLock &wlLockInstance, TExtraObjects &eoRefExtraObjects)
+	{
+		wlLockInstance.unlock();
+	}
+};
+
+
 #endif // #if _MGTEST_HAVE_CXX11
 
 
+class CWriterClassLatencies
+{
+public:
+	typedef CTimeUtils::timepoint timepoint;
+
+	enum { CLASS_COUNT = MUTEXGEAR_RWLOCK_WRITERCLASS_MAX + 1, };
+
+	// The classes are distributed evenly in the order the threads create their lock helper objects
+	static int AssignWriterClass() { return (int)(m_uiClassAssignmentCounter.fetch_add(1, std::memory_order_relaxed) % CLASS_COUNT); }
+
+	static timepoint StartLockWait() { return CTimeUtils::GetCurrentMonotonicTimeNano(); }
+
+	static void FinishLockWait(int iWriterClass, timepoint tpWaitStartTime)
+	{
+		uint64_t uiWaitDuration = (uint64_t)(CTimeUtils::GetCurrentMonotonicTimeNano() - tpWaitStartTime);
+
+		m_auiTotalWaitTimes[iWriterClass].fetch_add(uiWaitDuration, std::memory_order_relaxed);
+		m_auiLockCounts[iWriterClass].fetch_add(1, std::memory_order_relaxed);
+
+		for (uint64_t uiMaxWaitDuration = m_auiMaxWaitTimes[iWriterClass].load(std::memory_order_relaxed); 
+			uiWaitDuration > uiMaxWaitDuration && !m_auiMaxWaitTimes[iWriterClass].compare_exchange_weak(uiMaxWaitDuration, uiWaitDuration, std::memory_order_relaxed); )
+		{
+		}
+	}
+
+	static void ResetStatistics()
+	{
+		for (int iWriterClass = 0; iWriterClass != CLASS_COUNT; ++iWriterClass)
+		{
+			m_auiTotalWaitTimes[iWriterClass].store(0, std::memory_order_relaxed);
+			m_auiLockCounts[iWriterClass].store(0, std::memory_order_relaxed);
+			m_auiMaxWaitTimes[iWriterClass].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	static void PrintStatistics()
+	{
+		for (int iWriterClass = 0; iWriterClass != CLASS_COUNT; ++iWriterClass)
+		{
+			uint64_t uiLockCount = m_auiLockCounts[iWriterClass].load(std::memory_order_relaxed);
+			uint64_t uiAverageWaitTime = uiLockCount != 0 ? m_auiTotalWaitTimes[iWriterClass].load(std::memory_order_relaxed) / uiLockCount : 0;
+			uint64_t uiMaxWaitTime = m_auiMaxWaitTimes[iWriterClass].load(std::memory_order_relaxed);
+
+			printf("WC%d=%lu/%lu%s", iWriterClass, (unsigned long)uiAverageWaitTime, (unsigned long)uiMaxWaitTime, iWriterClass != CLASS_COUNT - 1 ? "," : "ns avg/max: ");
+		}
+	}
+
+private:
+	static std::atomic<unsigned int>			m_uiClassAssignmentCounter;
+	static std::atomic<uint64_t>				m_auiTotalWaitTimes[CLASS_COUNT];
+	static std::atomic<uint64_t>				m_auiLockCounts[CLASS_COUNT];
+	static std::atomic<uint64_t>				m_auiMaxWaitTimes[CLASS_COUNT];
+};
+
+/*static */std::atomic<unsigned int>			CWriterClassLatencies::m_uiClassAssignmentCounter(0);
+/*static */std::atomic<uint64_t>				CWriterClassLatencies::m_auiTotalWaitTimes[CWriterClassLatencies::CLASS_COUNT];
+/*static */std::atomic<uint64_t>				CWriterClassLatencies::m_auiLockCounts[CWriterClassLatencies::CLASS_COUNT];
+/*static */std::atomic<uint64_t>				CWriterClassLatencies::m_auiMaxWaitTimes[CWriterClassLatencies::CLASS_COUNT];
+
+
 template<ERWLOCKTESTTRYREADSUPPORT trsTryReadSupport, unsigned int tuiImplementationOptions, ERWLOCKLOCKTESTOBJECT ttoTestedObjectKind, ERWLOCKLOCKTESTLANGUAGE ttlTestObjectLanguage>
 class CRWLockImplementation;
 
@@ -505,16 +887,37 @@ public:
 	{
 		int iInitResult;
 		MG_CHECK(iInitResult, (iInitResult = _mutexgear_rwlock_init(&m_wlRWLock)) == EOK);
+
+		if ((tuiImplementationOptions & (LIOPT_MULTIPLE_WRITE_LOCKS | LIOPT_COUPLED_LOCKS | LIOPT_NESTED_READS)) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = _mutexgear_rwlock_init(&m_wlCompanionRWLock)) == EOK);
+		}
 	}
 
 	void FinalizeRWLockInstance()
 	{
 		int iDestroyResult;
+
+		if ((tuiImplementationOptions & (LIOPT_MULTIPLE_WRITE_LOCKS | LIOPT_COUPLED_LOCKS | LIOPT_NESTED_READS)) != 0)
+		{
+			MG_CHECK(iDestroyResult, (iDestroyResult = _mutexgear_rwlock_destroy(&m_wlCompanionRWLock)) == EOK);
+		}
+
 		MG_CHECK(iDestroyResult, (iDestroyResult = _mutexgear_rwlock_destroy(&m_wlRWLock)) == EOK);
 	}
 
 	bool LockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			// The system object has no coupled locks -- the parent is just held until the object is locked
+			int iCoupledLockResult;
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = _mutexgear_rwlock_wrlock(&m_wlCompanionRWLock)) == EOK);
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = _mutexgear_rwlock_wrlock(&m_wlRWLock)) == EOK);
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = _mutexgear_rwlock_wrunlock(&m_wlCompanionRWLock)) == EOK);
+			return false;
+		}
+
 		bool bLockedWithTryVariant;
 
 #if MGTEST_RWLOCK_TEST_TRYWRLOCK
@@ -530,17 +933,79 @@ public:
 			MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = _mutexgear_rwlock_wrlock(&m_wlRWLock)) == EOK);
 		}
 
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			// The system object has no multiple lock function -- the companion is always locked second for the order to be fixed
+			int iCompanionLockResult;
+			MG_CHECK(iCompanionLockResult, (iCompanionLockResult = _mutexgear_rwlock_wrlock(&m_wlCompanionRWLock)) == EOK);
+		}
+
 		return bLockedWithTryVariant;
 	}
 
 	void UnlockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
 	{
 		int iUnlockResult;
+
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = _mutexgear_rwlock_wrunlock(&m_wlCompanionRWLock)) == EOK);
+		}
+
 		MG_CHECK(iUnlockResult, (iUnlockResult = _mutexgear_rwlock_wrunlock(&m_wlRWLock)) == EOK);
 	}
 
+	void DowngradeRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		// The system object has no atomic downgrade -- it is emulated with an unlock and a subsequent read lock
+		UnlockRWLockWrite(eoRefExtraObjects);
+
+		int iLockResult;
+		MG_CHECK(iLockResult, (iLockResult = _mutexgear_rwlock_rdlock(&m_wlRWLock)) == EOK);
+	}
+
+	void UnlockRWLockDowngraded(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		int iUnlockResult;
+		MG_CHECK(iUnlockResult, (iUnlockResult = _mutexgear_rwlock_rdunlock(&m_wlRWLock)) == EOK);
+	}
+
+	void ExecuteRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects, mutexgear_rwlock_execute_fn_t fnExecuteProc, void *pvExecuteContext)
+	{
+		// The object has no combined execution -- it is emulated with a write lock held around the call
+		LockRWLockWrite(eoRefExtraObjects);
+		fnExecuteProc(pvExecuteContext);
+		UnlockRWLockWrite(eoRefExtraObjects);
+	}
+
+	void LockRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		// The system object has no upgradable mode -- it is emulated with a write lock acquired in advance
+		int iLockResult;
+		MG_CHECK(iLockResult, (iLockResult = _mutexgear_rwlock_wrlock(&m_wlRWLock)) == EOK);
+	}
+
+	void UpgradeRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
 	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			int iCoupledLockResult;
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = _mutexgear_rwlock_rdlock(&m_wlCompanionRWLock)) == EOK);
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = _mutexgear_rwlock_rdlock(&m_wlRWLock)) == EOK);
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = _mutexgear_rwlock_rdunlock(&m_wlCompanionRWLock)) == EOK);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			int iNestedLockResult;
+			MG_CHECK(iNestedLockResult, (iNestedLockResult = _mutexgear_rwlock_rdlock(&m_wlCompanionRWLock)) == EOK);
+		}
+
 		bool bLockedWithTryVariant;
 
 #if MGTEST_RWLOCK_TEST_TRYRDLOCK
@@ -563,10 +1028,36 @@ public:
 	{
 		int iUnlockResult;
 		MG_CHECK(iUnlockResult, (iUnlockResult = _mutexgear_rwlock_rdunlock(&m_wlRWLock)) == EOK);
+
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = _mutexgear_rwlock_rdunlock(&m_wlCompanionRWLock)) == EOK);
+		}
+	}
+
+	void ReadRWLockOptimistic(CLockReadExtraObjects &eoRefExtraObjects, void (*fnReadProc)(void *), void *pvReadContext)
+	{
+		// The object has no optimistic reads -- they are emulated with a read lock held around the call
+		LockRWLockRead(eoRefExtraObjects);
+		fnReadProc(pvReadContext);
+		UnlockRWLockRead(eoRefExtraObjects);
+	}
+
+	bool RetrieveRWLockState(mutexgear_rwlock_state_t &rsOutState)
+	{
+		// The object provides no state query
+		return false;
+	}
+
+	bool RetrieveRWLockStats(mutexgear_rwlock_stats_t &rsOutStats)
+	{
+		// The object provides no statistics
+		return false;
 	}
 
 private:
 	SYSTEM_C_RWLOCK_VARIANT_T	m_wlRWLock;
+	SYSTEM_C_RWLOCK_VARIANT_T	m_wlCompanionRWLock; // Write-locked together with m_wlRWLock with LIOPT_MULTIPLE_WRITE_LOCKS or used as its parent with LIOPT_COUPLED_LOCKS or LIOPT_NESTED_READS
 };
 
 #if _MGTEST_ANY_SHARED_MUTEX_AVAILABLE
@@ -600,6 +1091,21 @@ public:
 
 	bool LockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			std::lock(m_wlRWLock, m_wlCompanionRWLock);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			// The system object has no coupled locks -- the parent is just held until the object is locked
+			m_wlCompanionRWLock.lock();
+			m_wlRWLock.lock();
+			m_wlCompanionRWLock.unlock();
+			return false;
+		}
+
 		bool bLockedWithTryVariant;
 
 #if MGTEST_RWLOCK_TEST_TRYWRLOCK
@@ -618,11 +1124,59 @@ public:
 
 	void UnlockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			m_wlCompanionRWLock.unlock();
+		}
+
 		m_wlRWLock.unlock();
 	}
 
+	void DowngradeRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		// The system object has no atomic downgrade -- it is emulated with an unlock and a subsequent read lock
+		m_wlRWLock.unlock();
+		m_wlRWLock.lock_shared();
+	}
+
+	void UnlockRWLockDowngraded(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		m_wlRWLock.unlock_shared();
+	}
+
+	void ExecuteRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects, mutexgear_rwlock_execute_fn_t fnExecuteProc, void *pvExecuteContext)
+	{
+		// The object has no combined execution -- it is emulated with a write lock held around the call
+		LockRWLockWrite(eoRefExtraObjects);
+		fnExecuteProc(pvExecuteContext);
+		UnlockRWLockWrite(eoRefExtraObjects);
+	}
+
+	void LockRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		// The system object has no upgradable mode -- it is emulated with a write lock acquired in advance
+		m_wlRWLock.lock();
+	}
+
+	void UpgradeRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
 	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			m_wlCompanionRWLock.lock_shared();
+			m_wlRWLock.lock_shared();
+			m_wlCompanionRWLock.unlock_shared();
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			m_wlCompanionRWLock.lock_shared();
+		}
+
 		bool bLockedWithTryVariant;
 
 #if MGTEST_RWLOCK_TEST_TRYRDLOCK
@@ -642,10 +1196,36 @@ public:
 	void UnlockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
 		m_wlRWLock.unlock_shared();
+
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			m_wlCompanionRWLock.unlock_shared();
+		}
+	}
+
+	void ReadRWLockOptimistic(CLockReadExtraObjects &eoRefExtraObjects, void (*fnReadProc)(void *), void *pvReadContext)
+	{
+		// The object has no optimistic reads -- they are emulated with a read lock held around the call
+		LockRWLockRead(eoRefExtraObjects);
+		fnReadProc(pvReadContext);
+		UnlockRWLockRead(eoRefExtraObjects);
+	}
+
+	bool RetrieveRWLockState(mutexgear_rwlock_state_t &rsOutState)
+	{
+		// The object provides no state query
+		return false;
+	}
+
+	bool RetrieveRWLockStats(mutexgear_rwlock_stats_t &rsOutStats)
+	{
+		// The object provides no statistics
+		return false;
 	}
 
 private:
 	SYSTEM_CPP_RWLOCK_VARIANT_T	m_wlRWLock;
+	SYSTEM_CPP_RWLOCK_VARIANT_T	m_wlCompanionRWLock; // Write-locked together with m_wlRWLock with LIOPT_MULTIPLE_WRITE_LOCKS (with std::lock) or used as its parent with LIOPT_COUPLED_LOCKS or LIOPT_NESTED_READS
 };
 
 
@@ -679,6 +1259,26 @@ public:
 	{
 	}
 
+	void DowngradeRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
+	void UnlockRWLockDowngraded(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
+	void ExecuteRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects, mutexgear_rwlock_execute_fn_t fnExecuteProc, void *pvExecuteContext)
+	{
+	}
+
+	void LockRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
+	void UpgradeRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
 	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
 		return true;
@@ -687,6 +1287,22 @@ public:
 	void UnlockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
 	}
+
+	void ReadRWLockOptimistic(CLockReadExtraObjects &eoRefExtraObjects, void (*fnReadProc)(void *), void *pvReadContext)
+	{
+	}
+
+	bool RetrieveRWLockState(mutexgear_rwlock_state_t &rsOutState)
+	{
+		// The object provides no state query
+		return false;
+	}
+
+	bool RetrieveRWLockStats(mutexgear_rwlock_stats_t &rsOutStats)
+	{
+		// The object provides no statistics
+		return false;
+	}
 };
 
 
@@ -719,10 +1335,14 @@ public:
 			MG_CHECK(iWaiterInitResult, (iWaiterInitResult = mutexgear_completion_waiter_init(&m_cwLockWaiter, NULL)) == EOK);
 
 			mutexgear_completion_item_init(&m_ciLockCompletionItem);
+			mutexgear_completion_item_init(&m_ciParentCompletionItem);
+
+			m_iWriterClass = (tuiImplementationOptions & LIOPT_WRITER_CLASSES) != 0 ? CWriterClassLatencies::AssignWriterClass() : MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL;
 		}
 
 		~CLockWriteExtraObjects()
 		{
+			mutexgear_completion_item_destroy(&m_ciParentCompletionItem);
 			mutexgear_completion_item_destroy(&m_ciLockCompletionItem);
 
 			int iWaiterDestroyResult;
@@ -738,6 +1358,8 @@ public:
 		mutexgear_completion_worker_t		m_cwLockWorker;
 		mutexgear_completion_waiter_t		m_cwLockWaiter;
 		mutexgear_completion_item_t			m_ciLockCompletionItem;
+		mutexgear_completion_item_t			m_ciParentCompletionItem; // The companion object item with LIOPT_COUPLED_LOCKS or LIOPT_NESTED_READS
+		int									m_iWriterClass; // The class to write-lock with LIOPT_WRITER_CLASSES
 	};
 
 	class CLockReadExtraObjects
@@ -747,69 +1369,236 @@ public:
 		{
 		}
 
-		~CLockReadExtraObjects()
+		~CLockReadExtraObjects()
+		{
+		}
+
+		operator CLockWriteExtraObjects &() { return m_eoWriteObjects; }
+
+		CLockWriteExtraObjects				m_eoWriteObjects;
+	};
+
+public:
+	bool LockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		if ((tuiImplementationOptions & LIOPT_THREAD_CONTEXT) != 0)
+		{
+			mutexgear_completion_threadcontext_t *ptcThreadContext;
+
+			int iContextResult;
+			MG_CHECK(iContextResult, (iContextResult = mutexgear_completion_threadcontext_get(&ptcThreadContext)) == EOK);
+
+			int iContextLockResult;
+			MG_CHECK(iContextLockResult, (iContextLockResult = mutexgear_rwlock_wrlock(&m_wlRWLock, &ptcThreadContext->thread_worker, &ptcThreadContext->thread_waiter, &ptcThreadContext->thread_items[0])) == EOK);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			int iMultipleLockResult;
+			MG_CHECK(iMultipleLockResult, (iMultipleLockResult = CMultipleWriteAdapter<trsTryReadSupport, LTL_C>::WriteLock(&m_wlRWLock, &m_wlCompanionRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter)) == EOK);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			int iCoupledLockResult;
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = CCoupledLockAdapter<trsTryReadSupport, LTL_C>::WriteLock(&m_wlRWLock, &m_wlCompanionRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem, &eoRefExtraObjects.m_ciParentCompletionItem)) == EOK);
+			return false;
+		}
+
+		bool bLockedWithTryVariant;
+#if MGTEST_RWLOCK_TEST_TRYWRLOCK
+		// The writes with the classes are not tried to have every lock wait accounted
+		int iLockResult = (tuiImplementationOptions & LIOPT_WRITER_CLASSES) == 0 ? mutexgear_rwlock_trywrlock(&m_wlRWLock) : EBUSY;
+		bLockedWithTryVariant = iLockResult == EOK;
+#else // !MGTEST_RWLOCK_TEST_TRYWRLOCK
+		int iLockResult = EBUSY;
+		bLockedWithTryVariant = false;
+#endif // !MGTEST_RWLOCK_TEST_TRYWRLOCK
+
+		if (!bLockedWithTryVariant)
+		{
+			const int iReadersTillWP = CImplementationOptionsTraits<DECODE_CUSTOM_WP_OPT(tuiImplementationOptions)>::readers_till_wp;
+
+			if ((tuiImplementationOptions & LIOPT_WRITER_CLASSES) != 0)
+			{
+				CWriterClassLatencies::timepoint tpWaitStartTime = CWriterClassLatencies::StartLockWait();
+				MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_wrlock_pri(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem, eoRefExtraObjects.m_iWriterClass)) == EOK);
+				CWriterClassLatencies::FinishLockWait(eoRefExtraObjects.m_iWriterClass, tpWaitStartTime);
+			}
+			else if (iReadersTillWP == 0)
+			{
+				MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_wrlock(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem)) == EOK);
+			}
+			else if (iReadersTillWP == MGTEST_RWLOCK_TIMED_READERS_TILL_WP)
+			{
+				MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_wrlock_twp(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem, (uint64_t)MGTEST_RWLOCK_MICROSECONDS_TILL_WP * 1000)) == EOK);
+			}
+			else
+			{
+				MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem, iReadersTillWP)) == EOK);
+			}
+		}
+
+		return bLockedWithTryVariant;
+	}
+
+	void UnlockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		int iUnlockResult;
+
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = CMultipleWriteAdapter<trsTryReadSupport, LTL_C>::WriteUnlock(&m_wlRWLock, &m_wlCompanionRWLock)) == EOK);
+		}
+		else
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_wrunlock(&m_wlRWLock)) == EOK);
+		}
+	}
+
+	void DowngradeRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		int iDowngradeResult;
+		MG_CHECK(iDowngradeResult, (iDowngradeResult = mutexgear_rwlock_wrdowngrade(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_ciLockCompletionItem)) == EOK);
+	}
+
+	void UnlockRWLockDowngraded(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		int iUnlockResult;
+		MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_ciLockCompletionItem)) == EOK);
+	}
+
+	void ExecuteRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects, mutexgear_rwlock_execute_fn_t fnExecuteProc, void *pvExecuteContext)
+	{
+		int iExecuteResult;
+		MG_CHECK(iExecuteResult, (iExecuteResult = mutexgear_rwlock_wrexecute(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem, fnExecuteProc, pvExecuteContext)) == EOK);
+	}
+
+	void LockRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		int iLockResult;
+		MG_CHECK(iLockResult, (iLockResult = mutexgear_rwlock_uprdlock(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem)) == EOK);
+	}
+
+	void UpgradeRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		int iUpgradeResult;
+		MG_CHECK(iUpgradeResult, (iUpgradeResult = mutexgear_rwlock_rdupgrade(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem)) == EOK);
+	}
+
+	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
+	{
+		if ((tuiImplementationOptions & LIOPT_THREAD_CONTEXT) != 0)
+		{
+			mutexgear_completion_threadcontext_t *ptcThreadContext;
+
+			int iContextResult;
+			MG_CHECK(iContextResult, (iContextResult = mutexgear_completion_threadcontext_get(&ptcThreadContext)) == EOK);
+
+			int iContextLockResult;
+			MG_CHECK(iContextLockResult, (iContextLockResult = mutexgear_rwlock_rdlock(&m_wlRWLock, &ptcThreadContext->thread_worker, &ptcThreadContext->thread_waiter, &ptcThreadContext->thread_items[0])) == EOK);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
 		{
+			int iCoupledLockResult;
+			MG_CHECK(iCoupledLockResult, (iCoupledLockResult = CCoupledLockAdapter<trsTryReadSupport, LTL_C>::ReadLock(&m_wlRWLock, &m_wlCompanionRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWaiter, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem, &eoRefExtraObjects.m_eoWriteObjects.m_ciParentCompletionItem)) == EOK);
+			return false;
 		}
 
-		operator CLockWriteExtraObjects &() { return m_eoWriteObjects; }
-
-		CLockWriteExtraObjects				m_eoWriteObjects;
-	};
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			// The same worker is shared by both the locks with a separate item for each
+			int iNestedLockResult;
+			MG_CHECK(iNestedLockResult, (iNestedLockResult = mutexgear_rwlock_rdlock(&m_wlCompanionRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWaiter, &eoRefExtraObjects.m_eoWriteObjects.m_ciParentCompletionItem)) == EOK);
+		}
 
-public:
-	bool LockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
-	{
 		bool bLockedWithTryVariant;
-#if MGTEST_RWLOCK_TEST_TRYWRLOCK
-		int iLockResult = mutexgear_rwlock_trywrlock(&m_wlRWLock);
+
+		int iLockResult = tryread_adapter_type::TryReadLock(&m_wlRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem);
 		bLockedWithTryVariant = iLockResult == EOK;
-#else // !MGTEST_RWLOCK_TEST_TRYWRLOCK
-		int iLockResult = EBUSY;
-		bLockedWithTryVariant = false;
-#endif // !MGTEST_RWLOCK_TEST_TRYWRLOCK
 
 		if (!bLockedWithTryVariant)
 		{
-			const int iReadersTillWP = CImplementationOptionsTraits<DECODE_CUSTOM_WP_OPT(tuiImplementationOptions)>::readers_till_wp;
-
-			if (iReadersTillWP == 0)
-			{
-				MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_wrlock(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem)) == EOK);
-			}
-			else
-			{
-				MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_wrlock_cwp(&m_wlRWLock, &eoRefExtraObjects.m_cwLockWorker, &eoRefExtraObjects.m_cwLockWaiter, &eoRefExtraObjects.m_ciLockCompletionItem, iReadersTillWP)) == EOK);
-			}
+			MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_rdlock(&m_wlRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWaiter, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem)) == EOK);
 		}
 
 		return bLockedWithTryVariant;
 	}
 
-	void UnlockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	void UnlockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
 		int iUnlockResult;
-		MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_wrunlock(&m_wlRWLock)) == EOK);
+
+		if ((tuiImplementationOptions & LIOPT_THREAD_CONTEXT) != 0)
+		{
+			mutexgear_completion_threadcontext_t *ptcThreadContext;
+
+			int iContextResult;
+			MG_CHECK(iContextResult, (iContextResult = mutexgear_completion_threadcontext_get(&ptcThreadContext)) == EOK);
+
+			MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLock, &ptcThreadContext->thread_worker, &ptcThreadContext->thread_items[0])) == EOK);
+			return;
+		}
+
+		MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem)) == EOK);
+
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_rdunlock(&m_wlCompanionRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_ciParentCompletionItem)) == EOK);
+		}
 	}
 
-	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
+	void ReadRWLockOptimistic(CLockReadExtraObjects &eoRefExtraObjects, void (*fnReadProc)(void *), void *pvReadContext)
 	{
-		bool bLockedWithTryVariant;
+		bool bReadValidated = false;
 
-		int iLockResult = tryread_adapter_type::TryReadLock(&m_wlRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem);
-		bLockedWithTryVariant = iLockResult == EOK;
+		for (unsigned int uiAttemptsRemaining = MGTEST_RWLOCK_OPTIMISTIC_READ_ATTEMPTS; uiAttemptsRemaining != 0; --uiAttemptsRemaining)
+		{
+			mutexgear_rwlock_optread_t orReadSequence;
 
-		if (!bLockedWithTryVariant)
+			int iReadResult;
+			if ((iReadResult = mutexgear_rwlock_optread_begin(&m_wlRWLock, &orReadSequence)) != EOK)
+			{
+				MG_CHECK(iReadResult, iReadResult == EBUSY);
+				break;
+			}
+
+			fnReadProc(pvReadContext);
+
+			if ((iReadResult = mutexgear_rwlock_optread_validate(&m_wlRWLock, orReadSequence)) == EOK)
+			{
+				bReadValidated = true;
+				break;
+			}
+
+			MG_CHECK(iReadResult, iReadResult == EAGAIN);
+		}
+
+		if (!bReadValidated)
 		{
-			MG_CHECK(iLockResult, iLockResult == EBUSY && (iLockResult = mutexgear_rwlock_rdlock(&m_wlRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWaiter, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem)) == EOK);
+			LockRWLockRead(eoRefExtraObjects);
+			fnReadProc(pvReadContext);
+			UnlockRWLockRead(eoRefExtraObjects);
 		}
+	}
 
-		return bLockedWithTryVariant;
+	bool RetrieveRWLockState(mutexgear_rwlock_state_t &rsOutState)
+	{
+		int iStateResult;
+		MG_CHECK(iStateResult, (iStateResult = mutexgear_rwlock_getstate(&m_wlRWLock, &rsOutState)) == EOK);
+		return true;
 	}
 
-	void UnlockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
+	bool RetrieveRWLockStats(mutexgear_rwlock_stats_t &rsOutStats)
 	{
-		int iUnlockResult;
-		MG_CHECK(iUnlockResult, (iUnlockResult = mutexgear_rwlock_rdunlock(&m_wlRWLock, &eoRefExtraObjects.m_eoWriteObjects.m_cwLockWorker, &eoRefExtraObjects.m_eoWriteObjects.m_ciLockCompletionItem)) == EOK);
+		int iStatsResult = mutexgear_rwlock_getstats(&m_wlRWLock, &rsOutStats);
+		MG_ASSERT(iStatsResult == EOK || iStatsResult == ENOSYS);
+
+		return iStatsResult == EOK;
 	}
 
 private:
@@ -820,23 +1609,66 @@ private:
 
 		MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_init(&attr)) == EOK);
 
-		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_CHANNELS) != 0)
+		if (DECODE_WRITE_CHANNELS_OPT(tuiImplementationOptions) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setwritechannels(&attr, CImplementationOptionsTraits<DECODE_WRITE_CHANNELS_OPT(tuiImplementationOptions)>::write_channels)) == EOK);
+		}
+
+		if ((tuiImplementationOptions & LIOPT_NO_FASTPATH) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setfastpath(&attr, 0)) == EOK);
+		}
+
+		if ((tuiImplementationOptions & LIOPT_UPGRADE_WRITES) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setupgradable(&attr, 1)) == EOK);
+		}
+
+		if ((tuiImplementationOptions & LIOPT_STRIPED_READS) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setreadstripes(&attr, MGTEST_RWLOCK_READ_STRIPES)) == EOK);
+		}
+
+		if ((tuiImplementationOptions & LIOPT_ADAPTIVE_SPIN) != 0)
+		{
+			// The feature is optional on the target and the test falls back to the regular locks if it is not available
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setadaptivespin(&attr, 1)) == EOK || iInitResult == ENOSYS);
+		}
+
+		if ((tuiImplementationOptions & LIOPT_WRITE_HANDOFF) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_sethandoff(&attr, 1)) == EOK);
+		}
+
+		if ((tuiImplementationOptions & LIOPT_READER_BIAS) != 0)
 		{
-			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setwritechannels(&attr, CImplementationOptionsTraits<LIOPT_MULTIPLE_WRITE_CHANNELS>::write_channels)) == EOK);
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_setreaderbias(&attr, 1)) == EOK);
 		}
 
 		MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlock_init(&m_wlRWLock, &attr)) == EOK);
 		MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlockattr_destroy(&attr)) == EOK);
+
+		if ((tuiImplementationOptions & (LIOPT_MULTIPLE_WRITE_LOCKS | LIOPT_COUPLED_LOCKS | LIOPT_NESTED_READS)) != 0)
+		{
+			MG_CHECK(iInitResult, (iInitResult = mutexgear_rwlock_init(&m_wlCompanionRWLock, NULL)) == EOK);
+		}
 	}
 
 	void FinalizeRWLockInstance()
 	{
 		int iDestroyResult;
+
+		if ((tuiImplementationOptions & (LIOPT_MULTIPLE_WRITE_LOCKS | LIOPT_COUPLED_LOCKS | LIOPT_NESTED_READS)) != 0)
+		{
+			MG_CHECK(iDestroyResult, (iDestroyResult = mutexgear_rwlock_destroy(&m_wlCompanionRWLock)) == EOK);
+		}
+
 		MG_CHECK(iDestroyResult, (iDestroyResult = mutexgear_rwlock_destroy(&m_wlRWLock)) == EOK);
 	}
 
 private:
 	rwlock_type				m_wlRWLock;
+	mutexgear_rwlock_t		m_wlCompanionRWLock; // Write-locked together with m_wlRWLock with LIOPT_MULTIPLE_WRITE_LOCKS or used as its parent with LIOPT_COUPLED_LOCKS or LIOPT_NESTED_READS
 };
 
 
@@ -848,26 +1680,55 @@ class CRWLockImplementation<trsTryReadSupport, tuiImplementationOptions, LTO_MUT
 	typedef CTryReadAdapter<tuiImplementationOptions, trsTryReadSupport, LTL_CPP> tryread_adapter_type;
 	typedef typename tryread_adapter_type::rwlock_type rwlock_type;
 
+	// The upgradable mode can only be selected with the constructor tag
+	class CUpgradableRWLock:
+		public rwlock_type
+	{
+	public:
+		CUpgradableRWLock(): rwlock_type(mg::upgradable_t()) {}
+	};
+
+	typedef typename std::conditional<(tuiImplementationOptions & LIOPT_UPGRADE_WRITES) != 0, CUpgradableRWLock, rwlock_type>::type rwlock_instance_type;
+	typedef mg::standard_shared_mutex<rwlock_type> standard_rwlock_type;
+
 public:
 	CRWLockImplementation() { InitializeRWLockInstance(); }
 	~CRWLockImplementation() { FinalizeRWLockInstance(); }
 
 public:
+	class CTaskHelperObjects
+	{
+	public:
+		CTaskHelperObjects() { m_hbTaskBourgeois.lock(); }
+		~CTaskHelperObjects() { m_hbTaskBourgeois.unlock(); }
+
+		typename rwlock_type::helper_bourgeois_type m_hbTaskBourgeois;
+		typename rwlock_type::helper_waiter_type m_hwTaskWaiter;
+	};
+
 	class CLockWriteExtraObjects
 	{
 	public:
-		CLockWriteExtraObjects()
+		CLockWriteExtraObjects():
+			m_ciCouplingIterator(m_hbLockBourgeois, m_hwLockWaiter),
+			m_wcWriterClass((tuiImplementationOptions & LIOPT_WRITER_CLASSES) != 0 ? CWriterClassLatencies::AssignWriterClass() : MUTEXGEAR_RWLOCK_WRITERCLASS_NORMAL)
 		{
 			m_hbLockBourgeois.lock();
+			m_mbNestedBourgeois.lock();
 		}
 
 		~CLockWriteExtraObjects()
 		{
+			m_mbNestedBourgeois.unlock();
 			m_hbLockBourgeois.unlock();
 		}
 
 		typename rwlock_type::helper_bourgeois_type m_hbLockBourgeois;
 		typename rwlock_type::helper_waiter_type m_hwLockWaiter;
+		mg::coupled_lock_iterator m_ciCouplingIterator; // Used with LIOPT_COUPLED_LOCKS
+		typename rwlock_type::template helper_multi_bourgeois_type<2> m_mbNestedBourgeois; // Used with LIOPT_NESTED_READS
+		std::unique_ptr<CTaskHelperObjects> m_pthReadTaskHelpers; // The helpers of a read lock held with LIOPT_TASK_HELPERS
+		mg::writer_class m_wcWriterClass; // Used with LIOPT_WRITER_CLASSES
 	};
 
 	class CLockReadExtraObjects
@@ -889,9 +1750,42 @@ public:
 public:
 	bool LockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_STANDARD_INTERFACE) != 0)
+		{
+			m_smStandardRWLock.lock();
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_THREAD_CONTEXT) != 0)
+		{
+			m_wlRWLock.lock(mg::thread_context::current());
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_TASK_HELPERS) != 0)
+		{
+			// The item is not needed after the write lock is acquired
+			CTaskHelperObjects thTaskHelpers;
+			m_wlRWLock.lock(thTaskHelpers.m_hbTaskBourgeois, thTaskHelpers.m_hwTaskWaiter);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			CMultipleWriteAdapter<trsTryReadSupport, LTL_CPP>::WriteLock(m_wlRWLock, m_wlCompanionRWLock, eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			CCoupledLockAdapter<trsTryReadSupport, LTL_CPP>::WriteLock(m_wlRWLock, m_wlCompanionRWLock, eoRefExtraObjects);
+			return false;
+		}
+
 		bool bLockedWithTryVariant;
 #if MGTEST_RWLOCK_TEST_TRYWRLOCK
-		bLockedWithTryVariant = m_wlRWLock.try_lock();
+		// The writes with the classes are not tried to have every lock wait accounted
+		bLockedWithTryVariant = (tuiImplementationOptions & LIOPT_WRITER_CLASSES) == 0 && m_wlRWLock.try_lock();
 #else // !MGTEST_RWLOCK_TEST_TRYWRLOCK
 		bLockedWithTryVariant = false;
 #endif // !MGTEST_RWLOCK_TEST_TRYWRLOCK
@@ -900,7 +1794,18 @@ public:
 		{
 			const int iReadersTillWP = CImplementationOptionsTraits<DECODE_CUSTOM_WP_OPT(tuiImplementationOptions)>::readers_till_wp;
 
-			if (iReadersTillWP == 0)
+			if ((tuiImplementationOptions & LIOPT_TIMED_LOCKS) != 0)
+			{
+				// Time out and retry repeatedly to exercise the wait withdrawal paths
+				while (!m_wlRWLock.try_lock_for(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter, std::chrono::microseconds(MGTEST_RWLOCK_TIMED_LOCK_MICROSECONDS))) {}
+			}
+			else if ((tuiImplementationOptions & LIOPT_WRITER_CLASSES) != 0)
+			{
+				CWriterClassLatencies::timepoint tpWaitStartTime = CWriterClassLatencies::StartLockWait();
+				m_wlRWLock.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter, eoRefExtraObjects.m_wcWriterClass);
+				CWriterClassLatencies::FinishLockWait(eoRefExtraObjects.m_wcWriterClass.value(), tpWaitStartTime);
+			}
+			else if (iReadersTillWP == 0)
 			{
 				m_wlRWLock.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
 			}
@@ -908,6 +1813,14 @@ public:
 			{
 				m_wlRWLock.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter, mg::no_wp_t());
 			}
+			else if (iReadersTillWP == MGTEST_RWLOCK_ADAPTIVE_READERS_TILL_WP)
+			{
+				m_wlRWLock.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter, mg::adaptive_wp_t());
+			}
+			else if (iReadersTillWP == MGTEST_RWLOCK_TIMED_READERS_TILL_WP)
+			{
+				m_wlRWLock.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter, std::chrono::microseconds(MGTEST_RWLOCK_MICROSECONDS_TILL_WP));
+			}
 			else
 			{
 				m_wlRWLock.lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter, iReadersTillWP);
@@ -919,18 +1832,109 @@ public:
 
 	void UnlockRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
 	{
-		m_wlRWLock.unlock();
+		if ((tuiImplementationOptions & LIOPT_STANDARD_INTERFACE) != 0)
+		{
+			m_smStandardRWLock.unlock();
+		}
+		else if ((tuiImplementationOptions & LIOPT_MULTIPLE_WRITE_LOCKS) != 0)
+		{
+			CMultipleWriteAdapter<trsTryReadSupport, LTL_CPP>::WriteUnlock(m_wlRWLock, m_wlCompanionRWLock);
+		}
+		else if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			CCoupledLockAdapter<trsTryReadSupport, LTL_CPP>::WriteUnlock(m_wlRWLock, eoRefExtraObjects);
+		}
+		else
+		{
+			m_wlRWLock.unlock();
+		}
+	}
+
+	void DowngradeRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		m_wlRWLock.unlock_and_lock_shared(eoRefExtraObjects.m_hbLockBourgeois);
+	}
+
+	void UnlockRWLockDowngraded(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		m_wlRWLock.unlock_shared(eoRefExtraObjects.m_hbLockBourgeois);
+	}
+
+	void ExecuteRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects, mutexgear_rwlock_execute_fn_t fnExecuteProc, void *pvExecuteContext)
+	{
+		// The object has no combined execution -- it is emulated with a write lock held around the call
+		LockRWLockWrite(eoRefExtraObjects);
+		fnExecuteProc(pvExecuteContext);
+		UnlockRWLockWrite(eoRefExtraObjects);
+	}
+
+	void LockRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		m_wlRWLock.lock_upgrade(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
+	}
+
+	void UpgradeRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+		m_wlRWLock.unlock_upgrade_and_lock(eoRefExtraObjects.m_hbLockBourgeois, eoRefExtraObjects.m_hwLockWaiter);
 	}
 
 	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
+		if ((tuiImplementationOptions & LIOPT_STANDARD_INTERFACE) != 0)
+		{
+			bool bLockedWithTryVariant = (trsTryReadSupport == TRS_WITH_TRYREAD_SUPPORT) && m_smStandardRWLock.try_lock_shared();
+
+			if (!bLockedWithTryVariant)
+			{
+				m_smStandardRWLock.lock_shared();
+			}
+
+			return bLockedWithTryVariant;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_THREAD_CONTEXT) != 0)
+		{
+			m_wlRWLock.lock_shared(mg::thread_context::current());
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_TASK_HELPERS) != 0)
+		{
+			std::unique_ptr<CTaskHelperObjects> &pthRefTaskHelpers = eoRefExtraObjects.m_eoWriteObjects.m_pthReadTaskHelpers;
+			pthRefTaskHelpers.reset(new CTaskHelperObjects());
+			m_wlRWLock.lock_shared(pthRefTaskHelpers->m_hbTaskBourgeois, pthRefTaskHelpers->m_hwTaskWaiter);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			CCoupledLockAdapter<trsTryReadSupport, LTL_CPP>::ReadLock(m_wlRWLock, m_wlCompanionRWLock, eoRefExtraObjects.m_eoWriteObjects);
+			return false;
+		}
+
+		if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			// A single worker serves both the locks with the items of the multi-item helper
+			auto &mbNestedBourgeois = eoRefExtraObjects.m_eoWriteObjects.m_mbNestedBourgeois;
+			m_wlCompanionRWLock.lock_shared(mbNestedBourgeois.get_worker(), eoRefExtraObjects.m_eoWriteObjects.m_hwLockWaiter, mbNestedBourgeois.get_item(0));
+			m_wlRWLock.lock_shared(mbNestedBourgeois.get_worker(), eoRefExtraObjects.m_eoWriteObjects.m_hwLockWaiter, mbNestedBourgeois.get_item(1));
+			return false;
+		}
+
 		bool bLockedWithTryVariant;
 
 		bLockedWithTryVariant = tryread_adapter_type::TryReadLock(m_wlRWLock, eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois);
 
 		if (!bLockedWithTryVariant)
 		{
-			m_wlRWLock.lock_shared(eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois, eoRefExtraObjects.m_eoWriteObjects.m_hwLockWaiter);
+			if ((tuiImplementationOptions & LIOPT_TIMED_LOCKS) != 0)
+			{
+				while (!m_wlRWLock.try_lock_shared_for(eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois, eoRefExtraObjects.m_eoWriteObjects.m_hwLockWaiter, std::chrono::microseconds(MGTEST_RWLOCK_TIMED_LOCK_MICROSECONDS))) {}
+			}
+			else
+			{
+				m_wlRWLock.lock_shared(eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois, eoRefExtraObjects.m_eoWriteObjects.m_hwLockWaiter);
+			}
 		}
 
 		return bLockedWithTryVariant;
@@ -938,7 +1942,50 @@ public:
 
 	void UnlockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
-		m_wlRWLock.unlock_shared(eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois);
+		if ((tuiImplementationOptions & LIOPT_STANDARD_INTERFACE) != 0)
+		{
+			m_smStandardRWLock.unlock_shared();
+		}
+		else if ((tuiImplementationOptions & LIOPT_THREAD_CONTEXT) != 0)
+		{
+			m_wlRWLock.unlock_shared(mg::thread_context::current());
+		}
+		else if ((tuiImplementationOptions & LIOPT_TASK_HELPERS) != 0)
+		{
+			std::unique_ptr<CTaskHelperObjects> &pthRefTaskHelpers = eoRefExtraObjects.m_eoWriteObjects.m_pthReadTaskHelpers;
+			m_wlRWLock.unlock_shared(pthRefTaskHelpers->m_hbTaskBourgeois);
+			pthRefTaskHelpers.reset();
+		}
+		else if ((tuiImplementationOptions & LIOPT_COUPLED_LOCKS) != 0)
+		{
+			CCoupledLockAdapter<trsTryReadSupport, LTL_CPP>::ReadUnlock(m_wlRWLock, eoRefExtraObjects.m_eoWriteObjects);
+		}
+		else if ((tuiImplementationOptions & LIOPT_NESTED_READS) != 0)
+		{
+			auto &mbNestedBourgeois = eoRefExtraObjects.m_eoWriteObjects.m_mbNestedBourgeois;
+			m_wlRWLock.unlock_shared(mbNestedBourgeois.get_worker(), mbNestedBourgeois.get_item(1));
+			m_wlCompanionRWLock.unlock_shared(mbNestedBourgeois.get_worker(), mbNestedBourgeois.get_item(0));
+		}
+		else
+		{
+			m_wlRWLock.unlock_shared(eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois);
+		}
+	}
+
+	void ReadRWLockOptimistic(CLockReadExtraObjects &eoRefExtraObjects, void (*fnReadProc)(void *), void *pvReadContext)
+	{
+		m_wlRWLock.optimistic_read(eoRefExtraObjects.m_eoWriteObjects.m_hbLockBourgeois, eoRefExtraObjects.m_eoWriteObjects.m_hwLockWaiter, [=]() { fnReadProc(pvReadContext); }, MGTEST_RWLOCK_OPTIMISTIC_READ_ATTEMPTS);
+	}
+
+	bool RetrieveRWLockState(mutexgear_rwlock_state_t &rsOutState)
+	{
+		rsOutState = (tuiImplementationOptions & LIOPT_STANDARD_INTERFACE) != 0 ? m_smStandardRWLock.wrapped_mutex().get_state() : m_wlRWLock.get_state();
+		return true;
+	}
+
+	bool RetrieveRWLockStats(mutexgear_rwlock_stats_t &rsOutStats)
+	{
+		return (tuiImplementationOptions & LIOPT_STANDARD_INTERFACE) != 0 ? m_smStandardRWLock.wrapped_mutex().get_stats(rsOutStats) : m_wlRWLock.get_stats(rsOutStats);
 	}
 
 private:
@@ -951,7 +1998,9 @@ private:
 	}
 
 private:
-	rwlock_type				m_wlRWLock;
+	rwlock_instance_type	m_wlRWLock;
+	mg::shared_mutex		m_wlCompanionRWLock; // Write-locked together with m_wlRWLock with LIOPT_MULTIPLE_WRITE_LOCKS or used as its parent with LIOPT_COUPLED_LOCKS or LIOPT_NESTED_READS
+	standard_rwlock_type	m_smStandardRWLock; // Used instead of m_wlRWLock with LIOPT_STANDARD_INTERFACE
 };
 
 
@@ -1003,6 +2052,26 @@ public:
 	{
 	}
 
+	void DowngradeRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
+	void UnlockRWLockDowngraded(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
+	void ExecuteRWLockWrite(CLockWriteExtraObjects &eoRefExtraObjects, mutexgear_rwlock_execute_fn_t fnExecuteProc, void *pvExecuteContext)
+	{
+	}
+
+	void LockRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
+	void UpgradeRWLockUpgradable(CLockWriteExtraObjects &eoRefExtraObjects)
+	{
+	}
+
 	bool LockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
 		return true;
@@ -1011,6 +2080,22 @@ public:
 	void UnlockRWLockRead(CLockReadExtraObjects &eoRefExtraObjects)
 	{
 	}
+
+	void ReadRWLockOptimistic(CLockReadExtraObjects &eoRefExtraObjects, void (*fnReadProc)(void *), void *pvReadContext)
+	{
+	}
+
+	bool RetrieveRWLockState(mutexgear_rwlock_state_t &rsOutState)
+	{
+		// The object provides no state query
+		return false;
+	}
+
+	bool RetrieveRWLockStats(mutexgear_rwlock_stats_t &rsOutStats)
+	{
+		// The object provides no statistics
+		return false;
+	}
 };
 
 
@@ -1097,7 +2182,8 @@ private:
 
 	void WaitTestThreadsReady(CThreadExecutionBarrier &sbStartBarrier);
 	void LaunchTheTest(CThreadExecutionBarrier &sbStartBarrier);
-	void WaitTheTestEnd(CThreadExecutionBarrier &sbFinishBarrier);
+	template<class TRWLockImplementation>
+	void WaitTheTestEnd(CThreadExecutionBarrier &sbFinishBarrier, TRWLockImplementation &liRefRWLock, CRWLockLockTestProgress &tpRefProgressInstance);
 
 	void InitializeTestResults(threadcntint ciWriterCount, threadcntint ciReraderCount, EMGTESTFEATURELEVEL flTestLevel);
 	void PublishTestResults(ERWLOCKFINETEST ftTestKind, threadcntint ciWriterCount, threadcntint ciReraderCount, timepoint tpRunStartTime, 
@@ -1143,6 +2229,7 @@ public:
 	CRWLockLockTestProgress()
 	{
 		ResetInstance();
+		ResetPeakState();
 	}
 
 public:
@@ -1159,8 +2246,69 @@ public:
 		return CRWLockLockTestBase::atomic_fetch_add_relaxed_operationidxint(&m_iiOperationIndexStorage, 1);
 	}
 
+public:
+	// The peak state is recorded by the main thread only and is accumulated over all the object runs (ResetInstance() does not clear it)
+	void ResetPeakState()
+	{
+		m_siPeakActiveReaders = 0;
+		m_siPeakQueuedWriters = 0;
+		m_siPeakQueuedReaders = 0;
+		m_uiStateSampleCount = 0;
+		memset(&m_rsAccumulatedStats, 0, sizeof(m_rsAccumulatedStats));
+		m_uiStatsObjectCount = 0;
+	}
+
+	void RecordRWLockState(const mutexgear_rwlock_state_t &rsState)
+	{
+		m_siPeakActiveReaders = std::max(m_siPeakActiveReaders, rsState.active_readers);
+		m_siPeakQueuedWriters = std::max(m_siPeakQueuedWriters, rsState.queued_writers);
+		m_siPeakQueuedReaders = std::max(m_siPeakQueuedReaders, rsState.queued_readers);
+		++m_uiStateSampleCount;
+	}
+
+	void RecordRWLockStats(const mutexgear_rwlock_stats_t &rsStats)
+	{
+		m_rsAccumulatedStats.fastpath_reads += rsStats.fastpath_reads;
+		m_rsAccumulatedStats.express_reads += rsStats.express_reads;
+		m_rsAccumulatedStats.slow_reads += rsStats.slow_reads;
+		m_rsAccumulatedStats.writes += rsStats.writes;
+		m_rsAccumulatedStats.writer_priority_claims += rsStats.writer_priority_claims;
+		m_rsAccumulatedStats.reader_push_lock_waits += rsStats.reader_push_lock_waits;
+		m_rsAccumulatedStats.unlockandwaits += rsStats.unlockandwaits;
+		m_rsAccumulatedStats.total_wait_ns += rsStats.total_wait_ns;
+		m_rsAccumulatedStats.max_wait_ns = std::max(m_rsAccumulatedStats.max_wait_ns, rsStats.max_wait_ns);
+		m_rsAccumulatedStats.total_hold_ns += rsStats.total_hold_ns;
+		m_rsAccumulatedStats.max_hold_ns = std::max(m_rsAccumulatedStats.max_hold_ns, rsStats.max_hold_ns);
+		++m_uiStatsObjectCount;
+	}
+
+	void PrintPeakState() const
+	{
+		if (m_uiStateSampleCount != 0)
+		{
+			printf("[%u]R/QW/QR=%lu/%lu/%lu peak: ", m_uiStateSampleCount, (unsigned long)m_siPeakActiveReaders, (unsigned long)m_siPeakQueuedWriters, (unsigned long)m_siPeakQueuedReaders);
+		}
+
+		if (m_uiStatsObjectCount != 0)
+		{
+			// The wait and hold times are printed in microseconds
+			printf("[%u]FR/ER/SR/W/WP/PL/UW=%lu/%lu/%lu/%lu/%lu/%lu/%lu Wt/Wm/Ht/Hm=%lu/%lu/%lu/%lu stats: ", m_uiStatsObjectCount, 
+				(unsigned long)m_rsAccumulatedStats.fastpath_reads, (unsigned long)m_rsAccumulatedStats.express_reads, (unsigned long)m_rsAccumulatedStats.slow_reads, 
+				(unsigned long)m_rsAccumulatedStats.writes, (unsigned long)m_rsAccumulatedStats.writer_priority_claims, (unsigned long)m_rsAccumulatedStats.reader_push_lock_waits, 
+				(unsigned long)m_rsAccumulatedStats.unlockandwaits, 
+				(unsigned long)(m_rsAccumulatedStats.total_wait_ns / 1000), (unsigned long)(m_rsAccumulatedStats.max_wait_ns / 1000), 
+				(unsigned long)(m_rsAccumulatedStats.total_hold_ns / 1000), (unsigned long)(m_rsAccumulatedStats.max_hold_ns / 1000));
+		}
+	}
+
 private:
 	volatile atomic_operationidxint	m_iiOperationIndexStorage;
+	size_t					m_siPeakActiveReaders;
+	size_t					m_siPeakQueuedWriters;
+	size_t					m_siPeakQueuedReaders;
+	unsigned int			m_uiStateSampleCount;
+	mutexgear_rwlock_stats_t	m_rsAccumulatedStats;
+	unsigned int			m_uiStatsObjectCount;
 };
 
 
@@ -1301,6 +2449,12 @@ public:
 	static void IncrementWrites() { storage_type uiPrevLockStatus = m_uiLockStatus.fetch_or(1, std::memory_order_relaxed); MG_CHECK(uiPrevLockStatus, uiPrevLockStatus == 0); }
 	static void DecrementWrites() { storage_type uiPrevLockStatus = m_uiLockStatus.fetch_xor(1, std::memory_order_relaxed); MG_CHECK(uiPrevLockStatus, uiPrevLockStatus == 1); }
 
+	static void ExecuteWrite(void *pvExecuteContext) { IncrementWrites(); DecrementWrites(); }
+
+	// A validated optimistic read must not have observed a write lock owner
+	static void ObserveLockStatus(void *pvStatusStorage) { *static_cast<storage_type *>(pvStatusStorage) = m_uiLockStatus.load(std::memory_order_relaxed); }
+	static void CheckObservedRead(storage_type uiObservedLockStatus) { MG_CHECK(uiObservedLockStatus, (uiObservedLockStatus & 1) == 0); }
+
 private:
 	static std::atomic<storage_type>			m_uiLockStatus;
 };
@@ -1336,20 +2490,59 @@ public:
 	typedef CRWLockLockTestBase::iterationcntint iterationcntint;
 	typedef CRWLockLockTestBase::operationidxint operationidxint;
 
-	static operationidxint GetThreadOperationCount(iterationcntint uiIterationCount) { return (operationidxint)uiIterationCount * LOK__MAX; }
+	static operationidxint GetThreadOperationCount(iterationcntint uiIterationCount) { return (operationidxint)uiIterationCount * LOK__MAX; }
+
+	bool ApplyLock(COperationExtraObjects &eoRefExtraObjects, unsigned uiRandomData)
+	{
+		bool bLockedWithTryVariant;
+
+		if ((tuiImplementationOptions & LIOPT_COMBINED_WRITES) != 0)
+		{
+			// The write is validated within the executed procedure and there is nothing left to be released
+			m_liRWLockInstance.ExecuteRWLockWrite(eoRefExtraObjects, &CRWLockValidator::ExecuteWrite, NULL);
+
+			bLockedWithTryVariant = false;
+		}
+		else if ((tuiImplementationOptions & LIOPT_UPGRADE_WRITES) == 0 || (uiRandomData & UPGRADE_SELECTION_BIT) == 0)
+		{
+			bLockedWithTryVariant = m_liRWLockInstance.LockRWLockWrite(eoRefExtraObjects);
+			CRWLockValidator::IncrementWrites();
+		}
+		else
+		{
+			m_liRWLockInstance.LockRWLockUpgradable(eoRefExtraObjects);
+			CRWLockValidator::IncrementReads();
+
+			CRWLockValidator::DecrementReads();
+			m_liRWLockInstance.UpgradeRWLockUpgradable(eoRefExtraObjects);
+			CRWLockValidator::IncrementWrites();
 
-	bool ApplyLock(COperationExtraObjects &eoRefExtraObjects, unsigned uiRandomData)
-	{
-		bool bLockedWithTryVariant = m_liRWLockInstance.LockRWLockWrite(eoRefExtraObjects);
-		CRWLockValidator::IncrementWrites();
+			bLockedWithTryVariant = false;
+		}
 
 		return bLockedWithTryVariant;
 	}
 
 	void ReleaseLock(COperationExtraObjects &eoRefExtraObjects, unsigned uiRandomData)
 	{
-		CRWLockValidator::DecrementWrites();
-		m_liRWLockInstance.UnlockRWLockWrite(eoRefExtraObjects);
+		if ((tuiImplementationOptions & LIOPT_COMBINED_WRITES) != 0)
+		{
+			// Nothing to be done -- the write has been completed in ApplyLock()
+		}
+		else if ((tuiImplementationOptions & LIOPT_DOWNGRADE_WRITES) == 0)
+		{
+			CRWLockValidator::DecrementWrites();
+			m_liRWLockInstance.UnlockRWLockWrite(eoRefExtraObjects);
+		}
+		else
+		{
+			CRWLockValidator::DecrementWrites();
+			m_liRWLockInstance.DowngradeRWLockWrite(eoRefExtraObjects);
+			CRWLockValidator::IncrementReads();
+
+			CRWLockValidator::DecrementReads();
+			m_liRWLockInstance.UnlockRWLockDowngraded(eoRefExtraObjects);
+		}
 	}
 
 private:
@@ -1385,14 +2578,44 @@ public:
 		// ...
 		if (tuiReaderWriteDivisor == 0 || (uiRandomData & (tuiReaderWriteDivisor - 1)) != 0)
 		{
-			bLockedWithTryVariant = m_liRWLockInstance.LockRWLockRead(eoRefExtraObjects);
-			CRWLockValidator::IncrementReads();
+			if ((tuiImplementationOptions & LIOPT_OPTIMISTIC_READS) != 0)
+			{
+				// The read is validated here and there is nothing left to be released
+				CRWLockValidator::storage_type uiObservedLockStatus = 0;
+				m_liRWLockInstance.ReadRWLockOptimistic(eoRefExtraObjects, &CRWLockValidator::ObserveLockStatus, &uiObservedLockStatus);
+				CRWLockValidator::CheckObservedRead(uiObservedLockStatus);
+
+				bLockedWithTryVariant = false;
+			}
+			else
+			{
+				bLockedWithTryVariant = m_liRWLockInstance.LockRWLockRead(eoRefExtraObjects);
+				CRWLockValidator::IncrementReads();
+			}
 		}
-		else
+		else if ((tuiImplementationOptions & LIOPT_COMBINED_WRITES) != 0)
+		{
+			// The write is validated within the executed procedure and there is nothing left to be released
+			m_liRWLockInstance.ExecuteRWLockWrite(eoRefExtraObjects, &CRWLockValidator::ExecuteWrite, NULL);
+
+			bLockedWithTryVariant = false;
+		}
+		else if ((tuiImplementationOptions & LIOPT_UPGRADE_WRITES) == 0 || (uiRandomData & UPGRADE_SELECTION_BIT) == 0)
 		{
 			bLockedWithTryVariant = m_liRWLockInstance.LockRWLockWrite(eoRefExtraObjects);
 			CRWLockValidator::IncrementWrites();
 		}
+		else
+		{
+			m_liRWLockInstance.LockRWLockUpgradable(eoRefExtraObjects);
+			CRWLockValidator::IncrementReads();
+
+			CRWLockValidator::DecrementReads();
+			m_liRWLockInstance.UpgradeRWLockUpgradable(eoRefExtraObjects);
+			CRWLockValidator::IncrementWrites();
+
+			bLockedWithTryVariant = false;
+		}
 
 		return bLockedWithTryVariant;
 	}
@@ -1403,14 +2626,34 @@ public:
 		// ...
 		if (tuiReaderWriteDivisor == 0 || (uiRandomData & (tuiReaderWriteDivisor - 1)) != 0)
 		{
-			CRWLockValidator::DecrementReads();
-			m_liRWLockInstance.UnlockRWLockRead(eoRefExtraObjects);
+			if ((tuiImplementationOptions & LIOPT_OPTIMISTIC_READS) != 0)
+			{
+				// Nothing to be done -- the read has been completed in ApplyLock()
+			}
+			else
+			{
+				CRWLockValidator::DecrementReads();
+				m_liRWLockInstance.UnlockRWLockRead(eoRefExtraObjects);
+			}
 		}
-		else
+		else if ((tuiImplementationOptions & LIOPT_COMBINED_WRITES) != 0)
+		{
+			// Nothing to be done -- the write has been completed in ApplyLock()
+		}
+		else if ((tuiImplementationOptions & LIOPT_DOWNGRADE_WRITES) == 0)
 		{
 			CRWLockValidator::DecrementWrites();
 			m_liRWLockInstance.UnlockRWLockWrite(eoRefExtraObjects);
 		}
+		else
+		{
+			CRWLockValidator::DecrementWrites();
+			m_liRWLockInstance.DowngradeRWLockWrite(eoRefExtraObjects);
+			CRWLockValidator::IncrementReads();
+
+			CRWLockValidator::DecrementReads();
+			m_liRWLockInstance.UnlockRWLockDowngraded(eoRefExtraObjects);
+		}
 	}
 
 private:
@@ -1426,10 +2669,10 @@ static const int g_iTestFeatureNameWidth = 33;
 static const char g_ascFeatureTestingText[] = "Testing ";
 static const char g_ascPostFeatureSuffix[] = ": ";
 
-static const char g_ascLockTestTableCaption[] = "          Sys         /          MG         /        MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_MINIMAL_READERS_TILL_WP) "WP       /        MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_AVERAGE_READERS_TILL_WP) "WP       /        MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_SUBSTANTIAL_READERS_TILL_WP) "WP       /        MG-!WP       ";
-static const char g_ascLockTestTableSubCapn[] = "  Total,  SBID , MBID / Total,  SBID , MBID / Total,  SBID , MBID "                                                           "/ Total,  SBID , MBID "                                                           "/ Total,  SBID , MBID "                                                               "/ Total,  SBID , MBID ";
+static const char g_ascLockTestTableCaption[] = "          Sys         /          MG         /        MG-!FP       /        MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_MINIMAL_READERS_TILL_WP) "WP       /        MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_AVERAGE_READERS_TILL_WP) "WP       /        MG-" MAKE_STRING_LITERAL(MGTEST_RWLOCK_SUBSTANTIAL_READERS_TILL_WP) "WP       /        MG-!WP       /        MG-AWP       /        MG-TWP       ";
+static const char g_ascLockTestTableSubCapn[] = "  Total,  SBID , MBID / Total,  SBID , MBID / Total,  SBID , MBID / Total,  SBID , MBID "                                                           "/ Total,  SBID , MBID "                                                           "/ Total,  SBID , MBID "                                                               "/ Total,  SBID , MBID "                       "/ Total,  SBID , MBID "                       "/ Total,  SBID , MBID ";
 
-static const char g_ascLockTestTimesFormat[] = "(%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu): ";
+static const char g_ascLockTestTimesFormat[] = "(%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu/%2lu.%.03lu,%3lu.%.03lu,%2lu.%.03lu): ";
 
 
 template<unsigned int tuiWriterCount, unsigned int tuiReaderCount, unsigned int tuiReaderWriteDivisor, unsigned int tuiImplementationOptions, ERWLOCKTESTTRYREADSUPPORT trsTryReadSupport, ERWLOCKLOCKTESTLANGUAGE ttlTestLanguage>
@@ -1457,6 +2700,11 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 
 	timepoint tpRunStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
+	if ((tuiImplementationOptions & LIOPT_WRITER_CLASSES) != 0)
+	{
+		CWriterClassLatencies::ResetStatistics();
+	}
+
 	{
 		const ERWLOCKFINETEST ftTestKind = LFT_SYSTEM;
 		const ERWLOCKLOCKTESTOBJECT toTestedObjectKind = (ERWLOCKLOCKTESTOBJECT)CRWLockFineTestTraits<ftTestKind>::test_object;
@@ -1480,7 +2728,7 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
 			LaunchTheTest(sbStartBarrier);
-			WaitTheTestEnd(sbFinishBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
 
 			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
@@ -1526,7 +2774,51 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
 			LaunchTheTest(sbStartBarrier);
-			WaitTheTestEnd(sbFinishBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
+
+			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
+
+			timeduration tdTestDuration = atdObjectTestDurations[ftTestKind] = tpTestEndTime - tpTestStartTime;
+
+			timeduration tdTotalUnavailabilityTime, tdMaxUnavailabilityTime;
+			FreeTestThreads(sbExitBarrier, LOCKTEST_THREAD_COUNT, tdTotalUnavailabilityTime, tdMaxUnavailabilityTime);
+			atdObjectTestTotalUnavailabilityTimes[ftTestKind] = tdTotalUnavailabilityTime;
+			atdObjectTestMaxUnavailabilityTimes[ftTestKind] = tdMaxUnavailabilityTime;
+
+			PublishTestResults(ftTestKind, LOCKTEST_WRITER_COUNT, LOCKTEST_READER_COUNT, tpRunStartTime, flLevelToTest, tdTestDuration, tdTotalUnavailabilityTime, tdMaxUnavailabilityTime);
+
+			sbStartBarrier.ResetInstance(LOCKTEST_THREAD_COUNT);
+			sbFinishBarrier.ResetInstance(LOCKTEST_THREAD_COUNT);
+			sbExitBarrier.ResetInstance(0);
+			tpProgressInstance.ResetInstance();
+		}
+	}
+
+	{
+		const ERWLOCKFINETEST ftTestKind = LFT_MUTEXGEAR_NO_FASTPATH;
+		const ERWLOCKLOCKTESTOBJECT toTestedObjectKind = (ERWLOCKLOCKTESTOBJECT)CRWLockFineTestTraits<ftTestKind>::test_object;
+		const unsigned uiCustomWPOption = CRWLockFineTestTraits<ftTestKind>::custom_wp_opt;
+		const unsigned uiFastpathOption = CRWLockFineTestTraits<ftTestKind>::fastpath_opt;
+
+		// The fast path can only be disabled via attributes that the C++ wrapper does not accept, and the try-read variant does not implement it
+		if (ttlTestLanguage == LTL_CPP || trsTryReadSupport == TRS_WITH_TRYREAD_SUPPORT
+			|| (uiCustomWPOption != 0 && bSingleOperationTest))
+		{
+			// Do nothing
+		}
+		else
+		{
+			const unsigned uiCustomizedImplementationOptions = tuiImplementationOptions | uiFastpathOption | ENCODE_CUSTOM_WP_OPT(uiCustomWPOption);
+			CRWLockImplementation<trsTryReadSupport, uiCustomizedImplementationOptions, toTestedObjectKind, ttlTestLanguage> liRWLock;
+			AllocateTestThreads<uiCustomizedImplementationOptions, toTestedObjectKind>(liRWLock, LOCKTEST_WRITER_COUNT, LOCKTEST_READER_COUNT, tpRunStartTime, sbStartBarrier, sbFinishBarrier, sbExitBarrier, tpProgressInstance);
+
+			WaitTestThreadsReady(sbStartBarrier);
+			CRandomContextProvider::RefreshRandomsCache();
+
+			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
+
+			LaunchTheTest(sbStartBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
 
 			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
@@ -1572,7 +2864,7 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
 			LaunchTheTest(sbStartBarrier);
-			WaitTheTestEnd(sbFinishBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
 
 			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
@@ -1618,7 +2910,7 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
 			LaunchTheTest(sbStartBarrier);
-			WaitTheTestEnd(sbFinishBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
 
 			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
@@ -1664,7 +2956,7 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
 			LaunchTheTest(sbStartBarrier);
-			WaitTheTestEnd(sbFinishBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
 
 			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
@@ -1710,7 +3002,99 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
 			LaunchTheTest(sbStartBarrier);
-			WaitTheTestEnd(sbFinishBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
+
+			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
+
+			timeduration tdTestDuration = atdObjectTestDurations[ftTestKind] = tpTestEndTime - tpTestStartTime;
+
+			timeduration tdTotalUnavailabilityTime, tdMaxUnavailabilityTime;
+			FreeTestThreads(sbExitBarrier, LOCKTEST_THREAD_COUNT, tdTotalUnavailabilityTime, tdMaxUnavailabilityTime);
+			atdObjectTestTotalUnavailabilityTimes[ftTestKind] = tdTotalUnavailabilityTime;
+			atdObjectTestMaxUnavailabilityTimes[ftTestKind] = tdMaxUnavailabilityTime;
+
+			PublishTestResults(ftTestKind, LOCKTEST_WRITER_COUNT, LOCKTEST_READER_COUNT, tpRunStartTime, flLevelToTest, tdTestDuration, tdTotalUnavailabilityTime, tdMaxUnavailabilityTime);
+
+			sbStartBarrier.ResetInstance(LOCKTEST_THREAD_COUNT);
+			sbFinishBarrier.ResetInstance(LOCKTEST_THREAD_COUNT);
+			sbExitBarrier.ResetInstance(0);
+			tpProgressInstance.ResetInstance();
+		}
+	}
+
+	{
+		const ERWLOCKFINETEST ftTestKind = LFT_MUTEXGEAR_ADAPTIVE_TO_WP;
+		const ERWLOCKLOCKTESTOBJECT toTestedObjectKind = (ERWLOCKLOCKTESTOBJECT)CRWLockFineTestTraits<ftTestKind>::test_object;
+		const unsigned uiCustomWPOption = CRWLockFineTestTraits<ftTestKind>::custom_wp_opt;
+
+		if (
+#if !_MGTEST_HAVE_CXX11
+			ttlTestLanguage == LTL_CPP ||
+#endif
+			(uiCustomWPOption != 0 && bSingleOperationTest)
+			)
+		{
+			// Do nothing
+		}
+		else
+		{
+			const unsigned uiCustomizedImplementationOptions = tuiImplementationOptions | ENCODE_CUSTOM_WP_OPT(uiCustomWPOption);
+			CRWLockImplementation<trsTryReadSupport, uiCustomizedImplementationOptions, toTestedObjectKind, ttlTestLanguage> liRWLock;
+			AllocateTestThreads<uiCustomizedImplementationOptions, toTestedObjectKind>(liRWLock, LOCKTEST_WRITER_COUNT, LOCKTEST_READER_COUNT, tpRunStartTime, sbStartBarrier, sbFinishBarrier, sbExitBarrier, tpProgressInstance);
+
+			WaitTestThreadsReady(sbStartBarrier);
+			CRandomContextProvider::RefreshRandomsCache();
+
+			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
+
+			LaunchTheTest(sbStartBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
+
+			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
+
+			timeduration tdTestDuration = atdObjectTestDurations[ftTestKind] = tpTestEndTime - tpTestStartTime;
+
+			timeduration tdTotalUnavailabilityTime, tdMaxUnavailabilityTime;
+			FreeTestThreads(sbExitBarrier, LOCKTEST_THREAD_COUNT, tdTotalUnavailabilityTime, tdMaxUnavailabilityTime);
+			atdObjectTestTotalUnavailabilityTimes[ftTestKind] = tdTotalUnavailabilityTime;
+			atdObjectTestMaxUnavailabilityTimes[ftTestKind] = tdMaxUnavailabilityTime;
+
+			PublishTestResults(ftTestKind, LOCKTEST_WRITER_COUNT, LOCKTEST_READER_COUNT, tpRunStartTime, flLevelToTest, tdTestDuration, tdTotalUnavailabilityTime, tdMaxUnavailabilityTime);
+
+			sbStartBarrier.ResetInstance(LOCKTEST_THREAD_COUNT);
+			sbFinishBarrier.ResetInstance(LOCKTEST_THREAD_COUNT);
+			sbExitBarrier.ResetInstance(0);
+			tpProgressInstance.ResetInstance();
+		}
+	}
+
+	{
+		const ERWLOCKFINETEST ftTestKind = LFT_MUTEXGEAR_TIMED_TO_WP;
+		const ERWLOCKLOCKTESTOBJECT toTestedObjectKind = (ERWLOCKLOCKTESTOBJECT)CRWLockFineTestTraits<ftTestKind>::test_object;
+		const unsigned uiCustomWPOption = CRWLockFineTestTraits<ftTestKind>::custom_wp_opt;
+
+		if (
+#if !_MGTEST_HAVE_CXX11
+			ttlTestLanguage == LTL_CPP ||
+#endif
+			(uiCustomWPOption != 0 && bSingleOperationTest)
+			)
+		{
+			// Do nothing
+		}
+		else
+		{
+			const unsigned uiCustomizedImplementationOptions = tuiImplementationOptions | ENCODE_CUSTOM_WP_OPT(uiCustomWPOption);
+			CRWLockImplementation<trsTryReadSupport, uiCustomizedImplementationOptions, toTestedObjectKind, ttlTestLanguage> liRWLock;
+			AllocateTestThreads<uiCustomizedImplementationOptions, toTestedObjectKind>(liRWLock, LOCKTEST_WRITER_COUNT, LOCKTEST_READER_COUNT, tpRunStartTime, sbStartBarrier, sbFinishBarrier, sbExitBarrier, tpProgressInstance);
+
+			WaitTestThreadsReady(sbStartBarrier);
+			CRandomContextProvider::RefreshRandomsCache();
+
+			timepoint tpTestStartTime = CTimeUtils::GetCurrentMonotonicTimeNano();
+
+			LaunchTheTest(sbStartBarrier);
+			WaitTheTestEnd(sbFinishBarrier, liRWLock, tpProgressInstance);
 
 			timepoint tpTestEndTime = CTimeUtils::GetCurrentMonotonicTimeNano();
 
@@ -1729,7 +3113,7 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 			// tpProgressInstance.ResetInstance();
 		}
 	}
-	MG_STATIC_ASSERT(LFT__MAX == 6);
+	MG_STATIC_ASSERT(LFT__MAX == 9);
 
 	printf(g_ascLockTestTimesFormat,
 		(unsigned long)(atdObjectTestDurations[LFT_SYSTEM] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_SYSTEM] % 1000000000) / 1000000,
@@ -1738,6 +3122,9 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 		(unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR] / 1000000000), (unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_NO_FASTPATH] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_NO_FASTPATH] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_NO_FASTPATH] / 1000000000), (unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_NO_FASTPATH] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_NO_FASTPATH] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_NO_FASTPATH] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_MINIMAL_TO_WP] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_MINIMAL_TO_WP] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_MINIMAL_TO_WP] / 1000000000), (unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_MINIMAL_TO_WP] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_MINIMAL_TO_WP] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_MINIMAL_TO_WP] % 1000000000) / 1000000,
@@ -1749,8 +3136,22 @@ bool CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_SUBSTANTIAL_TO_WP] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_SUBSTANTIAL_TO_WP] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_INFINITE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_INFINITE_TO_WP] % 1000000000) / 1000000,
 		(unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_INFINITE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_INFINITE_TO_WP] % 1000000000) / 1000000,
-		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_INFINITE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_INFINITE_TO_WP] % 1000000000) / 1000000);
-		MG_STATIC_ASSERT(LFT__MAX == 6);
+		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_INFINITE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_INFINITE_TO_WP] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_ADAPTIVE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_ADAPTIVE_TO_WP] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_ADAPTIVE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_ADAPTIVE_TO_WP] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_ADAPTIVE_TO_WP] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_ADAPTIVE_TO_WP] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_TIMED_TO_WP] / 1000000000), (unsigned long)(atdObjectTestDurations[LFT_MUTEXGEAR_TIMED_TO_WP] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_TIMED_TO_WP] / 1000000000), (unsigned long)(atdObjectTestTotalUnavailabilityTimes[LFT_MUTEXGEAR_TIMED_TO_WP] % 1000000000) / 1000000,
+		(unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_TIMED_TO_WP] / 1000000000), (unsigned long)(atdObjectTestMaxUnavailabilityTimes[LFT_MUTEXGEAR_TIMED_TO_WP] % 1000000000) / 1000000);
+		MG_STATIC_ASSERT(LFT__MAX == 9);
+
+	tpProgressInstance.PrintPeakState();
+
+	if ((tuiImplementationOptions & LIOPT_WRITER_CLASSES) != 0)
+	{
+		// The wait times are accumulated over all the MutexGear object runs
+		CWriterClassLatencies::PrintStatistics();
+	}
 
 	FreeThreadOperationBuffers(LOCKTEST_THREAD_COUNT);
 	FinalizeTestResults(flLevelToTest);
@@ -1930,9 +3331,25 @@ void CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivis
 }
 
 template<unsigned int tuiWriterCount, unsigned int tuiReaderCount, unsigned int tuiReaderWriteDivisor, unsigned int tuiImplementationOptions, ERWLOCKTESTTRYREADSUPPORT trsTryReadSupport, ERWLOCKLOCKTESTLANGUAGE ttlTestLanguage>
-void CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivisor, tuiImplementationOptions, trsTryReadSupport, ttlTestLanguage>::WaitTheTestEnd(CThreadExecutionBarrier &sbFinishBarrier)
+template<class TRWLockImplementation>
+void CRWLockLockTestExecutor<tuiWriterCount, tuiReaderCount, tuiReaderWriteDivisor, tuiImplementationOptions, trsTryReadSupport, ttlTestLanguage>::WaitTheTestEnd(CThreadExecutionBarrier &sbFinishBarrier, 
+	TRWLockImplementation &liRefRWLock, CRWLockLockTestProgress &tpRefProgressInstance)
 {
+	// Sample the object state while the test threads run, if the object supports the query, to report the peak contention
+	mutexgear_rwlock_state_t rsStateSnapshot;
+	while (sbFinishBarrier.RetrieveCounterValue() != 0 && liRefRWLock.RetrieveRWLockState(rsStateSnapshot))
+	{
+		tpRefProgressInstance.RecordRWLockState(rsStateSnapshot);
+		CTimeUtils::Sleep(1);
+	}
+
 	sbFinishBarrier.WaitReleaseEvent();
+
+	mutexgear_rwlock_stats_t rsObjectStats;
+	if (liRefRWLock.RetrieveRWLockStats(rsObjectStats))
+	{
+		tpRefProgressInstance.RecordRWLockStats(rsObjectStats);
+	}
 }
 
 
@@ -2406,6 +3823,65 @@ enum EMGRWLOCKFEATURE
 	MGWLF_8TW_64TR_C,
 	MGWLF_8TW_128TR_C,
 
+	MGWLF_16TW_32TR_C,
+	MGWLF_16TW_32TR_NCNL_C,
+	MGWLF_16TW_32TR_WCNL_CPP,
+	MGWLF_16TW_32TR_MCNL_C,
+
+	MGWLF_4TW_16TR_DG_C,
+	MGWLF_16T_25PW_DG_C,
+	MGWLF_16T_25PW_DG_CPP,
+	MGWLF_8TW_32TR_DG_C,
+
+	MGWLF_4TW_16TR_UG_C,
+	MGWLF_16T_25PW_UG_C,
+	MGWLF_16T_25PW_UG_CPP,
+
+	MGWLF_4TW_32TR_RS_C,
+	MGWLF_32T_25PW_RS_C,
+	MGWLF_8TW_32TR_RS_C,
+
+	MGWLF_4TW_16TR_AS_C,
+	MGWLF_16T_25PW_AS_C,
+
+	MGWLF_4TW_16TR_TL_CPP,
+	MGWLF_16T_25PW_TL_CPP,
+
+	MGWLF_4TW_16TR_HO_C,
+	MGWLF_16T_25PW_HO_C,
+
+	MGWLF_4TW_16TR_CW_C,
+	MGWLF_16T_25PW_CW_C,
+
+	MGWLF_4TW_16TR_OR_C,
+	MGWLF_16T_25PW_OR_C,
+	MGWLF_4TW_16TR_OR_CPP,
+
+	MGWLF_16TR_RB_C,
+	MGWLF_4TW_16TR_RB_C,
+	MGWLF_16T_25PW_UG_RB_C,
+
+	MGWLF_4TW_16TR_LT_C,
+	MGWLF_16T_25PW_LT_C,
+	MGWLF_16T_25PW_LT_CPP,
+	MGWLF_4TW_16TR_ML_C,
+	MGWLF_16T_25PW_ML_C,
+	MGWLF_16T_25PW_ML_CPP,
+	MGWLF_4TW_16TR_CL_C,
+	MGWLF_16T_25PW_CL_C,
+	MGWLF_16T_25PW_CL_CPP,
+	MGWLF_4TW_16TR_NR_C,
+	MGWLF_16T_25PW_NR_C,
+	MGWLF_4TW_16TR_NR_CPP,
+	MGWLF_4TW_16TR_TC_C,
+	MGWLF_4TW_16TR_TH_CPP,
+	MGWLF_4TW_16TR_TC_CPP,
+	MGWLF_16T_25PW_TC_CPP,
+	MGWLF_4TW_16TR_SI_CPP,
+	MGWLF_16T_25PW_SI_CPP,
+	MGWLF_16T_25PW_WC_C,
+	MGWLF_16T_25PW_WC_CPP,
+
 	MGWLF__MAX,
 
 	MGWLF__TESTBEGIN = MGWLF__MIN,
@@ -2473,6 +3949,65 @@ static const EMGTESTFEATURELEVEL g_aflRWLockFeatureTestLevels[] =
 	MGTFL_EXTRA, // MGWLF_8TW_32TR_C,
 	MGTFL_EXTRA, // MGWLF_8TW_64TR_C,
 	MGTFL_EXTRA, // MGWLF_8TW_128TR_C,
+
+	MGTFL_BASIC, // MGWLF_16TW_32TR_C,
+	MGTFL_BASIC, // MGWLF_16TW_32TR_NCNL_C,
+	MGTFL_QUICK, // MGWLF_16TW_32TR_WCNL_CPP,
+	MGTFL_QUICK, // MGWLF_16TW_32TR_MCNL_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_DG_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_DG_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_DG_CPP,
+	MGTFL_EXTRA, // MGWLF_8TW_32TR_DG_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_UG_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_UG_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_UG_CPP,
+
+	MGTFL_BASIC, // MGWLF_4TW_32TR_RS_C,
+	MGTFL_QUICK, // MGWLF_32T_25PW_RS_C,
+	MGTFL_EXTRA, // MGWLF_8TW_32TR_RS_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_AS_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_AS_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_TL_CPP,
+	MGTFL_QUICK, // MGWLF_16T_25PW_TL_CPP,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_HO_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_HO_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_CW_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_CW_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_OR_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_OR_C,
+	MGTFL_QUICK, // MGWLF_4TW_16TR_OR_CPP,
+
+	MGTFL_BASIC, // MGWLF_16TR_RB_C,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_RB_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_UG_RB_C,
+
+	MGTFL_BASIC, // MGWLF_4TW_16TR_LT_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_LT_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_LT_CPP,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_ML_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_ML_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_ML_CPP,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_CL_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_CL_C,
+	MGTFL_BASIC, // MGWLF_16T_25PW_CL_CPP,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_NR_C,
+	MGTFL_QUICK, // MGWLF_16T_25PW_NR_C,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_NR_CPP,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_TC_C,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_TH_CPP,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_TC_CPP,
+	MGTFL_QUICK, // MGWLF_16T_25PW_TC_CPP,
+	MGTFL_BASIC, // MGWLF_4TW_16TR_SI_CPP,
+	MGTFL_QUICK, // MGWLF_16T_25PW_SI_CPP,
+	MGTFL_QUICK, // MGWLF_16T_25PW_WC_C,
+	MGTFL_BASIC, // MGWLF_16T_25PW_WC_CPP,
 };
 MG_STATIC_ASSERT(ARRAY_SIZE(g_aflRWLockFeatureTestLevels) == MGWLF__MAX);
 
@@ -2522,6 +4057,82 @@ static const CRWLockFeatureTestProcedure g_afnRWLockFeatureTestProcedures[] =
 	&TestRWLockLocks<8, 32, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_32TR_C,
 	&TestRWLockLocks<8, 64, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_64TR_C,
 	&TestRWLockLocks<8, 128, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_128TR_C,
+
+	&TestRWLockLocks<16, 32, 0, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_C,
+	&TestRWLockLocks<16, 32, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_NCNL_C,
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockLocks<16, 32, LIOPT_WIDE_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16TW_32TR_WCNL_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<16, 32, LIOPT_WIDE_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_WCNL_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<16, 32, LIOPT_MAXIMAL_WRITE_CHANNELS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_MCNL_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_DOWNGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_DG_C,
+	&TestRWLockMixed<16, 4, LIOPT_DOWNGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_DG_C,
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_DOWNGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_DG_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_DOWNGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_DG_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<8, 32, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_DOWNGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_32TR_DG_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_UPGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_UG_C,
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_UG_C,
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_UG_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_UG_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+
+	&TestRWLockLocks<4, 32, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_STRIPED_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_32TR_RS_C,
+	&TestRWLockMixed<32, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_STRIPED_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_32T_25PW_RS_C,
+	&TestRWLockLocks<8, 32, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_STRIPED_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_32TR_RS_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_ADAPTIVE_SPIN, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_AS_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_ADAPTIVE_SPIN, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_AS_C,
+
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_TL_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_TL_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_TL_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_TL_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_WRITE_HANDOFF, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_HO_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_WRITE_HANDOFF, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_HO_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_COMBINED_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_CW_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_COMBINED_WRITES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_CW_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_OPTIMISTIC_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_OR_C,
+	&TestRWLockMixed<16, 4, LIOPT_OPTIMISTIC_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_OR_C,
+	&TestRWLockLocks<4, 16, LIOPT_OPTIMISTIC_READS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_OR_CPP,
+
+	&TestRWLockLocks<0, 16, LIOPT_READER_BIAS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TR_RB_C,
+	&TestRWLockLocks<4, 16, LIOPT_READER_BIAS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_RB_C,
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES | LIOPT_READER_BIAS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_UG_RB_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_LIGHT_TRYREADS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_LT_C,
+	&TestRWLockMixed<16, 4, LIOPT_LIGHT_TRYREADS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_LT_C,
+	&TestRWLockMixed<16, 4, LIOPT_LIGHT_TRYREADS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_LT_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_ML_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_ML_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_ML_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_COUPLED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_CL_C,
+	&TestRWLockMixed<16, 4, LIOPT_COUPLED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_CL_C,
+	&TestRWLockMixed<16, 4, LIOPT_COUPLED_LOCKS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_CL_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_NESTED_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_NR_C,
+	&TestRWLockMixed<16, 4, LIOPT_NESTED_READS, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_NR_C,
+	&TestRWLockLocks<4, 16, LIOPT_NESTED_READS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_NR_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_THREAD_CONTEXT, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_TC_C,
+	&TestRWLockLocks<4, 16, LIOPT_TASK_HELPERS, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_TH_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_THREAD_CONTEXT, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_TC_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_THREAD_CONTEXT, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_TC_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_STANDARD_INTERFACE, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_SI_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_STANDARD_INTERFACE, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_SI_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_WRITER_CLASSES, TRS_NO_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_WC_C,
+	&TestRWLockMixed<16, 4, LIOPT_WRITER_CLASSES, TRS_NO_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_WC_CPP,
 };
 MG_STATIC_ASSERT(ARRAY_SIZE(g_afnRWLockFeatureTestProcedures) == MGWLF__MAX);
 
@@ -2571,6 +4182,82 @@ static const char *const g_aszRWLockFeatureTestNames[] =
 	"8 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 32 Readers, C", // MGWLF_8TW_32TR_C,
 	"8 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 64 Readers, C", // MGWLF_8TW_64TR_C,
 	"8 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 128 Readers, C", // MGWLF_8TW_128TR_C,
+
+	"16 Writers @1cnl, 32 Readers, C", // MGWLF_16TW_32TR_C,
+	"16 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 32 Readers, C", // MGWLF_16TW_32TR_NCNL_C,
+#if _MGTEST_HAVE_CXX11
+	"16 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WIDE_WRITE_CHANNELS) "cnl, 32 Readers, C++", // MGWLF_16TW_32TR_WCNL_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	"16 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WIDE_WRITE_CHANNELS) "cnl, 32 Readers, C", // MGWLF_16TW_32TR_WCNL_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+	"16 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_MAXIMAL_WRITE_CHANNELS) "cnl, 32 Readers, C", // MGWLF_16TW_32TR_MCNL_C,
+
+	"4 Writers+DG, 16 Readers, C", // MGWLF_4TW_16TR_DG_C,
+	"25% writes+DG, 16 threads, C", // MGWLF_16T_25PW_DG_C,
+#if _MGTEST_HAVE_CXX11
+	"25% writes+DG, 16 threads, C++", // MGWLF_16T_25PW_DG_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	"25% writes+DG, 16 threads, C", // MGWLF_16T_25PW_DG_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+	"8 Writers+DG @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 32 Readers, C", // MGWLF_8TW_32TR_DG_C,
+
+	"4 Writers+UG, 16 Readers, C", // MGWLF_4TW_16TR_UG_C,
+	"25% writes+UG, 16 threads, C", // MGWLF_16T_25PW_UG_C,
+#if _MGTEST_HAVE_CXX11
+	"25% writes+UG, 16 threads, C++", // MGWLF_16T_25PW_UG_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	"25% writes+UG, 16 threads, C", // MGWLF_16T_25PW_UG_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+
+	"4 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 32 Readers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_READ_STRIPES) "str, C", // MGWLF_4TW_32TR_RS_C,
+	"25% writes @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl/" MAKE_STRING_LITERAL(MGTEST_RWLOCK_READ_STRIPES) "str, 32 threads, C", // MGWLF_32T_25PW_RS_C,
+	"8 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 32 Readers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_READ_STRIPES) "str, C", // MGWLF_8TW_32TR_RS_C,
+
+	"4 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl+AS, 16 Readers, C", // MGWLF_4TW_16TR_AS_C,
+	"25% writes @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl+AS, 16 threads, C", // MGWLF_16T_25PW_AS_C,
+
+#if _MGTEST_HAVE_CXX11
+	"4 Writers+TL @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 Readers+TL, C++", // MGWLF_4TW_16TR_TL_CPP,
+	"25% writes+TL @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 threads, C++", // MGWLF_16T_25PW_TL_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	"4 Writers @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 Readers, C", // MGWLF_4TW_16TR_TL_CPP,
+	"25% writes @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 threads, C", // MGWLF_16T_25PW_TL_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+
+	"4 Writers+HO @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 Readers, C", // MGWLF_4TW_16TR_HO_C,
+	"25% writes+HO @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 threads, C", // MGWLF_16T_25PW_HO_C,
+
+	"4 Writers+CW @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 Readers, C", // MGWLF_4TW_16TR_CW_C,
+	"25% writes+CW @" MAKE_STRING_LITERAL(MGTEST_RWLOCK_WRITE_CHANNELS) "cnl, 16 threads, C", // MGWLF_16T_25PW_CW_C,
+
+	"4 Writers, 16 Readers+OR, C", // MGWLF_4TW_16TR_OR_C,
+	"25% writes, 16 threads+OR, C", // MGWLF_16T_25PW_OR_C,
+	"4 Writers, 16 Readers+OR, C++", // MGWLF_4TW_16TR_OR_CPP,
+
+	"16 Readers+RB, C", // MGWLF_16TR_RB_C,
+	"4 Writers, 16 Readers+RB, C", // MGWLF_4TW_16TR_RB_C,
+	"25% writes+UG, 16 threads+RB, C", // MGWLF_16T_25PW_UG_RB_C,
+
+	"4 Writers, 16 Readers+LT, C", // MGWLF_4TW_16TR_LT_C,
+	"25% writes, 16 threads+LT, C", // MGWLF_16T_25PW_LT_C,
+	"25% writes, 16 threads+LT, C++", // MGWLF_16T_25PW_LT_CPP,
+	"4 Writers+ML, 16 Readers, C", // MGWLF_4TW_16TR_ML_C,
+	"25% writes+ML, 16 threads, C", // MGWLF_16T_25PW_ML_C,
+	"25% writes+ML, 16 threads, C++", // MGWLF_16T_25PW_ML_CPP,
+	"4 Writers+CL, 16 Readers+CL, C", // MGWLF_4TW_16TR_CL_C,
+	"25% writes+CL, 16 threads+CL, C", // MGWLF_16T_25PW_CL_C,
+	"25% writes+CL, 16 threads+CL, C++", // MGWLF_16T_25PW_CL_CPP,
+	"4 Writers, 16 Readers+NR, C", // MGWLF_4TW_16TR_NR_C,
+	"25% writes, 16 threads+NR, C", // MGWLF_16T_25PW_NR_C,
+	"4 Writers, 16 Readers+NR, C++", // MGWLF_4TW_16TR_NR_CPP,
+	"4 Writers, 16 Readers+TC, C", // MGWLF_4TW_16TR_TC_C,
+	"4 Writers, 16 Readers+TH, C++", // MGWLF_4TW_16TR_TH_CPP,
+	"4 Writers, 16 Readers+TC, C++", // MGWLF_4TW_16TR_TC_CPP,
+	"25% writes, 16 threads+TC, C++", // MGWLF_16T_25PW_TC_CPP,
+	"4 Writers, 16 Readers+SI, C++", // MGWLF_4TW_16TR_SI_CPP,
+	"25% writes, 16 threads+SI, C++", // MGWLF_16T_25PW_SI_CPP,
+	"25% writes, 16 threads+WC, C", // MGWLF_16T_25PW_WC_C,
+	"25% writes, 16 threads+WC, C++", // MGWLF_16T_25PW_WC_CPP,
 };
 MG_STATIC_ASSERT(ARRAY_SIZE(g_aszRWLockFeatureTestNames) == MGWLF__MAX);
 
@@ -2675,6 +4362,82 @@ static const CRWLockFeatureTestProcedure g_afnTRDLRWLockFeatureTestProcedures[]
 	&TestRWLockLocks<8, 32, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_32TR_C,
 	&TestRWLockLocks<8, 64, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_64TR_C,
 	&TestRWLockLocks<8, 128, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_128TR_C,
+
+	&TestRWLockLocks<16, 32, 0, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_C,
+	&TestRWLockLocks<16, 32, LIOPT_MULTIPLE_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_NCNL_C,
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockLocks<16, 32, LIOPT_WIDE_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16TW_32TR_WCNL_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<16, 32, LIOPT_WIDE_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_WCNL_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<16, 32, LIOPT_MAXIMAL_WRITE_CHANNELS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TW_32TR_MCNL_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_DOWNGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_DG_C,
+	&TestRWLockMixed<16, 4, LIOPT_DOWNGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_DG_C,
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_DOWNGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_DG_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_DOWNGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_DG_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<8, 32, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_DOWNGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_32TR_DG_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_UPGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_UG_C,
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_UG_C,
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_UG_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_UG_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+
+	&TestRWLockLocks<4, 32, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_STRIPED_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_32TR_RS_C,
+	&TestRWLockMixed<32, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_STRIPED_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_32T_25PW_RS_C,
+	&TestRWLockLocks<8, 32, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_STRIPED_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_8TW_32TR_RS_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_ADAPTIVE_SPIN, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_AS_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_ADAPTIVE_SPIN, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_AS_C,
+
+#if _MGTEST_HAVE_CXX11
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_TL_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_TL_CPP,
+#else // #if !_MGTEST_HAVE_CXX11
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_TL_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_TIMED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_TL_CPP,
+#endif // #if !_MGTEST_HAVE_CXX11
+
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_WRITE_HANDOFF, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_HO_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_WRITE_HANDOFF, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_HO_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_COMBINED_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_CW_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_CHANNELS | LIOPT_COMBINED_WRITES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_CW_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_OPTIMISTIC_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_OR_C,
+	&TestRWLockMixed<16, 4, LIOPT_OPTIMISTIC_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_OR_C,
+	&TestRWLockLocks<4, 16, LIOPT_OPTIMISTIC_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_OR_CPP,
+
+	&TestRWLockLocks<0, 16, LIOPT_READER_BIAS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16TR_RB_C,
+	&TestRWLockLocks<4, 16, LIOPT_READER_BIAS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_RB_C,
+	&TestRWLockMixed<16, 4, LIOPT_UPGRADE_WRITES | LIOPT_READER_BIAS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_UG_RB_C,
+
+	&TestRWLockLocks<4, 16, LIOPT_LIGHT_TRYREADS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_LT_C,
+	&TestRWLockMixed<16, 4, LIOPT_LIGHT_TRYREADS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_LT_C,
+	&TestRWLockMixed<16, 4, LIOPT_LIGHT_TRYREADS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_LT_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_MULTIPLE_WRITE_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_ML_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_ML_C,
+	&TestRWLockMixed<16, 4, LIOPT_MULTIPLE_WRITE_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_ML_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_COUPLED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_CL_C,
+	&TestRWLockMixed<16, 4, LIOPT_COUPLED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_CL_C,
+	&TestRWLockMixed<16, 4, LIOPT_COUPLED_LOCKS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_CL_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_NESTED_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_NR_C,
+	&TestRWLockMixed<16, 4, LIOPT_NESTED_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_NR_C,
+	&TestRWLockLocks<4, 16, LIOPT_NESTED_READS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_NR_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_THREAD_CONTEXT, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_4TW_16TR_TC_C,
+	&TestRWLockLocks<4, 16, LIOPT_TASK_HELPERS, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_TH_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_THREAD_CONTEXT, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_TC_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_THREAD_CONTEXT, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_TC_CPP,
+	&TestRWLockLocks<4, 16, LIOPT_STANDARD_INTERFACE, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_4TW_16TR_SI_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_STANDARD_INTERFACE, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_SI_CPP,
+	&TestRWLockMixed<16, 4, LIOPT_WRITER_CLASSES, TRS_WITH_TRYREAD_SUPPORT, LTL_C>, // MGWLF_16T_25PW_WC_C,
+	&TestRWLockMixed<16, 4, LIOPT_WRITER_CLASSES, TRS_WITH_TRYREAD_SUPPORT, LTL_CPP>, // MGWLF_16T_25PW_WC_CPP,
 };
 MG_STATIC_ASSERT(ARRAY_SIZE(g_afnTRDLRWLockFeatureTestProcedures) == MGWLF__MAX);
 
@@ -28,11 +28,25 @@
 #ifndef MGTEST_RWLOCK_WRITE_CHANNELS
 #define MGTEST_RWLOCK_WRITE_CHANNELS	4
 #endif
+#ifndef MGTEST_RWLOCK_WIDE_WRITE_CHANNELS
+#define MGTEST_RWLOCK_WIDE_WRITE_CHANNELS	16
+#endif
+#ifndef MGTEST_RWLOCK_MAXIMAL_WRITE_CHANNELS
+#define MGTEST_RWLOCK_MAXIMAL_WRITE_CHANNELS	64
+#endif
+#ifndef MGTEST_RWLOCK_READ_STRIPES
+#define MGTEST_RWLOCK_READ_STRIPES	8
+#endif
 
 #define MGTEST_RWLOCK_MINIMAL_READERS_TILL_WP		1
 #define MGTEST_RWLOCK_AVERAGE_READERS_TILL_WP		2
 #define MGTEST_RWLOCK_SUBSTANTIAL_READERS_TILL_WP	4
 #define MGTEST_RWLOCK_INFINITE_READERS_TILL_WP		(-1)
+#define MGTEST_RWLOCK_ADAPTIVE_READERS_TILL_WP		MUTEXGEAR_RWLOCK_READERS_TILL_WP_ADAPTIVE
+#define MGTEST_RWLOCK_TIMED_READERS_TILL_WP			(-2) // The time based priority with MGTEST_RWLOCK_MICROSECONDS_TILL_WP
+#define MGTEST_RWLOCK_MICROSECONDS_TILL_WP			50
+#define MGTEST_RWLOCK_TIMED_LOCK_MICROSECONDS		20
+#define MGTEST_RWLOCK_OPTIMISTIC_READ_ATTEMPTS		2
 
 
 class CRWLockTest